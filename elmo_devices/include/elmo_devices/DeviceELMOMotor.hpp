@@ -44,6 +44,11 @@ public:
 	//! Initializes the EPOS
 	virtual bool initDevice();
 
+	/*! Configures the ELMO in the state pre-operational
+	 * Is invoked by initDevice() and by the boot manager.
+	 */
+	virtual bool configureDevice();
+
 	/*! Enables the EPOS
 	 * Is invoked by initDevice();
 	 */
@@ -102,6 +107,11 @@ public:
 	 */
 	DeviceELMOMotorParameters* getDeviceParams();
 
+	/*! Gets the index of the joint in the joint state buffer of the bus
+	 * @return index of joint, -1 if the buffer is full
+	 */
+	int getJointIndex() const;
+
 	/*! Sends a SDO to check if the EPOS is enabled.
 	 * @param flag	true if EPOS is enabled
 	 * @return true if a response is received
@@ -153,6 +163,9 @@ public:
 	//bool getPoti(double &value);
 
 protected:
+	//! The EMCY codes of the node are decoded with the ELMO table
+	virtual canopen::EMCYVendor getEMCYVendor() const;
+
 	//! PDO message to measure position and velocity of the motor
 	TxPDOPositionVelocity* txPDOPositionVelocity_;
 
@@ -170,6 +183,9 @@ protected:
 	//! device parameters
 	DeviceELMOMotorParameters* deviceParams_;
 
+	//! index of the joint in the joint state buffer of the bus
+	int jointIndex_;
+
 	//! SDO to read the status word
 	SDOReadStatusWord::SDOReadStatusWordPtr sdoStatusWord_;
 
@@ -118,6 +118,15 @@ public:
 	//! operation (control) mode (velocity, position, current, etc. Use defines above)
 	int operationMode;
 
+	//! transmission type of the TxPDO with the analog input and the current (every n-th SYNC: 0x01-0xF0, event-driven: 0xFE, 0xFF)
+	int txPDOAnalogCurrentTransmissionType;
+	//! minimum time between two event-driven TxPDOs with the analog input and the current [100us]
+	int txPDOAnalogCurrentInhibitTime;
+	//! maximum time between two event-driven TxPDOs with the analog input and the current [ms], 0 disables the timer
+	int txPDOAnalogCurrentEventTimer;
+	//! overflow value of the SYNC counter of the bus (see Bus::setSyncCounterOverflow()), 0 if the SYNC has no counter
+	int syncCounterOverflow;
+
 	//! identifier of shared memory of RxPDO
 	int rxPDO1SMId_;
 
@@ -165,7 +174,10 @@ public:
 	 inSDOSMId_(inSDOSMId),
 	 outSDOSMId_(outSDOSMId)
 	{
-
+		txPDOAnalogCurrentTransmissionType = 0x01;
+		txPDOAnalogCurrentInhibitTime = 0;
+		txPDOAnalogCurrentEventTimer = 0;
+		syncCounterOverflow = 0;
 	}
 	virtual ~DeviceELMOMotorParameters()
 	{
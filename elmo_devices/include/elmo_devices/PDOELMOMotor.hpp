@@ -22,16 +22,17 @@
 
 
 #include "libcanplusplus/CANOpenMsg.hpp"
+#include "libcanplusplus/canopen_pdos.hpp"
+#include "libcanplusplus/JointStateBuffer.hpp"
 #include <stdio.h>
 
 #include "libcanplusplus/StatusWordBits.hpp"
 
 //////////////////////////////////////////////////////////////////////////////
-class RxPDOSync: public CANOpenMsg {
+//! SYNC of the bus, counts up to Bus::getSyncCounterOverflow() if it is set
+class RxPDOSync: public canopen::RxPDOSync {
 public:
-	RxPDOSync(int SMId):CANOpenMsg(0x80, SMId) {
-		flag_ = 1;
-	};
+	RxPDOSync(int SMId):canopen::RxPDOSync(SMId) {};
 	virtual ~RxPDOSync() {};
 };
 
@@ -217,7 +218,8 @@ public:
 //////////////////////////////////////////////////////////////////////////////
 class TxPDOPositionVelocity: public CANOpenMsg {
 public:
-	TxPDOPositionVelocity(int nodeId, int SMId):CANOpenMsg(0x380+nodeId, SMId)
+	TxPDOPositionVelocity(int nodeId, int SMId):CANOpenMsg(0x380+nodeId, SMId),
+		jointStateBuffer_(NULL), joint_(-1)
 	{
 
 	};
@@ -228,6 +230,10 @@ public:
 	{
 		position_ = (value_[0] + (value_[1]<<8) + (value_[2]<<16) + (value_[3]<<24));
 		velocity_ = (value_[4] + (value_[5]<<8) + (value_[6]<<16) + (value_[7]<<24));
+
+		if (jointStateBuffer_ != NULL) {
+			jointStateBuffer_->setRawPositionVelocity(joint_, position_, velocity_);
+		}
 	};
 
 	int getPosition()
@@ -240,17 +246,32 @@ public:
 		return velocity_;
 	};
 
+	/*! Writes the decoded values also to the joint state buffer of the bus
+	 * @param jointStateBuffer	buffer of the bus
+	 * @param joint				index of the joint in the buffer
+	 */
+	void setJointStateBuffer(JointStateBuffer* jointStateBuffer, int joint)
+	{
+		jointStateBuffer_ = jointStateBuffer;
+		joint_ = joint;
+	};
+
 
 private:
 	int position_;
 	int velocity_;
+	//! buffer of the bus the decoded values are written to, NULL if not used
+	JointStateBuffer* jointStateBuffer_;
+	//! index of the joint in the buffer
+	int joint_;
 
 };
 
 //////////////////////////////////////////////////////////////////////////////
 class TxPDOAnalogCurrent: public CANOpenMsg {
 public:
-	TxPDOAnalogCurrent(int nodeId, int SMId):CANOpenMsg(0x480+nodeId, SMId)
+	TxPDOAnalogCurrent(int nodeId, int SMId):CANOpenMsg(0x480+nodeId, SMId),
+		jointStateBuffer_(NULL), joint_(-1)
 	{
 
 	};
@@ -268,6 +289,10 @@ public:
 		current_ = int(val);
 
 		statusword_ = (int)((unsigned short)(value_[4] + (value_[5]<<8)));
+
+		if (jointStateBuffer_ != NULL) {
+			jointStateBuffer_->setRawCurrent(joint_, current_);
+		}
 	};
 
 	int getAnalog()
@@ -285,6 +310,16 @@ public:
 		return statusword_;
 	};
 
+	/*! Writes the decoded values also to the joint state buffer of the bus
+	 * @param jointStateBuffer	buffer of the bus
+	 * @param joint				index of the joint in the buffer
+	 */
+	void setJointStateBuffer(JointStateBuffer* jointStateBuffer, int joint)
+	{
+		jointStateBuffer_ = jointStateBuffer;
+		joint_ = joint;
+	};
+
 	bool isEnabled()
 	{
 		return (statusword_ & (1<<STATUSWORD_OPERATION_ENABLE_BIT));
@@ -326,6 +361,10 @@ private:
 	int analog_;
 	int current_;
 	int statusword_;
+	//! buffer of the bus the decoded values are written to, NULL if not used
+	JointStateBuffer* jointStateBuffer_;
+	//! index of the joint in the buffer
+	int joint_;
 
 };
 
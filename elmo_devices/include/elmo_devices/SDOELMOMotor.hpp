@@ -13,6 +13,7 @@
 
 #include "libcanplusplus/SDOWriteMsg.hpp"
 #include "libcanplusplus/SDOReadMsg.hpp"
+#include "libcanplusplus/Logger.hpp"
 
 
 #define WRITE_1_BYTE 0x2f
@@ -37,7 +38,7 @@ protected:
 			if (inputMsg_->getValue()[0] == 0x80)
 			{
 				///< Check for recData[0]==0x60! recData[0]==0x80 means an error happend
-				printf("Warning: Can't write SDO. Error code: %02X%02X%02X%02X\n",inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4]);
+				Logger::log(LogLevels::error, "SDO Error: Node 0x%02X: Can't write! Error code: %02X%02X%02X%02X, Index: 0x%02X%02X, Subindex: 0x%02X", outputMsg_->getCOBId()-0x600, inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4], inputMsg_->getValue()[2], inputMsg_->getValue()[1], inputMsg_->getValue()[3]);
 			}
 		}
 	}
@@ -74,7 +75,7 @@ protected:
 			if (inputMsg_->getValue()[0] == 0x80)
 			{
 				///< Check for recData[0]==0x60! recData[0]==0x80 means an error happend
-				printf("Warning: Can't write SDO. Error code: %02X%02X%02X%02X\n",inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4]);
+				Logger::log(LogLevels::error, "SDO Error: Node 0x%02X: Can't write! Error code: %02X%02X%02X%02X, Index: 0x%02X%02X, Subindex: 0x%02X", outputMsg_->getCOBId()-0x600, inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4], inputMsg_->getValue()[2], inputMsg_->getValue()[1], inputMsg_->getValue()[3]);
 			}
 		}
 
@@ -821,6 +822,46 @@ public:
 	virtual ~SDOTxPDO4SetTransmissionType(){};
 };
 
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO4Disable: public SDOWrite
+{
+public:
+	SDOTxPDO4Disable(int inSDOSMId, int outSDOSMId, int nodeId):
+		SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_4_BYTE, 0x1803, 0x01, 0x80000480 + nodeId)
+	{};
+	virtual ~SDOTxPDO4Disable(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO4SetInhibitTime: public SDOWrite
+{
+public:
+	SDOTxPDO4SetInhibitTime(int inSDOSMId, int outSDOSMId, int nodeId, int time_100us):
+		SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1803, 0x03, time_100us)
+	{};
+	virtual ~SDOTxPDO4SetInhibitTime(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO4SetEventTimer: public SDOWrite
+{
+public:
+	SDOTxPDO4SetEventTimer(int inSDOSMId, int outSDOSMId, int nodeId, int time_ms):
+		SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1803, 0x05, time_ms)
+	{};
+	virtual ~SDOTxPDO4SetEventTimer(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO4SetSyncStartValue: public SDOWrite
+{
+public:
+	SDOTxPDO4SetSyncStartValue(int inSDOSMId, int outSDOSMId, int nodeId, int value):
+		SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_1_BYTE, 0x1803, 0x06, value)
+	{};
+	virtual ~SDOTxPDO4SetSyncStartValue(){};
+};
+
 //////////////////////////////////////////////////////////////////////////////
 //! EPOS and ELMO
 class SDOTxPDO4SetMapping: public SDOWrite
@@ -1014,7 +1055,7 @@ public:
 class SDOReadStatusWord: public SDORead
 {
 public:
-	typedef boost::shared_ptr<SDOReadStatusWord> SDOReadStatusWordPtr;
+	typedef boost::intrusive_ptr<SDOReadStatusWord> SDOReadStatusWordPtr;
 	SDOReadStatusWord(int inSDOSMId, int outSDOSMId, int nodeId):
 		SDORead(inSDOSMId, outSDOSMId, nodeId, 0x6041, 0x00)
 	{};
@@ -1122,7 +1163,7 @@ public:
 class SDOGetAnalogInputOne: public SDORead
 {
 public:
-	typedef boost::shared_ptr<SDOGetAnalogInputOne> SDOGetAnalogInputOnePtr;
+	typedef boost::intrusive_ptr<SDOGetAnalogInputOne> SDOGetAnalogInputOnePtr;
 	SDOGetAnalogInputOne(int inSDOSMId, int outSDOSMId, int nodeId):
 		SDORead(inSDOSMId, outSDOSMId, nodeId, 0x2205, 0x01)
 	{};
@@ -9,12 +9,13 @@
  */
 
 #include "elmo_devices/DeviceELMOMotor.hpp"
+#include "libcanplusplus/canopen_sdos.hpp"
 #include <stdio.h>
 #include <math.h>
 
 
 DeviceELMOMotor::DeviceELMOMotor(int nodeId, DeviceELMOMotorParameters* deviceParams)
-:Device(nodeId),deviceParams_(deviceParams)
+:Device(nodeId),deviceParams_(deviceParams),jointIndex_(-1)
 {
 	sdoStatusWord_ =  SDOReadStatusWord::SDOReadStatusWordPtr(new SDOReadStatusWord(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
 	sdoStatusWordDisabled_ = SDOReadStatusWord::SDOReadStatusWordPtr(new SDOReadStatusWord(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
@@ -38,6 +39,16 @@ DeviceELMOMotorParameters* DeviceELMOMotor::getDeviceParams()
 	return deviceParams_;
 }
 
+int DeviceELMOMotor::getJointIndex() const
+{
+	return jointIndex_;
+}
+
+canopen::EMCYVendor DeviceELMOMotor::getEMCYVendor() const
+{
+	return canopen::EMCYVendor::elmo;
+}
+
 void DeviceELMOMotor::addRxPDOs()
 {
 	/* add Velocity RxPDO */
@@ -60,6 +71,25 @@ void DeviceELMOMotor::addTxPDOs()
 
 	txPDOAnalogCurrent_ = new TxPDOAnalogCurrent(nodeId_, deviceParams_->txPDO4SMId_);
 	bus_->getTxPDOManager()->addPDO(txPDOAnalogCurrent_);
+	if (canopen::isEventDriven(deviceParams_->txPDOAnalogCurrentTransmissionType)
+			&& deviceParams_->txPDOAnalogCurrentEventTimer > 0) {
+		/* the PDO is stale if not even the event timer has triggered it */
+		txPDOAnalogCurrent_->setReceiveTimeout(2*deviceParams_->txPDOAnalogCurrentEventTimer);
+	}
+	if (canopen::isSynchronousCyclic(deviceParams_->txPDOAnalogCurrentTransmissionType)) {
+		/* the PDO is sent on every n-th SYNC, stagger it against the other slow TxPDOs */
+		bus_->getTxPDOManager()->setRateDivisor(txPDOAnalogCurrent_, deviceParams_->txPDOAnalogCurrentTransmissionType);
+	}
+
+	/* register the joint in the joint state buffer of the bus */
+	JointStateBuffer* jointStateBuffer = bus_->getJointStateBuffer();
+	jointIndex_ = jointStateBuffer->addJoint(1.0/(deviceParams_->gearratio_motor * deviceParams_->RAD_TO_TICKS),
+											1.0/deviceParams_->rad_s_Gear_to_counts_s_Motor,
+											deviceParams_->continuous_current_limit / 1000.0);
+	if (jointIndex_ != -1) {
+		txPDOPositionVelocity_->setJointStateBuffer(jointStateBuffer, jointIndex_);
+		txPDOAnalogCurrent_->setJointStateBuffer(jointStateBuffer, jointIndex_);
+	}
 }
 
 
@@ -175,10 +205,30 @@ bool DeviceELMOMotor::initDevice()
 //	SDOManager->addSDO(new SDONMTResetCommunication(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
 //	SDOManager->addSDO(new SDONMTResetNode(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
 
-	printf("NMT: Enter Pre-Operational\n");
+	Logger::log(LogLevels::info, "NMT: Enter Pre-Operational");
 	SDOManager->addSDO(new SDONMTEnterPreOperational(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
+
+	configureDevice();
+
+	Logger::log(LogLevels::info, "NMT: Start remote node");
+	SDOManager->addSDO(new SDONMTStartRemoteNode(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
+
+	//SDOManager->addSDO(new SDOControlWord(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0x03F));
+
+	return true;
+
+}
+
+bool DeviceELMOMotor::configureDevice()
+{
+	SDOManager* SDOManager = bus_->getSDOManager();
+
 	SDOManager->addSDO(new SDOSetCOBIDSYNC(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0x80));
 
+	if (producerHeartBeatTime_ != 0) {
+		/* the node state is supervised by heartbeats, see initHeartbeat() */
+		SDOManager->addSDO(new canopen::SDOWriteProducerHeartbeatTime(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, producerHeartBeatTime_));
+	}
 
 	/* configure the PDOs on the motor controller */
 	configTxPDOs();
@@ -190,14 +240,7 @@ bool DeviceELMOMotor::initDevice()
 
 	initMotor();
 	SDOManager->addSDO(new SDOSetOperationMode(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, deviceParams_->operationMode));
-
-	printf("NMT: Start remote node\n");
-	SDOManager->addSDO(new SDONMTStartRemoteNode(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
-
-	//SDOManager->addSDO(new SDOControlWord(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0x03F));
-
 	return true;
-
 }
 
 void DeviceELMOMotor::configTxPDOs()
@@ -276,10 +319,26 @@ void DeviceELMOMotor::configTxPDOAnalogCurrent()
 	SDOManager* SDOManager = bus_->getSDOManager();
 
 	// Transmit PDO 4 Parameter
+	const bool isEventDriven = canopen::isEventDriven(deviceParams_->txPDOAnalogCurrentTransmissionType);
+	const bool hasSyncStartValue = (deviceParams_->syncCounterOverflow > 0 && txPDOAnalogCurrent_->getRateDivisor() > 1
+			&& setSyncCounterOverflow(deviceParams_->syncCounterOverflow, txPDOAnalogCurrent_->getRateDivisor(), txPDOAnalogCurrent_->getRatePhase() + 1));
+	if (isEventDriven || hasSyncStartValue) {
+		///< the inhibit time and the SYNC start value can only be changed while the PDO is disabled
+		SDOManager->addSDO(new SDOTxPDO4Disable(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
+	}
+	if (isEventDriven) {
+		SDOManager->addSDO(new SDOTxPDO4SetInhibitTime(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, deviceParams_->txPDOAnalogCurrentInhibitTime));
+		SDOManager->addSDO(new SDOTxPDO4SetEventTimer(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, deviceParams_->txPDOAnalogCurrentEventTimer));
+	}
+	if (hasSyncStartValue) {
+		///< the SYNC counter starts with 1, the PDO is sent first with the SYNC of its phase
+		SDOManager->addSDO(new canopen::SDOSetSyncCounterOverflow(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, deviceParams_->syncCounterOverflow));
+		SDOManager->addSDO(new SDOTxPDO4SetSyncStartValue(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, txPDOAnalogCurrent_->getRatePhase() + 1));
+	}
 	///< configure COB-ID Transmit PDO 4
 	SDOManager->addSDO(new SDOTxPDO4ConfigureCOBID(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
-	///< Set Transmission Type: SYNC 0x01
-	SDOManager->addSDO(new SDOTxPDO4SetTransmissionType(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0x01)); // SYNC
+	///< Set Transmission Type: every n-th SYNC 0x01-0xF0 or event-driven 0xFE/0xFF
+	SDOManager->addSDO(new SDOTxPDO4SetTransmissionType(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, deviceParams_->txPDOAnalogCurrentTransmissionType));
 	///< Number of Mapped Application Objects
 	SDOManager->addSDO(new SDOTxPDO4SetNumberOfMappedApplicationObjects(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0x00));
 	///< Mapping "Analog value"
@@ -19,6 +19,9 @@
 
 /* libCAN */
 #include "CANPThread.h"
+#include "libcanplusplus/Metrics.hpp"
+#include "libcanplusplus/RealTimeThread.hpp"
+#include "libcanplusplus/Trace.hpp"
 
 /* devices */
 #include "DeviceEPOS2Motor.hpp"
@@ -28,6 +31,9 @@
 #include <stdlib.h>
 #include <iostream>
 #include <signal.h>
+#include <atomic>
+#include <errno.h>
+#include <unistd.h>
 
 
 //#include <ctime>
@@ -74,8 +80,12 @@ enum DESSMID {
 enum MEASSMID {
 	MEASSMID_TxPDO_MOTOR = 0,
 	MEASSMID_SDO_MOTOR = 1,
+	MEASSMID_NMT_MOTOR = 2,
 };
 
+//! time between two heartbeats of a motor [ms]
+const unsigned int heartbeatTime_ms = 100;
+
 //! CAN Node ID given by the DIP switches
 enum CANNODEID {
 	NODEID_MOTOR=1,
@@ -99,6 +109,9 @@ BusManager busManager;
 
 static bool hasTerminated = false;
 
+//! set by the fault handler in the receive thread, stays set, the main routine stops the motor
+static std::atomic<bool> isEMCYFault(false);
+
 //! bus routine initial arguments
 BusRoutineArguments busRoutineArgs[nBuses];
 
@@ -144,11 +157,24 @@ void msg_handler(int handle, const CPC_MSG_T * cpcmsg, void *customPointer);
  */
 int getMsgIdxFromCOBId(int iBus, int COBId);
 
-/*! Decodes an emergency object received from an EPOS
- * @param	DATA	CAN message
- * @return	true if it is really an error
+/*! Reacts on an error reported by an emergency object
+ * Is invoked in the thread of the message handler and must not block.
+ * @param	event		decoded emergency object
+ * @param	userData	not used
+ */
+void emcy_fault_handler(const EMCYEvent& event, void* userData);
+
+/*! Prints an emergency object
+ * Is invoked by the dispatch() of the EMCY manager in main(), which does not run with
+ * a real-time priority.
+ * @param	event		decoded emergency object
  */
-bool decodeEmergencyObject(unsigned char* DATA);
+void printEmergencyObject(const EMCYEvent& event);
+
+/*! Checks the heartbeats of the motors
+ * @return false if a motor is missing
+ */
+bool checkMotorHeartbeats();
 
 /*! Sets the motor velocity
  * @param velocity velocity in rad/s
@@ -187,9 +213,40 @@ int main(int argc, char** args)
 	for (int iBus=0; iBus<nBuses; iBus++) {
 		busManager.addBus(new Bus(iBus));
 		busManager.getBus(iBus)->getRxPDOManager()->addPDO(new RxPDOSync(DESSMID_RxPDO_SYNC));
-		busManager.getBus(iBus)->getDeviceManager()->addDevice(new DeviceEPOS2Motor(NODEID_MOTOR, new Motor4poleParams(DESSMID_RxPDO_MOTOR, MEASSMID_TxPDO_MOTOR, MEASSMID_SDO_MOTOR, DESSMID_SDO)));
+		DeviceEPOS2Motor* motor = new DeviceEPOS2Motor(NODEID_MOTOR, new Motor4poleParams(DESSMID_RxPDO_MOTOR, MEASSMID_TxPDO_MOTOR, MEASSMID_SDO_MOTOR, DESSMID_SDO));
+		/* the motor sends heartbeats, which are supervised by the bus */
+		motor->setNMTSMId(MEASSMID_NMT_MOTOR);
+		motor->initHeartbeat(heartbeatTime_ms);
+		busManager.getBus(iBus)->getDeviceManager()->addDevice(motor);
 	}
 
+	/* place the RxPDOs, the SYNC and the SDOs at fixed offsets within the cycle */
+	for (int iBus=0; iBus<nBuses; iBus++) {
+		TransmitScheduler* scheduler = busManager.getBus(iBus)->getTransmitScheduler();
+		scheduler->setCycleTime((unsigned int)(1000000./(double)motor_servo_rate));
+		scheduler->setBitrate(1000000);
+		scheduler->setTxQueueDepth(2);
+		/* the SYNC directly follows the RxPDOs */
+		scheduler->setSlotOffset(TransmitScheduler::Slots::rxPDO, 0);
+		scheduler->setSlotOffset(TransmitScheduler::Slots::sync, 0);
+		/* the SDOs are sent after the TxPDOs of the nodes */
+		scheduler->setSlotOffset(TransmitScheduler::Slots::sdo, (unsigned int)(500000./(double)motor_servo_rate));
+		/* configuration SDOs must not delay the control messages */
+		scheduler->setMaxSDOFramesPerCycle(4);
+	}
+
+	/* react on emergency objects */
+	for (int iBus=0; iBus<nBuses; iBus++) {
+		busManager.getBus(iBus)->getEMCYManager()->setFaultHandler(emcy_fault_handler);
+		busManager.getBus(iBus)->getEMCYManager()->addCallback(printEmergencyObject);
+	}
+
+	/* the diagnostics of the library are formatted outside of the cycle threads */
+	Logger::start();
+
+	/* the counters of the buses and nodes can be read with metricsDump */
+	Metrics::open();
+
 	/* initialize desired CAN commands to zero */
 	for (int iBus=0; iBus<nBuses; iBus++) {
 		for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
@@ -197,15 +254,28 @@ int main(int argc, char** args)
 		}
 	}
 
-	int rc = pthread_create(&main_task, NULL, main_routine, (void *) &busRoutineArgs[0]);
+	/* the pages of the process stay in memory, the bus routine preempts the main routine */
+	RealTimeThread::lockMemory();
+	RealTimeThread::Parameters mainParameters;
+	mainParameters.priority = 70;
+	RealTimeThread::Parameters busParameters;
+	busParameters.priority = 80;
+
+	int rc = RealTimeThread::create(&main_task, main_routine, (void *) &busRoutineArgs[0], mainParameters);
     assert(0 == rc);
 
-	rc = pthread_create(&bus_task, NULL, bus_routine, (void *) &busRoutineArgs[0]);
+	rc = RealTimeThread::create(&bus_task, bus_routine, (void *) &busRoutineArgs[0], busParameters);
     assert(0 == rc);
 
 
+    /* this thread is not real-time, it prints the emergency objects until the bus task terminates */
     printf("wait for termination of bus task\n");
-    rc = pthread_join(bus_task, NULL);
+    while ((rc = pthread_tryjoin_np(bus_task, NULL)) == EBUSY) {
+        for (int iBus=0; iBus<nBuses; iBus++) {
+            busManager.getBus(iBus)->getEMCYManager()->dispatch();
+        }
+        usleep(10000);
+    }
     assert(0 == rc);
 
     printf("wait for termination of main task\n");
@@ -217,18 +287,12 @@ int main(int argc, char** args)
 void *main_routine(void *arg)
 {
 
-	// variables for timing
-	struct timespec   ts;
-	struct timeval    start_tp;
-
 	CAN_BusDataMeas canDataMeas[nBuses][nMeasMsg];
 	CAN_BusDataDes canDataDes[nBuses][nDesMsg];
 
 
-	// initialize time
-	gettimeofday(&start_tp, NULL);
-	ts.tv_sec = start_tp.tv_sec;
-	ts.tv_nsec = start_tp.tv_usec*1000;
+	// the cycles start at absolute deadlines of the monotonic clock
+	PeriodicTimer timer((unsigned int)(1000000./(double)motor_servo_rate));
 
 	int counter = 0;
 
@@ -238,11 +302,8 @@ void *main_routine(void *arg)
 	 * LOOP
 	 *******************************************************/
 	while (true) {
-		// increment the time
-		ts.tv_nsec += (int)(1000000000./(double)motor_servo_rate);
-		ts.tv_sec  += (int)(ts.tv_nsec/1000000000.);
-		ts.tv_nsec  = ts.tv_nsec%1000000000;
-		clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &ts,NULL);
+		// wait for the start of the cycle
+		timer.waitForNextCycle();
 
 
 
@@ -258,25 +319,17 @@ void *main_routine(void *arg)
 		 * READ RECEIVED CAN MESSAGES
 		 *******************************************************/
 		for (int iBus=0; iBus<nBuses; iBus++) {
-			Bus* bus = busManager.getBus(iBus);
-
-			/* TxPDOs */
-			for (int iPDO=0; iPDO<bus->getTxPDOManager()->getSize(); iPDO++) {
-				int smId = bus->getTxPDOManager()->getPDO(iPDO)->getSMId();
-				bus->getTxPDOManager()->getPDO(iPDO)->setCANMsg(&canDataMeas[iBus][smId]);
-			}
-			/* SDO */
-			SDOMsg* sdo = bus->getSDOManager()->getReceiveSDO();
-			int smId = sdo->getInputMsg()->getSMId();
-			if (smId != -1) {
-				sdo->receiveMsg(&canDataMeas[iBus][smId]);
-			}
+			busManager.getBus(iBus)->ingest(Span<const CANMsg>(canDataMeas[iBus], nMeasMsg));
 		}
 
 		/*******************************************************
 		 * RUN TASK
 		 *******************************************************/
 		// do something
+		/* only the main routine changes the state, an emergency object is never overwritten */
+		if (isEMCYFault.load(std::memory_order_acquire)) {
+			stateSM = SM_EMERGENCY_STOP;
+		}
 		switch (stateSM) {
 		case SM_INIT_MOTOR:
 			if (counter*time_step_ms/1000.0 > 2.0) {
@@ -301,7 +354,10 @@ void *main_routine(void *arg)
 		case SM_RUN:
 			setMotorVelocity(10.0);
 			printPositionVelocity();
-			if (counter*time_step_ms/1000.0 > 20.0) {
+			if (!checkMotorHeartbeats()) {
+				printf("motor is missing, emergency stop\n");
+				stateSM = SM_EMERGENCY_STOP;
+			} else if (counter*time_step_ms/1000.0 > 20.0) {
 				printf("emergency stop\n");
 				stateSM = SM_EMERGENCY_STOP;
 			}
@@ -319,28 +375,7 @@ void *main_routine(void *arg)
 		 * FILL CAN MESSAGES TO SEND
 		 *******************************************************/
 		for (int iBus=0; iBus<nBuses; iBus++) {
-			for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
-				canDataDes[iBus][iMsg].flag = 0;
-			}
-		}
-
-		for (int iBus=0; iBus<nBuses; iBus++) {
-			Bus* bus = busManager.getBus(iBus);
-			/* RxPDOs */
-			PDOManager* pdoManager = bus->getRxPDOManager();
-			if (pdoManager->isSending()) {
-				for (int iPDO=0; iPDO<pdoManager->getSize(); iPDO++)
-				{
-					int smId = pdoManager->getPDO(iPDO)->getSMId();
-					pdoManager->getPDO(iPDO)->getCANMsg(&canDataDes[iBus][smId]);
-				}
-			}
-			/* SDO */
-			SDOMsg* sdo = bus->getSDOManager()->getSendSDO();
-			int smId = sdo->getOutputMsg()->getSMId();
-			if (smId != -1) {
-				sdo->sendMsg(&canDataDes[iBus][smId]);
-			}
+			busManager.getBus(iBus)->emit(Span<CANMsg>(canDataDes[iBus], nDesMsg));
 		}
 
 		/*******************************************************
@@ -359,10 +394,6 @@ void *main_routine(void *arg)
 void *bus_routine(void *arg)
 {
 
-	// variables for timing
-	struct timespec   ts;
-	struct timeval    start_tp;
-
 	// name of the channel
 	char channelname[100];
 	//! CAN messages to send from shared memory
@@ -371,8 +402,10 @@ void *bus_routine(void *arg)
 	bool unpluggedBus[nBuses];
 	//! number of not transmitted messages
 	int noTransmitCounter[nBuses];
-	//! maximum allowed number of not transmitted messages -> otherwise device is unplugged
+	//! maximum allowed number of consecutive not transmitted messages -> otherwise device is unplugged
 	int maxNoTransmitCounter = 5;
+	//! duration of a cycle in which the messages are sent [us]
+	const unsigned int cycleTime_us = (unsigned int)(1000000./(double)motor_servo_rate);
 	//! received message
 	CPC_MSG_T *pMsg;
 
@@ -386,6 +419,7 @@ void *bus_routine(void *arg)
 	for (int i=0; i<nBuses; i++) {
 		//! devices are  not unplugged
 		unpluggedBus[i] = false;
+		noTransmitCounter[i] = 0;
 
 		/* open channel */
 		sprintf(channelname, "CHAN0%d", busRoutineArgs[i].iBus);
@@ -405,6 +439,12 @@ void *bus_routine(void *arg)
 		// This sets up the parameters used to initialize the CAN controller
 		printf("Initializing CAN-Controller ... ");
 
+		/* accept only the COB-IDs of the bus, the SJA1000 has two filters in dual filter mode */
+		unsigned char accCode[4];
+		unsigned char accMask[4];
+		busManager.getBus(i)->updateAcceptanceFilter(2);
+		busManager.getBus(i)->getAcceptanceFilter()->getSJA1000DualFilter(accCode, accMask);
+
 		// Parameters of the can interface
 		CPC_INIT_PARAMS_T *CPCInitParamsPtr;
 		CPCInitParamsPtr = CPC_GetInitParamsPtr(busRoutineArgs[i].handle);
@@ -412,14 +452,14 @@ void *bus_routine(void *arg)
 		CPCInitParamsPtr->canparams.cc_params.sja1000.btr0       = BTR0;
 		CPCInitParamsPtr->canparams.cc_params.sja1000.btr1       = BTR1;
 		CPCInitParamsPtr->canparams.cc_params.sja1000.outp_contr = 0xda;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code0  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code1  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code2  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code3  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask0  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask1  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask2  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask3  = 0xff;
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code0  = accCode[0];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code1  = accCode[1];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code2  = accCode[2];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code3  = accCode[3];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask0  = accMask[0];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask1  = accMask[1];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask2  = accMask[2];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask3  = accMask[3];
 		CPCInitParamsPtr->canparams.cc_params.sja1000.mode       = 0;
 
 		// init the CAN controller
@@ -438,10 +478,8 @@ void *bus_routine(void *arg)
 
 	}
 
-	// initialize time
-	gettimeofday(&start_tp, NULL);
-	ts.tv_sec = start_tp.tv_sec;
-	ts.tv_nsec = start_tp.tv_usec*1000;
+	// the cycles start at absolute deadlines of the monotonic clock
+	PeriodicTimer timer(cycleTime_us);
 
 
 
@@ -450,11 +488,14 @@ void *bus_routine(void *arg)
 	 * LOOP
 	 *******************************************************/
 	while (true) {
-		// increment the time
-		ts.tv_nsec += (int)(1000000000./(double)motor_servo_rate);
-		ts.tv_sec  += (int)(ts.tv_nsec/1000000000.);
-		ts.tv_nsec  = ts.tv_nsec%1000000000;
-		clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &ts,NULL);
+		// wait for the start of the cycle, a missed deadline is an overrun
+		const bool isOnTime = timer.waitForNextCycle();
+		for (int iBus=0; iBus<nBuses; iBus++) {
+			Metrics::increment(Metrics::getBus(iBus).cycles);
+			if (!isOnTime) {
+				Metrics::increment(Metrics::getBus(iBus).cycleOverruns);
+			}
+		}
 
 
 		/*******************************************************
@@ -492,54 +533,88 @@ void *bus_routine(void *arg)
 		/*******************************************************
 		 * SEND CAN MESSAGES
 		 *******************************************************/
-		for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
-			for (int iBus=0; iBus<nBuses; iBus++) {
+		/* sort the flagged messages into the slots of the cycle */
+		for (int iBus=0; iBus<nBuses; iBus++) {
+			TransmitScheduler* scheduler = busManager.getBus(iBus)->getTransmitScheduler();
+			scheduler->beginCycle();
 
-				/* send only if flag is true */
+			for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
+				/* send only if flag is true, the dirty slots of the bus belong to the frames of
+				 * the main loop, not to this copy of the shared memory */
 				if (canDataDes[iBus][iMsg].flag && !unpluggedBus[iBus]) {
+					CANMsg canMsg;
+					canMsg.COBId = canDataDes[iBus][iMsg].COBId;
+					canMsg.length = canDataDes[iBus][iMsg].length;
+					for (int l=0; l<canMsg.length; l++) {
+						canMsg.value[l] = canDataDes[iBus][iMsg].value[l];
+					}
+					scheduler->addFrame(canMsg);
+				}
+			}
+		}
+
+		/* release the frames at the offsets of their slots until the cycle ends */
+		while (true) {
+			const long int elapsed_us = (long int)timer.getElapsedTime_us();
+			if (elapsed_us >= (long int)cycleTime_us) {
+				/* the remaining frames are dropped by the scheduler */
+				break;
+			}
+
+			unsigned int nextReleaseTime_us = cycleTime_us;
+			for (int iBus=0; iBus<nBuses; iBus++) {
+				TransmitScheduler* scheduler = busManager.getBus(iBus)->getTransmitScheduler();
 
+				CANMsg canMsg;
+				while (!unpluggedBus[iBus] && scheduler->getFrame(elapsed_us > 0 ? (unsigned int)elapsed_us : 0, &canMsg)) {
 					CPC_CAN_MSG_T cmsg = {0x00L,0,{0,0,0,0,0,0,0,0}};
 					// put the can id of the device in cmsg
-					cmsg.id = canDataDes[iBus][iMsg].COBId;
+					cmsg.id = canMsg.COBId;
 					// put the length of the message in cmsg
-					cmsg.length = canDataDes[iBus][iMsg].length;
+					cmsg.length = canMsg.length;
 					// put the data of the message in cmsg
 					for(int l=0;l<cmsg.length;l++) {
-						cmsg.msg[l] = canDataDes[iBus][iMsg].value[l];
+						cmsg.msg[l] = canMsg.value[l];
 					}
 
-
-
 					/*******************************************************
 					 * SEND CAN MESSAGE
 					*******************************************************/
-					int ret;
-
-	//				if (CPC_WaitForEvent(busRoutineArgs[i].handle, 1, EVENT_WRITE) & EVENT_WRITE) {
-						ret =  CPC_SendMsg(busRoutineArgs[iBus].handle, 0, &cmsg);
-						if (ret < 0) {
-							/* an error happened */
-							if (ret == CPC_ERR_CAN_NO_TRANSMIT_BUF) {
-								noTransmitCounter[iBus]++;
-								if (noTransmitCounter[iBus] > maxNoTransmitCounter) {
-									unpluggedBus[iBus] = true;
-									emergency_stop();
-								}
-							}
-							printf("ERROR Bus%d: %s\n", busRoutineArgs[iBus].iBus,
-									CPC_DecodeErrorMsg(ret));
+					int ret =  CPC_SendMsg(busRoutineArgs[iBus].handle, 0, &cmsg);
+					if (ret == CPC_ERR_CAN_NO_TRANSMIT_BUF) {
+						Metrics::increment(Metrics::getBus(iBus).txBufferFull);
+						/* the frame is sent again as soon as the driver has a free buffer */
+						scheduler->requeueFrame();
+						noTransmitCounter[iBus]++;
+						if (noTransmitCounter[iBus] > maxNoTransmitCounter) {
+							unpluggedBus[iBus] = true;
+							emergency_stop();
 						}
-	//				} else {
-	//					printf("ERROR: Transmit Timeout!\n");
-	//					ret = -1;
-	//				}
-
-					usleep(120);
-
-
+						break;
+					}
+					if (ret < 0) {
+						/* an error happened */
+						Metrics::increment(Metrics::getBus(iBus).busErrors);
+						printf("ERROR Bus%d: %s\n", busRoutineArgs[iBus].iBus,
+								CPC_DecodeErrorMsg(ret));
+					} else {
+						LIBCANPLUSPLUS_TRACE3(frame_tx, iBus, canMsg.COBId, canMsg.length);
+						Metrics::increment(Metrics::getBus(iBus).framesSent);
+						noTransmitCounter[iBus] = 0;
+					}
 				}
 
+				if (!unpluggedBus[iBus] && scheduler->hasFrames()
+						&& scheduler->getNextReleaseTime() < nextReleaseTime_us) {
+					nextReleaseTime_us = scheduler->getNextReleaseTime();
+				}
 			}
+			if (nextReleaseTime_us >= cycleTime_us) {
+				break;
+			}
+
+			/* wait for the next frame */
+			timer.sleepUntil(nextReleaseTime_us);
 		}
 
 
@@ -553,6 +628,7 @@ void msg_handler(int handle, const CPC_MSG_T * cpcmsg, void *customPointer)
 {
 	CAN_BusDataMeas canDataMeas;
 	const int iBus = handle;
+	Metrics::increment(Metrics::getBus(iBus).framesReceived);
 
 //	printf("Received a Message!\n");
 
@@ -562,33 +638,60 @@ void msg_handler(int handle, const CPC_MSG_T * cpcmsg, void *customPointer)
 	for (int k=0; k<8;k++) {
 		canDataMeas.value[k] = cpcmsg->msg.canmsg.msg[k];
 	}
+	LIBCANPLUSPLUS_TRACE3(frame_rx, iBus, canDataMeas.COBId, canDataMeas.length);
+
+	/* latency-critical PDOs are decoded right away, the main loop still gets the frame */
+	busManager.getBus(iBus)->getReceiveDispatcher()->dispatch(canDataMeas);
 
 	int msgIdx = getMsgIdxFromCOBId(iBus, canDataMeas.COBId);
 	if (msgIdx != -1) {
+		/* numbered, such that a frame that is read in several cycles is decoded once */
+		canDataMeas.sequence = busManager.getBus(iBus)->getReceiveSlots()->nextSequence(msgIdx);
 		process_bus_meas(&canDataMeas, iBus, msgIdx);
 	} else {
-		/* check for errors sent by EPOS */
-		if (canDataMeas.COBId > 0x80 && canDataMeas.COBId < 0x100) {
-			if ((canDataMeas.value[0] == 0x00) && (canDataMeas.value[1] == 0x00)) {
-
-				/* no error */
-				;
-			} else {
-				/* error */
-				emergency_stop();
-				printf("\e[0;31m(COB_ID: 0x%02X / code: 0x%02X%02X)\n", canDataMeas.COBId, canDataMeas.value[1], canDataMeas.value[0]);
-				printf("==============>\n");
-				printf("ERROR - emergency object found\n");
-				decodeEmergencyObject(canDataMeas.value);
-				printf("<==============\n\n\e[0m");
-
-			}
+		/* emergency objects are decoded by the EMCY manager of the bus */
+		CANMsg canMsg;
+		canMsg.COBId = canDataMeas.COBId;
+		canMsg.length = canDataMeas.length;
+		for (int k=0; k<8;k++) {
+			canMsg.value[k] = canDataMeas.value[k];
+		}
+		if (!busManager.getBus(iBus)->getEMCYManager()->receiveMsg(&canMsg)) {
+			printf("Warning: Received CAN message that is not handled!\n");
 		}
-		printf("Warning: Received CAN message that is not handled!\n");
 	}
 }
 
 
+//////////////////////////////////////////////////////////////////////////////
+void emcy_fault_handler(const EMCYEvent& event, void* userData)
+{
+	/* the motor is stopped by the main routine */
+	isEMCYFault.store(true, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+void printEmergencyObject(const EMCYEvent& event)
+{
+	if (event.isErrorReset()) {
+		printf("Node %d: error reset\n", event.nodeId);
+		return;
+	}
+	printf("\e[0;31m(COB_ID: 0x%02X / code: 0x%04X)\n", 0x80+event.nodeId, event.code);
+	printf("==============>\n");
+	printf("ERROR - emergency object found\n");
+	printf("%s\n", event.description);
+	printf("error register: 0x%02X data: 0x%02X 0x%02X 0x%02X 0x%02X 0x%02X\n",
+			event.errorRegister,
+			event.data[0],
+			event.data[1],
+			event.data[2],
+			event.data[3],
+			event.data[4]);
+	printf("<==============\n\n\e[0m");
+}
+
+
 //////////////////////////////////////////////////////////////////////////////
 int getMsgIdxFromCOBId(int iBus, int COBId)
 {
@@ -603,8 +706,10 @@ int getMsgIdxFromCOBId(int iBus, int COBId)
 		return MEASSMID_TxPDO_MOTOR;
 	// Motor  SDO
 	case SDOId+NODEID_MOTOR:
-	case NMTEnteredPreOperational+NODEID_MOTOR:
 		return MEASSMID_SDO_MOTOR;
+	// Motor heartbeat
+	case NMTEnteredPreOperational+NODEID_MOTOR:
+		return MEASSMID_NMT_MOTOR;
 	default:
 		/* not handled CAN message */
 		return -1;
@@ -614,44 +719,6 @@ int getMsgIdxFromCOBId(int iBus, int COBId)
 }
 
 
-bool decodeEmergencyObject(unsigned char* DATA)
-{
-
-	if ((DATA[0] == 0x00) && (DATA[1] == 0x00)) {
-		printf("No error\n");
-		return false;
-	} else if ((DATA[0] == 0x00) && (DATA[1] == 0x10)) {
-		printf("generic error\n");
-	} else if ((DATA[0]==0x10)&&(DATA[1]==0x23)) {
-		printf("over current error\n");
-	} else if ((DATA[0]==0x20)&&(DATA[1]==0x32)) {
-		printf("under voltage error\n");
-	} else if ((DATA[0]==0x10)&&(DATA[1]==0x42)) {
-		printf("over temperature error\n");
-	} else if ((DATA[0]==0x13)&&(DATA[1]==0x51)) {
-		printf("supply voltage too low error\n");
-	} else if ((DATA[0]==0x00)&&(DATA[1]==0x61)) {
-		printf("internal software error\n");
-	} else if ((DATA[0]==0x00)&&(DATA[1]==0x61)) {
-		printf("internal software error\n");
-	} else if ((DATA[0]==0x11)&&(DATA[1]==0x86)) {
-		printf("Following error\n");
-	} else if ((DATA[0]==0x09)&&(DATA[1]==0xFF)) {
-		printf("Software position limit error\n"); // 0Xff09
-	} else if ((DATA[0]==0x08)&&(DATA[1]==0xFF)) {
-		printf("Hall Angle detection error\n");
-	} else if ((DATA[0]==0x01)&&(DATA[1]==0xFF)) {
-		printf("Hall Sensor error\n");
-	} else if ((DATA[0]==0x0B)&&(DATA[1]==0xFF)) {
-		printf("System overloaded\n");
-	} else if ((DATA[0]==0x30)&&(DATA[1]==0x81)) {
-			printf("CAN Life guard error\n");
-		}
-	else {
-		printf("Error not specified\n");
-	}
-	return true;
-}
 
 
 
@@ -673,28 +740,7 @@ void catch_signal(int sig)
 
 		 /* FILL CAN MESSAGES TO SEND */
 		for (int iBus=0; iBus<nBuses; iBus++) {
-			for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
-				canDataDes[iBus][iMsg].flag = 0;
-			}
-		}
-
-		for (int iBus=0; iBus<nBuses; iBus++) {
-			Bus* bus = busManager.getBus(iBus);
-			/* RxPDOs */
-			PDOManager* pdoManager = bus->getRxPDOManager();
-			if (pdoManager->isSending()) {
-				for (int iPDO=0; iPDO<pdoManager->getSize(); iPDO++)
-				{
-					int smId = pdoManager->getPDO(iPDO)->getSMId();
-					pdoManager->getPDO(iPDO)->getCANMsg(&canDataDes[iBus][smId]);
-				}
-			}
-			/* SDO */
-			SDOMsg* sdo = bus->getSDOManager()->getSendSDO();
-			int smId = sdo->getOutputMsg()->getSMId();
-			if (smId != -1) {
-				sdo->sendMsg(&canDataDes[iBus][smId]);
-			}
+			busManager.getBus(iBus)->emit(Span<CANMsg>(canDataDes[iBus], nDesMsg));
 		}
 
 		/* WRITE COMMANDS TO SHARED MEMORY */
@@ -744,6 +790,19 @@ void emergency_stop(void)
 
 }
 
+//////////////////////////////////////////////////////////////////////////////
+bool checkMotorHeartbeats()
+{
+	bool isAlive = true;
+	for (int iBus=0; iBus<nBuses; iBus++) {
+		DeviceEPOS2Motor* motor = (DeviceEPOS2Motor*) busManager.getBus(iBus)->getDeviceManager()->getDevice(0);
+		if (!motor->checkHeartbeat()) {
+			isAlive = false;
+		}
+	}
+	return isAlive;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 void setMotorVelocity(double velocity)
 {
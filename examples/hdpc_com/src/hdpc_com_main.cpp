@@ -13,14 +13,19 @@
 
 /* libCAN */
 #include "CANPThread.h"
+#include "libcanplusplus/Metrics.hpp"
+#include "libcanplusplus/RealTimeThread.hpp"
+#include "libcanplusplus/Trace.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <iostream>
 #include <signal.h>
+#include <atomic>
 
 // ROS
 #include "ros/ros.h"
+#include "libcanplusplus/RosLogSink.hpp"
 
 
 #include "hdpc_com_main.hpp"
@@ -60,6 +65,9 @@ BusRoutineArguments busRoutineArgs[nBuses];
 //! if true, the program is terminating
 static bool isTerminating = false;
 
+//! if true, a node reported an error by an emergency object
+static std::atomic<bool> isEMCYFault(false);
+
 //! thread task
 pthread_t bus_task;
 
@@ -93,26 +101,23 @@ void emergency_stop(void);
  */
 void msg_handler(int handle, const CPC_MSG_T * cpcmsg, void *customPointer);
 
-/*! Maps the COB ID of a CAN message to the index of shared memory.
- * @param	iBus	number of bus
- * @param 	COBId	COB Id of message
- * @return the index of the shared memory. Returns -1 if there is no mapping
+/*! Reacts on an error reported by an emergency object
+ * Is invoked in the thread of the message handler and must not block.
+ * @param	event		decoded emergency object
+ * @param	userData	not used
  */
-int getMsgIdxFromCOBId(int iBus, int COBId);
+void emcy_fault_handler(const EMCYEvent& event, void* userData);
 
-/*! Decodes an emergency object received from an EPOS
- * @param	DATA	CAN message
- * @return	true if it is really an error
+/*! Prints an emergency object
+ * Is invoked by the dispatch() of the EMCY manager in the ROS loop of main(), which
+ * does not run with a real-time priority.
+ * @param	event		decoded emergency object
  */
-bool decodeEmergencyObject(unsigned char* DATA);
+void printEmergencyObject(const EMCYEvent& event);
 
 //////////////////////////////////////////////////////////////////////////////
 int main(int argc, char** argv)
 {
-	CAN_BusDataMeas canDataMeas[nBuses][nMeasMsg];
-	CAN_BusDataDes canDataDes[nBuses][nDesMsg];
-
-
 	/* install signal handlers */
 	atexit(removeSharedMemoryAtExit);
 	signal(SIGTERM, catch_signal);
@@ -124,19 +129,6 @@ int main(int argc, char** argv)
 	ros::init(argc, argv, "hdpc_com", ros::init_options::NoSigintHandler);
 
 
-	//! number of measurement messages per Bus (6xPDOPositionVelocity + 6xSDO)
-	nMeasMsg = 30;
-	//! number of desired messages per Bus (3xPDOVelocity + 1xPDOSync + 1xSDO)
-	nDesMsg = 21;
-
-	// init shared memory that is used to communicate between the main and bus routine
-	if(!init_can_shared_memory()) {
-		printf("Could not init shared memory!");
-		exit(-1);
-	}
-
-
-
 	/* initialize the initial arguments of the bus routines */
 	for (int i=0; i<nBuses; i++) {
 		busRoutineArgs[i].iBus = 0;
@@ -145,8 +137,11 @@ int main(int argc, char** argv)
 
 	/* add devices to bus manager */
 	for (int iBus=0; iBus<nBuses; iBus++) {
-		busManager.addBus(new Bus(iBus));
-		busManager.getBus(iBus)->getRxPDOManager()->addPDO(new RxPDOSync(DESSMID_RxPDO_SYNC));
+		/* the PDOs and SDOs get the next free slot of the frames of the bus */
+		Bus* bus = new Bus(iBus);
+		bus->setAutomaticSlots(true);
+		busManager.addBus(bus);
+		busManager.getBus(iBus)->getRxPDOManager()->addPDO(new RxPDOSync(SlotMap::autoSlot));
 		//int iDevice=7;
 //		busManager.getBus(iBus)->getDeviceManager()->addDevice(new DeviceELMODrivingMotor(NODEID_ELMO0+iDevice, new Maxon_RE40_Enc500(
 //																													DESSMID_RxPDO_ELMO0_PROFILE+iDevice,
@@ -210,14 +205,14 @@ int main(int argc, char** argv)
 		/* add 6 driving motors */
 		for (int iDevice=0; iDevice < 6; iDevice++) {
 			busManager.getBus(iBus)->getDeviceManager()->addDevice(new DeviceELMODrivingMotor(NODEID_ELMO0+iDevice, new Maxon_RE40_Enc500(
-																														DESSMID_RxPDO_ELMO0_PROFILE+iDevice,
-																														0,
-																														0,
-																														0,
-																														MEASSMID_TxPDO_ELMO0_POSITION_VELOCITY+iDevice,
-																														MEASSMID_TxPDO_ELMO0_ANALOG_CURRENT+iDevice,
-																														MEASSMID_SDO_ELMO0+iDevice,
-																														DESSMID_SDO_ELMO0+iDevice,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
 																														analogConversion[iDevice][0],
 																														analogConversion[iDevice][1])));
 
@@ -225,14 +220,14 @@ int main(int argc, char** argv)
 		/* add 4 steering motors */
 		for (int iDevice=6; iDevice < 10; iDevice++) {
 			busManager.getBus(iBus)->getDeviceManager()->addDevice(new ELMOSteeringProxy(NODEID_ELMO0+iDevice, new Maxon_REmax24_Enc512(
-																														DESSMID_RxPDO_ELMO0_PROFILE+iDevice,
-																														0,
-																														0,
-																														0,
-																														MEASSMID_TxPDO_ELMO0_POSITION_VELOCITY+iDevice,
-																														MEASSMID_TxPDO_ELMO0_ANALOG_CURRENT+iDevice,
-																														MEASSMID_SDO_ELMO0+iDevice,
-																														DESSMID_SDO_ELMO0+iDevice,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
+																														SlotMap::autoSlot,
 																														analogConversion[iDevice][0],
 																														analogConversion[iDevice][1])));
 
@@ -240,6 +235,62 @@ int main(int argc, char** argv)
 
 	}
 
+	/* the frames of the buses are sized to the slots of the devices */
+	nMeasMsg = 0;
+	nDesMsg = 0;
+	for (int iBus=0; iBus<nBuses; iBus++) {
+		if (busManager.getBus(iBus)->getReceiveSlots()->getSize() > nMeasMsg) {
+			nMeasMsg = busManager.getBus(iBus)->getReceiveSlots()->getSize();
+		}
+		if (busManager.getBus(iBus)->getSendSlots()->getSize() > nDesMsg) {
+			nDesMsg = busManager.getBus(iBus)->getSendSlots()->getSize();
+		}
+	}
+	CAN_BusDataMeas canDataMeas[nBuses][nMeasMsg];
+	CAN_BusDataDes canDataDes[nBuses][nDesMsg];
+
+	// init shared memory that is used to communicate between the main and bus routine
+	if(!init_can_shared_memory()) {
+		printf("Could not init shared memory!");
+		exit(-1);
+	}
+
+	/* place the RxPDOs, the SYNC and the SDOs at fixed offsets within the cycle */
+	for (int iBus=0; iBus<nBuses; iBus++) {
+		TransmitScheduler* scheduler = busManager.getBus(iBus)->getTransmitScheduler();
+		scheduler->setCycleTime((unsigned int)(1000000./(double)motor_servo_rate));
+		scheduler->setBitrate(1000000);
+		scheduler->setTxQueueDepth(2);
+		/* the SYNC directly follows the RxPDOs */
+		scheduler->setSlotOffset(TransmitScheduler::Slots::rxPDO, 0);
+		scheduler->setSlotOffset(TransmitScheduler::Slots::sync, 0);
+		/* the SDOs are sent after the TxPDOs of the nodes */
+		scheduler->setSlotOffset(TransmitScheduler::Slots::sdo, (unsigned int)(500000./(double)motor_servo_rate));
+		/* configuration SDOs must not delay the control messages */
+		scheduler->setMaxSDOFramesPerCycle(4);
+	}
+
+	/* most axes are idle most of the time, hence the commands are only sent if they change
+	 * and refreshed every 100ms */
+	for (int iBus=0; iBus<nBuses; iBus++) {
+		busManager.getBus(iBus)->getRxPDOManager()->setTransmissionPolicy(CANOpenMsg::TransmissionPolicies::onChangeOrRefresh,
+																		 (unsigned int)(100.0/time_step_ms));
+	}
+
+	/* react on emergency objects */
+	for (int iBus=0; iBus<nBuses; iBus++) {
+		busManager.getBus(iBus)->getEMCYManager()->setFaultHandler(emcy_fault_handler);
+		busManager.getBus(iBus)->getEMCYManager()->addCallback(printEmergencyObject);
+	}
+
+	/* the diagnostics of the library are formatted outside of the cycle threads */
+	static RosLogSink rosLogSink;
+	Logger::setSink(&rosLogSink);
+	Logger::start();
+
+	/* the counters of the buses and nodes can be read with metricsDump */
+	Metrics::open();
+
 	/* initialize desired CAN commands to zero */
 	for (int iBus=0; iBus<nBuses; iBus++) {
 		for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
@@ -249,11 +300,22 @@ int main(int argc, char** argv)
 	}
 
 
+	/* boots all devices in parallel, the broadcast NMT commands are sent with the SDO slot of the first device */
+	BootManager bootManager(busManager.getBus(0),
+							busManager.getBus(0)->getReceiveSlots()->getSlot(canopen::TxSDOId + NODEID_ELMO0),
+							busManager.getBus(0)->getSendSlots()->getSlot(canopen::RxSDOId + NODEID_ELMO0));
+	stateMachine.bootManager_ = &bootManager;
+
 	stateMachine.initROS();
 	stateMachine.initiate();
 
+	/* the pages of the process stay in memory, the bus routine runs with a real-time priority */
+	RealTimeThread::lockMemory();
+	RealTimeThread::Parameters busParameters;
+	busParameters.priority = 80;
+
 	int rc = 0;
-    rc = pthread_create(&bus_task, NULL, bus_routine, (void *) &busRoutineArgs[0]);
+    rc = RealTimeThread::create(&bus_task, bus_routine, (void *) &busRoutineArgs[0], busParameters);
     if (rc) {
         ROS_ERROR("Error while create bus_routine thread");
         return -1;
@@ -275,19 +337,14 @@ int main(int argc, char** argv)
 		 * READ RECEIVED CAN MESSAGES
 		 *******************************************************/
 		for (int iBus=0; iBus<nBuses; iBus++) {
-			Bus* bus = busManager.getBus(iBus);
-
-			/* TxPDOs */
-			for (int iPDO=0; iPDO<bus->getTxPDOManager()->getSize(); iPDO++) {
-				int smId = bus->getTxPDOManager()->getPDO(iPDO)->getSMId();
-				bus->getTxPDOManager()->getPDO(iPDO)->setCANMsg(&canDataMeas[iBus][smId]);
-			}
-			/* SDO */
-			SDOMsg* sdo = bus->getSDOManager()->getReceiveSDO();
-			int smId = sdo->getInputMsg()->getSMId();
-			if (smId != -1) {
-				sdo->receiveMsg(&canDataMeas[iBus][smId]);
-			}
+			busManager.getBus(iBus)->ingest(Span<const CANMsg>(canDataMeas[iBus], nMeasMsg));
+		}
+		/* the ROS loop is not real-time, the emergency objects may be printed here */
+		for (int iBus=0; iBus<nBuses; iBus++) {
+			busManager.getBus(iBus)->getEMCYManager()->dispatch();
+		}
+		if (isEMCYFault.exchange(false)) {
+			emergency_stop();
 		}
 
 		/*******************************************************
@@ -301,30 +358,7 @@ int main(int argc, char** argv)
 		 * FILL CAN MESSAGES TO SEND
 		 *******************************************************/
 		for (int iBus=0; iBus<nBuses; iBus++) {
-			for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
-				canDataDes[iBus][iMsg].flag = 0;
-			}
-		}
-
-		for (int iBus=0; iBus<nBuses; iBus++) {
-			Bus* bus = busManager.getBus(iBus);
-			/* RxPDOs */
-			PDOManager* pdoManager = bus->getRxPDOManager();
-			if (pdoManager->isSending()) {
-				for (int iPDO=0; iPDO<pdoManager->getSize(); iPDO++)
-				{
-					int smId = pdoManager->getPDO(iPDO)->getSMId();
-					pdoManager->getPDO(iPDO)->getCANMsg(&canDataDes[iBus][smId]);
-				}
-			}
-
-			/* SDO */
-			SDOMsg* sdo = bus->getSDOManager()->getSendSDO();
-			int smId = sdo->getOutputMsg()->getSMId();
-			if (smId != -1) {
-				sdo->sendMsg(&canDataDes[iBus][smId]);
-			}
-
+			busManager.getBus(iBus)->emit(Span<CANMsg>(canDataDes[iBus], nDesMsg));
 		}
 
 		/*******************************************************
@@ -352,10 +386,6 @@ int main(int argc, char** argv)
 void *bus_routine(void *arg)
 {
 
-	// variables for timing
-	struct timespec   ts;
-	struct timeval    start_tp;
-
 	// name of the channel
 	char channelname[100];
 	//! CAN messages to send from shared memory
@@ -364,8 +394,10 @@ void *bus_routine(void *arg)
 	bool unpluggedBus[nBuses];
 	//! number of not transmitted messages
 	int noTransmitCounter[nBuses];
-	//! maximum allowed number of not transmitted messages -> otherwise device is unplugged
+	//! maximum allowed number of consecutive not transmitted messages -> otherwise device is unplugged
 	int maxNoTransmitCounter = 5;
+	//! duration of a cycle in which the messages are sent [us]
+	const unsigned int cycleTime_us = (unsigned int)(1000000./(double)motor_servo_rate);
 	//! received message
 	CPC_MSG_T *pMsg;
 
@@ -401,6 +433,12 @@ void *bus_routine(void *arg)
 		// This sets up the parameters used to initialize the CAN controller
 		printf("Initializing CAN-Controller ... ");
 
+		/* accept only the COB-IDs of the bus, the SJA1000 has two filters in dual filter mode */
+		unsigned char accCode[4];
+		unsigned char accMask[4];
+		busManager.getBus(i)->updateAcceptanceFilter(2);
+		busManager.getBus(i)->getAcceptanceFilter()->getSJA1000DualFilter(accCode, accMask);
+
 		// Parameters of the can interface
 		CPC_INIT_PARAMS_T *CPCInitParamsPtr;
 		CPCInitParamsPtr = CPC_GetInitParamsPtr(busRoutineArgs[i].handle);
@@ -408,14 +446,14 @@ void *bus_routine(void *arg)
 		CPCInitParamsPtr->canparams.cc_params.sja1000.btr0       = BTR0;
 		CPCInitParamsPtr->canparams.cc_params.sja1000.btr1       = BTR1;
 		CPCInitParamsPtr->canparams.cc_params.sja1000.outp_contr = 0xda;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code0  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code1  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code2  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code3  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask0  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask1  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask2  = 0xff;
-		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask3  = 0xff;
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code0  = accCode[0];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code1  = accCode[1];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code2  = accCode[2];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_code3  = accCode[3];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask0  = accMask[0];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask1  = accMask[1];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask2  = accMask[2];
+		CPCInitParamsPtr->canparams.cc_params.sja1000.acc_mask3  = accMask[3];
 		CPCInitParamsPtr->canparams.cc_params.sja1000.mode       = 0;
 
 		// init the CAN controller
@@ -431,10 +469,8 @@ void *bus_routine(void *arg)
 		CPC_Control(busRoutineArgs[i].handle, CONTR_CAN_Message | CONTR_CONT_ON);
 	}
 
-	// initialize time
-	gettimeofday(&start_tp, NULL);
-	ts.tv_sec = start_tp.tv_sec;
-	ts.tv_nsec = start_tp.tv_usec*1000;
+	// the cycles start at absolute deadlines of the monotonic clock
+	PeriodicTimer timer(cycleTime_us);
 
 
 
@@ -443,11 +479,14 @@ void *bus_routine(void *arg)
 	 * LOOP
 	 *******************************************************/
 	while (true) {
-		// increment the time
-		ts.tv_nsec += (int)(1000000000./(double)motor_servo_rate);
-		ts.tv_sec  += (int)(ts.tv_nsec/1000000000.);
-		ts.tv_nsec  = ts.tv_nsec%1000000000;
-		clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &ts,NULL);
+		// wait for the start of the cycle, a missed deadline is an overrun
+		const bool isOnTime = timer.waitForNextCycle();
+		for (int iBus=0; iBus<nBuses; iBus++) {
+			Metrics::increment(Metrics::getBus(iBus).cycles);
+			if (!isOnTime) {
+				Metrics::increment(Metrics::getBus(iBus).cycleOverruns);
+			}
+		}
 
 		ROS_DEBUG("CAN loop");
 
@@ -486,55 +525,89 @@ void *bus_routine(void *arg)
 		/*******************************************************
 		 * SEND CAN MESSAGES
 		 *******************************************************/
-		for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
-			for (int iBus=0; iBus<nBuses; iBus++) {
+		/* sort the flagged messages into the slots of the cycle */
+		for (int iBus=0; iBus<nBuses; iBus++) {
+			TransmitScheduler* scheduler = busManager.getBus(iBus)->getTransmitScheduler();
+			scheduler->beginCycle();
 
-				/* send only if flag is true */
+			for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
+				/* send only if flag is true, the dirty slots of the bus belong to the frames of
+				 * the main loop, not to this copy of the shared memory */
 				if (canDataDes[iBus][iMsg].flag && !unpluggedBus[iBus]) {
+					CANMsg canMsg;
+					canMsg.COBId = canDataDes[iBus][iMsg].COBId;
+					canMsg.length = canDataDes[iBus][iMsg].length;
+					for (int l=0; l<canMsg.length; l++) {
+						canMsg.value[l] = canDataDes[iBus][iMsg].value[l];
+					}
+					scheduler->addFrame(canMsg);
+				}
+			}
+		}
 
+		/* release the frames at the offsets of their slots until the cycle ends */
+		while (true) {
+			const long int elapsed_us = (long int)timer.getElapsedTime_us();
+			if (elapsed_us >= (long int)cycleTime_us) {
+				/* the remaining frames are dropped by the scheduler */
+				break;
+			}
+
+			unsigned int nextReleaseTime_us = cycleTime_us;
+			for (int iBus=0; iBus<nBuses; iBus++) {
+				TransmitScheduler* scheduler = busManager.getBus(iBus)->getTransmitScheduler();
+
+				CANMsg canMsg;
+				while (!unpluggedBus[iBus] && scheduler->getFrame(elapsed_us > 0 ? (unsigned int)elapsed_us : 0, &canMsg)) {
 					CPC_CAN_MSG_T cmsg = {0x00L,0,{0,0,0,0,0,0,0,0}};
 					// put the can id of the device in cmsg
-					cmsg.id = canDataDes[iBus][iMsg].COBId;
+					cmsg.id = canMsg.COBId;
 					// put the length of the message in cmsg
-					cmsg.length = canDataDes[iBus][iMsg].length;
+					cmsg.length = canMsg.length;
 					// put the data of the message in cmsg
 					for(int l=0;l<cmsg.length;l++) {
-						cmsg.msg[l] = canDataDes[iBus][iMsg].value[l];
+						cmsg.msg[l] = canMsg.value[l];
 					}
 
-
-
 					/*******************************************************
 					 * SEND CAN MESSAGE
 					*******************************************************/
-					int ret;
-
-	//				if (CPC_WaitForEvent(busRoutineArgs[i].handle, 1, EVENT_WRITE) & EVENT_WRITE) {
-						ret =  CPC_SendMsg(busRoutineArgs[iBus].handle, 0, &cmsg);
-						if (ret < 0) {
-							/* an error happened */
-							if (ret == CPC_ERR_CAN_NO_TRANSMIT_BUF) {
-								noTransmitCounter[iBus]++;
-								if (noTransmitCounter[iBus] > maxNoTransmitCounter) {
-									unpluggedBus[iBus] = true;
-									emergency_stop();
-									noTransmitCounter[iBus] = 0;
-								}
-							}
-							printf("ERROR Bus%d: %s\n", busRoutineArgs[iBus].iBus,
-									CPC_DecodeErrorMsg(ret));
+					int ret =  CPC_SendMsg(busRoutineArgs[iBus].handle, 0, &cmsg);
+					if (ret == CPC_ERR_CAN_NO_TRANSMIT_BUF) {
+						Metrics::increment(Metrics::getBus(iBus).txBufferFull);
+						/* the frame is sent again as soon as the driver has a free buffer */
+						scheduler->requeueFrame();
+						noTransmitCounter[iBus]++;
+						if (noTransmitCounter[iBus] > maxNoTransmitCounter) {
+							unpluggedBus[iBus] = true;
+							emergency_stop();
+							noTransmitCounter[iBus] = 0;
 						}
-	//				} else {
-	//					printf("ERROR: Transmit Timeout!\n");
-	//					ret = -1;
-	//				}
-
-					usleep(120);
-
-
+						break;
+					}
+					if (ret < 0) {
+						/* an error happened */
+						Metrics::increment(Metrics::getBus(iBus).busErrors);
+						printf("ERROR Bus%d: %s\n", busRoutineArgs[iBus].iBus,
+								CPC_DecodeErrorMsg(ret));
+					} else {
+						LIBCANPLUSPLUS_TRACE3(frame_tx, iBus, canMsg.COBId, canMsg.length);
+						Metrics::increment(Metrics::getBus(iBus).framesSent);
+						noTransmitCounter[iBus] = 0;
+					}
 				}
 
+				if (!unpluggedBus[iBus] && scheduler->hasFrames()
+						&& scheduler->getNextReleaseTime() < nextReleaseTime_us) {
+					nextReleaseTime_us = scheduler->getNextReleaseTime();
+				}
 			}
+			if (nextReleaseTime_us >= cycleTime_us) {
+				break;
+			}
+
+			/* wait for the next frame */
+			timer.sleepUntil(nextReleaseTime_us);
 		}
 
 
@@ -563,28 +636,7 @@ void catch_signal(int sig)
 
 		 /* FILL CAN MESSAGES TO SEND */
 		for (int iBus=0; iBus<nBuses; iBus++) {
-			for (int iMsg=0; iMsg<nDesMsg; iMsg++) {
-				canDataDes[iBus][iMsg].flag = 0;
-			}
-		}
-
-		for (int iBus=0; iBus<nBuses; iBus++) {
-			Bus* bus = busManager.getBus(iBus);
-			/* RxPDOs */
-			PDOManager* pdoManager = bus->getRxPDOManager();
-			if (pdoManager->isSending()) {
-				for (int iPDO=0; iPDO<pdoManager->getSize(); iPDO++)
-				{
-					int smId = pdoManager->getPDO(iPDO)->getSMId();
-					pdoManager->getPDO(iPDO)->getCANMsg(&canDataDes[iBus][smId]);
-				}
-			}
-			/* SDO */
-			SDOMsg* sdo = bus->getSDOManager()->getSendSDO();
-			int smId = sdo->getOutputMsg()->getSMId();
-			if (smId != -1) {
-				sdo->sendMsg(&canDataDes[iBus][smId]);
-			}
+			busManager.getBus(iBus)->emit(Span<CANMsg>(canDataDes[iBus], nDesMsg));
 		}
 
 		/* WRITE COMMANDS TO SHARED MEMORY */
@@ -639,6 +691,7 @@ void msg_handler(int handle, const CPC_MSG_T * cpcmsg, void *customPointer)
 {
 	CAN_BusDataMeas canDataMeas;
 	const int iBus = handle;
+	Metrics::increment(Metrics::getBus(iBus).framesReceived);
 
 
 	canDataMeas.flag = 1;
@@ -647,43 +700,25 @@ void msg_handler(int handle, const CPC_MSG_T * cpcmsg, void *customPointer)
 	for (int k=0; k<8;k++) {
 		canDataMeas.value[k] = cpcmsg->msg.canmsg.msg[k];
 	}
+	LIBCANPLUSPLUS_TRACE3(frame_rx, iBus, canDataMeas.COBId, canDataMeas.length);
+
+	/* latency-critical PDOs are decoded right away, the main loop still gets the frame */
+	busManager.getBus(iBus)->getReceiveDispatcher()->dispatch(canDataMeas);
 
-	int msgIdx = getMsgIdxFromCOBId(iBus, canDataMeas.COBId);
+	int msgIdx = busManager.getBus(iBus)->getReceiveSlots()->getSlot(canDataMeas.COBId);
 	if (msgIdx != -1) {
+		/* numbered, such that a frame that is read in several cycles is decoded once */
+		canDataMeas.sequence = busManager.getBus(iBus)->getReceiveSlots()->nextSequence(msgIdx);
 		process_bus_meas(&canDataMeas, iBus, msgIdx);
 	} else {
-		/* check for errors sent by EPOS */
-		if (canDataMeas.COBId > 0x80 && canDataMeas.COBId < 0x100) {
-			if ((canDataMeas.value[0] == 0x00) && (canDataMeas.value[1] == 0x00)) {
-
-				/* no error */
-				;
-			} else if ((canDataMeas.value[0] == 0x00) && (canDataMeas.value[1] == 0x63)) {
-				/* emergency stop was pressed */
-				//stateMachine.process_event(EvEmergencyStop());
-			} else if ((canDataMeas.value[0] == 0x41) && (canDataMeas.value[1] == 0x54)&& (canDataMeas.value[2] == 0x21)) {
-				/* limit switch error */
-				//stateMachine.process_event(EvEmergencyStop());
-			} else {
-				/* error */
-				emergency_stop();
-				printf("\e[0;31m(COB_ID: 0x%02X / code: 0x%02X%02X)\n", canDataMeas.COBId, canDataMeas.value[1], canDataMeas.value[0]);
-				printf("==============>\n");
-				printf("ERROR - emergency object found\n");
-				decodeEmergencyObject(canDataMeas.value);
-				printf("0x%02X 0x%02X 0x%02X 0x%02X 0x%02X 0x%02X 0x%02X 0x%02X\n",
-						canDataMeas.value[0],
-						canDataMeas.value[1],
-					    canDataMeas.value[2],
-					    canDataMeas.value[3],
-					    canDataMeas.value[4],
-					    canDataMeas.value[5],
-					    canDataMeas.value[6],
-					    canDataMeas.value[7]);
-				printf("<==============\n\n\e[0m");
-
-			}
+		/* emergency objects are decoded by the EMCY manager of the bus */
+		CANMsg canMsg;
+		canMsg.COBId = canDataMeas.COBId;
+		canMsg.length = canDataMeas.length;
+		for (int k=0; k<8;k++) {
+			canMsg.value[k] = canDataMeas.value[k];
 		}
+		busManager.getBus(iBus)->getEMCYManager()->receiveMsg(&canMsg);
 		/* debugging */
 //		printf("Warning: Received CAN message that is not handled!\n");
 //		printf("\e[0;31m(COB_ID: 0x%02X / code: 0x%02X%02X)\n", canDataMeas.COBId, canDataMeas.value[1], canDataMeas.value[0]);
@@ -703,70 +738,40 @@ void msg_handler(int handle, const CPC_MSG_T * cpcmsg, void *customPointer)
 
 
 //////////////////////////////////////////////////////////////////////////////
-int getMsgIdxFromCOBId(int iBus, int COBId)
+void emcy_fault_handler(const EMCYEvent& event, void* userData)
 {
-//	const int TxPDO1Id = 0x180;
-//	const int TxPDO2Id = 0x280;
-	const int TxPDO3Id = 0x380;
-	const int TxPDO4Id = 0x480;
-
-	const int SDOId = 0x580;
-	const int NMTEnteredPreOperational = 0x700;
-
-
-	for (int i=0; i<nMeasMsg; i++)  {
-		if (COBId == TxPDO3Id+NODEID_ELMO0+i)
-			return MEASSMID_TxPDO_ELMO0_POSITION_VELOCITY+i;
-		if (COBId == TxPDO4Id+NODEID_ELMO0+i)
-			return MEASSMID_TxPDO_ELMO0_ANALOG_CURRENT+i;
-		if (COBId == SDOId+NODEID_ELMO0+i)
-			return MEASSMID_SDO_ELMO0+i;
-		if (COBId == NMTEnteredPreOperational+NODEID_ELMO0+i)
-			return MEASSMID_SDO_ELMO0+i;
+	if (event.code == 0x6300) {
+		/* emergency stop was pressed */
+		return;
 	}
-	return -1;
-
-
+	if (event.code == 0x5441 && event.errorRegister == 0x21) {
+		/* limit switch error */
+		return;
+	}
+	/* the state machine is stopped by the main loop */
+	isEMCYFault = true;
 }
 
-
-bool decodeEmergencyObject(unsigned char* DATA)
+//////////////////////////////////////////////////////////////////////////////
+void printEmergencyObject(const EMCYEvent& event)
 {
-
-	if ((DATA[0] == 0x00) && (DATA[1] == 0x00)) {
-		printf("No error\n");
-		return false;
-	} else if ((DATA[0] == 0x00) && (DATA[1] == 0x10)) {
-		printf("generic error\n");
-	} else if ((DATA[0]==0x10)&&(DATA[1]==0x23)) {
-		printf("over current error\n");
-	} else if ((DATA[0]==0x20)&&(DATA[1]==0x32)) {
-		printf("under voltage error\n");
-	} else if ((DATA[0]==0x10)&&(DATA[1]==0x42)) {
-		printf("over temperature error\n");
-	} else if ((DATA[0]==0x13)&&(DATA[1]==0x51)) {
-		printf("supply voltage too low error\n");
-	} else if ((DATA[0]==0x00)&&(DATA[1]==0x61)) {
-		printf("internal software error\n");
-	} else if ((DATA[0]==0x00)&&(DATA[1]==0x61)) {
-		printf("internal software error\n");
-	} else if ((DATA[0]==0x11)&&(DATA[1]==0x86)) {
-		printf("Following error\n");
-	} else if ((DATA[0]==0x09)&&(DATA[1]==0xFF)) {
-		printf("Software position limit error\n"); // 0Xff09
-	} else if ((DATA[0]==0x08)&&(DATA[1]==0xFF)) {
-		printf("Hall Angle detection error\n");
-	} else if ((DATA[0]==0x01)&&(DATA[1]==0xFF)) {
-		printf("Hall Sensor error\n");
-	} else if ((DATA[0]==0x0B)&&(DATA[1]==0xFF)) {
-		printf("System overloaded\n");
-	} else if ((DATA[0]==0x30)&&(DATA[1]==0x81)) {
-			printf("CAN Life guard error\n");
-	} else if ((DATA[0]==0x54)&&(DATA[1]==0x21)) {
-		printf("Disabled by limit switch\n");
-	} else {
-		printf("Error not specified\n");
+	if (event.isErrorReset()) {
+		printf("Node %d: error reset\n", event.nodeId);
+		return;
 	}
-	return true;
+	printf("\e[0;31m(COB_ID: 0x%02X / code: 0x%04X)\n", 0x80+event.nodeId, event.code);
+	printf("==============>\n");
+	printf("ERROR - emergency object found\n");
+	printf("%s\n", event.description);
+	printf("error register: 0x%02X data: 0x%02X 0x%02X 0x%02X 0x%02X 0x%02X\n",
+			event.errorRegister,
+			event.data[0],
+			event.data[1],
+			event.data[2],
+			event.data[3],
+			event.data[4]);
+	printf("<==============\n\n\e[0m");
 }
 
+
+
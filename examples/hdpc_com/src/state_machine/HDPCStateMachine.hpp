@@ -28,6 +28,7 @@
 #include <boost/statechart/transition.hpp>
 
 #include "BusManager.hpp"
+#include "BootManager.hpp"
 
 #define ELMOSteeringUseVelocity 0
 #if ELMOSteeringUseVelocity==1
@@ -83,6 +84,9 @@ public:
 	//! reference to bus manager
 	BusManager* busManager_;
 
+	//! reference to the boot manager of the bus
+	BootManager* bootManager_;
+
     //! time step for the controller
     double time_step_ms_;
 
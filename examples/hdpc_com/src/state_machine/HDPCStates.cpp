@@ -46,12 +46,14 @@ sc::result StTop::react( const EvTerminateSM& )
 
 //////////////////////////////////////////////////////////////////////////////
 StInit::StInit( my_context ctx ) :
-  my_base( ctx ), iDevice_(0), waitForDeviceCount_(10000)
+  my_base( ctx )
 {
 	ROS_INFO("Entering StInit");
 	outermost_context_type & machine = outermost_context();
 	machine.busManager_->getBus(0)->getRxPDOManager()->setSending(false);
 
+	/* reset all devices and configure them in parallel */
+	machine.bootManager_->start();
 }
 
 StInit::~StInit() {
@@ -65,26 +67,15 @@ sc::result StInit::react( const EvExecute& )
 {
 	outermost_context_type & machine = outermost_context();
 
-	/* The previous device should have some time to initialize
-	 * counts ~= 2x no. of SDOs to init
-	 */
-	if (waitForDeviceCount_++ > 100) {
-		waitForDeviceCount_ = 0;
-
-		DeviceManager* devices = machine.busManager_->getBus(0)->getDeviceManager();
-
-		/* check if all devices are initialized */
-		if (iDevice_ >= devices->getSize()) {
-			return transit<StHoming>();
-		}
-
-		ROS_INFO("Init device %d", iDevice_);
-		/* initialize device */
+	machine.bootManager_->update();
 
-		DeviceELMOBaseMotor* motor =  (DeviceELMOBaseMotor*) devices->getDevice(iDevice_);
-		motor->initDevice();
-
-		iDevice_++;
+	/* check if all devices are initialized */
+	if (machine.bootManager_->isBootComplete()) {
+		return transit<StHoming>();
+	}
+	if (machine.bootManager_->getState() == BootManager::States::failed) {
+		ROS_ERROR("Could not boot all devices!");
+		return transit<StFault>();
 	}
 
 	return forward_event();
@@ -56,9 +56,6 @@ struct StInit : sc::state< StInit, StTop >
 
     sc::result react( const EvExecute& );
     sc::result react( const EvStateInfo& );
-  private:
-    int iDevice_;
-    int waitForDeviceCount_;
 
 };
 
@@ -0,0 +1,107 @@
+/*!
+ * @file 	AcceptanceFilter.hpp
+ * @brief	Acceptance filters for the COB-IDs that are received on a bus
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef ACCEPTANCEFILTER_HPP_
+#define ACCEPTANCEFILTER_HPP_
+
+#include <stdint.h>
+#include <bitset>
+#include <vector>
+
+//! Computes id/mask pairs that accept a set of 11-bit COB-IDs
+/*! A frame is accepted by a filter if (COBId & mask) == (id & mask), like the filters
+ * of SocketCAN (CAN_RAW_FILTER) and the acceptance filter of a CAN controller.
+ *
+ * compute() merges the COB-IDs to the smallest number of filters that accept exactly
+ * the added COB-IDs (prime implicants with a greedy cover). If the hardware supports
+ * fewer filters, the filters are merged such that the least number of additional
+ * COB-IDs pass, e.g. the SJA1000 in dual filter mode has two filters.
+ *
+ * Usage:
+ * 	bus->updateAcceptanceFilter();
+ * 	channel.setAcceptanceFilter(*bus->getAcceptanceFilter());
+ *
+ * @ingroup robotCAN, bus
+ */
+class AcceptanceFilter {
+public:
+	//! number of 11-bit COB-IDs
+	static const int nCOBIds = 2048;
+
+	//! mask of all bits of a COB-ID
+	static const uint32_t fullMask = 0x7FF;
+
+	//! Filter of the COB-IDs with (COBId & mask) == (id & mask)
+	struct Filter {
+		//! COB-ID
+		uint32_t id;
+		//! bits of the COB-ID that must match
+		uint32_t mask;
+	};
+
+	//! Constructor
+	AcceptanceFilter();
+
+	//! Destructor
+	virtual ~AcceptanceFilter();
+
+	//! Removes all COB-IDs and filters
+	void clear();
+
+	/*! Adds a COB-ID that needs to be received
+	 * @param COBId	11-bit COB-ID
+	 */
+	void addCOBId(int COBId);
+
+	/*! Checks if a COB-ID was added
+	 * @param COBId	COB-ID
+	 * @return true if added
+	 */
+	bool hasCOBId(int COBId) const;
+
+	/*! Computes the filters of the added COB-IDs
+	 * @param maxFilters	maximum number of filters, 0 for no limit
+	 * @return number of filters
+	 */
+	int compute(int maxFilters = 0);
+
+	/*! Checks if a COB-ID passes the computed filters
+	 * @param COBId	COB-ID
+	 * @return true if accepted
+	 */
+	bool accepts(int COBId) const;
+
+	/*! Gets the number of computed filters
+	 * @return number of filters
+	 */
+	int getNumberOfFilters() const;
+
+	/*! Gets a computed filter
+	 * @param index	index of the filter
+	 * @return filter
+	 */
+	const Filter& getFilter(int index) const;
+
+	/*! Gets the acceptance code and mask registers of the SJA1000 in dual filter mode
+	 * The filters have to be computed with at most two filters. The first data byte and
+	 * the RTR bit are not filtered.
+	 * @param code	acceptance code registers ACR0-ACR3
+	 * @param mask	acceptance mask registers AMR0-AMR3, a set bit is not compared
+	 */
+	void getSJA1000DualFilter(unsigned char code[4], unsigned char mask[4]) const;
+
+private:
+	//! added COB-IDs
+	std::bitset<nCOBIds> COBIds_;
+
+	//! computed filters
+	std::vector<Filter> filters_;
+};
+
+#endif /* ACCEPTANCEFILTER_HPP_ */
@@ -0,0 +1,72 @@
+/*!
+ * @file 	AllocationGuard.hpp
+ * @brief	Detection of heap allocations in the real-time cycle
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef ALLOCATIONGUARD_HPP_
+#define ALLOCATIONGUARD_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+//! Reports or aborts on heap allocations of a sealed thread
+/*! If the library is built with ALLOCATION_GUARD (-DLIBCANPLUSPLUS_ALLOCATION_GUARD),
+ * it replaces the global operator new and delete. Every operator new of a thread that
+ * invoked seal() is counted, the first one is reported on stderr or the process is
+ * aborted. Direct calls of malloc() are not detected.
+ *
+ * The storage of the buses, devices, PDOs and SDOs is taken from memory pools that
+ * are sized at initialization:
+ * 	CANOpenMsg::reservePool(nMsgs);		// PDOs and two messages per SDO
+ * 	SDOMsg::reservePool(nSDOs);
+ * 	bus->getSDOManager()->reserve(nSDOs);
+ * 	bus->getRxPDOManager()->reserve(nPDOs);
+ * 	...
+ * 	AllocationGuard::seal();			// in the cycle thread, after initialization
+ *
+ * @ingroup robotCAN
+ */
+class AllocationGuard {
+public:
+	//! Action on an allocation of a sealed thread
+	enum class Actions : uint8_t {
+		//! the first allocation is reported, all are counted
+		report = 0,
+		//! the process is aborted
+		abort = 1
+	};
+
+	/*! Checks if the library replaces operator new, i.e. allocations are detected
+	 * @return true if built with ALLOCATION_GUARD
+	 */
+	static bool isEnabled();
+
+	/*! Seals the calling thread, i.e. it must not allocate from now on
+	 * @param action	action on an allocation
+	 */
+	static void seal(Actions action = Actions::report);
+
+	//! Allows the calling thread to allocate again, e.g. before the shutdown
+	static void unseal();
+
+	/*! Checks if the calling thread is sealed
+	 * @return true if sealed
+	 */
+	static bool isSealed();
+
+	/*! Gets the number of allocations of sealed threads
+	 * @return number of allocations
+	 */
+	static unsigned int getNumberOfAllocations();
+
+	/*! Is invoked by operator new
+	 * @param size	number of allocated bytes
+	 */
+	static void notifyAllocation(size_t size);
+};
+
+#endif /* ALLOCATIONGUARD_HPP_ */
@@ -0,0 +1,151 @@
+/*!
+ * @file 	BootManager.hpp
+ * @brief	Parallel boot-up of all nodes of a bus
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef BOOTMANAGER_HPP_
+#define BOOTMANAGER_HPP_
+
+#include <functional>
+#include <vector>
+
+#include "libcanplusplus/Bus.hpp"
+
+//! Boots all devices of a bus in parallel (similar to the NMT master of CiA 302)
+/*! The boot-up consists of the following steps:
+ * 	1. a broadcast NMT reset communication is sent to all nodes
+ * 	2. each node is identified by its boot-up message, a node whose NMT state has no
+ * 	   shared memory index (see Device::setNMTSMId()) is assumed to be booted after the
+ * 	   boot-up delay
+ * 	3. each identified node is configured by Device::configureDevice(), the SDOs of
+ * 	   all nodes are processed concurrently by the SDO manager
+ * 	4. as soon as all nodes are configured, a broadcast NMT start brings them to operational
+ *
+ * update() needs to be invoked once per cycle after the received messages are processed.
+ * The SDOs have to be processed with SDOManager::getSendSDOs() and
+ * SDOManager::getReceiveSDOs(), otherwise the nodes are configured one after the other.
+ * Do not invoke Device::checkHeartbeat() during the boot-up, since it initializes a
+ * device on its own when the boot-up message arrives.
+ *
+ * Usage:
+ * 	BootManager bootManager(bus, MEASSMID_SDO, DESSMID_SDO);
+ * 	bootManager.setBootCompleteCallback([](bool success) { ... });
+ * 	bootManager.start();
+ * 	while (...) { ... bootManager.update(); ... }
+ *
+ * @ingroup robotCAN, bus
+ */
+class BootManager {
+public:
+	//! Boot state of the manager
+	enum class States : uint8_t {
+		idle = 0,
+		booting = 1,
+		starting = 2,
+		complete = 3,
+		failed = 4
+	};
+
+	//! Boot state of a node
+	enum class NodeStates : uint8_t {
+		waitingForBootup = 0,
+		configuring = 1,
+		configured = 2,
+		operational = 3,
+		failed = 4
+	};
+
+	//! Callback that is invoked when the boot-up is finished
+	typedef std::function<void(bool isSuccess)> Callback;
+
+	/*! Constructor
+	 * @param bus			bus whose devices are booted
+	 * @param inSDOSMId		shared memory index of the input message of the broadcast NMT commands
+	 * @param outSDOSMId	shared memory index of the output message of the broadcast NMT commands
+	 */
+	BootManager(Bus* bus, int inSDOSMId, int outSDOSMId);
+
+	//! Destructor
+	virtual ~BootManager();
+
+	/*! Sets the maximum time between the reset and the boot-up message of a node
+	 * @param nCycles	timeout [number of calls of update()]
+	 */
+	void setBootupTimeout(int nCycles);
+
+	/*! Sets the time after the reset after which a node whose NMT state is not received is configured
+	 * @param nCycles	delay [number of calls of update()]
+	 */
+	void setBootupDelay(int nCycles);
+
+	/*! Sets the callback that is invoked when the boot-up is finished
+	 * @param callback	callback
+	 */
+	void setBootCompleteCallback(const Callback& callback);
+
+	//! Resets the communication of all nodes and starts the boot-up
+	void start();
+
+	//! Updates the boot state of all nodes, invoke once per cycle
+	void update();
+
+	/*! Gets the boot state
+	 * @return state
+	 */
+	States getState() const;
+
+	/*! Checks if all nodes are operational
+	 * @return true if the boot-up succeeded
+	 */
+	bool isBootComplete() const;
+
+	/*! Gets the boot state of a device
+	 * @param iDevice	index of the device in the device manager
+	 * @return state
+	 */
+	NodeStates getNodeState(int iDevice) const;
+
+private:
+	//! boot state of a device
+	struct Node {
+		//! state
+		NodeStates state;
+		//! number of boot-up messages before the reset
+		unsigned int nBootups;
+		//! number of SDO timeouts before the configuration
+		unsigned int nTimeouts;
+		//! number of SDO aborts before the configuration
+		unsigned int nAborts;
+	};
+
+	//! Finishes the boot-up and invokes the callback
+	void finish(bool isSuccess);
+
+	//! bus whose devices are booted
+	Bus* bus_;
+	//! shared memory index of the input message of the broadcast NMT commands
+	int inSDOSMId_;
+	//! shared memory index of the output message of the broadcast NMT commands
+	int outSDOSMId_;
+
+	//! boot state
+	States state_;
+	//! boot state of the devices
+	std::vector<Node> nodes_;
+
+	//! number of calls of update() since start()
+	int counter_;
+	//! maximum time between the reset and the boot-up message [number of calls of update()]
+	int bootupTimeout_;
+	//! time after the reset after which a node whose NMT state is not received is configured [number of calls of update()]
+	int bootupDelay_;
+
+	//! callback
+	Callback callback_;
+};
+
+#endif /* BOOTMANAGER_HPP_ */
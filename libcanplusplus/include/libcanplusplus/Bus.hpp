@@ -14,6 +14,16 @@
 #include "libcanplusplus/PDOManager.hpp"
 #include "libcanplusplus/SDOManager.hpp"
 #include "libcanplusplus/DeviceManager.hpp"
+#include "libcanplusplus/JointStateBuffer.hpp"
+#include "libcanplusplus/EMCYManager.hpp"
+#include "libcanplusplus/HeartbeatMonitor.hpp"
+#include "libcanplusplus/TransmitScheduler.hpp"
+#include "libcanplusplus/AcceptanceFilter.hpp"
+#include "libcanplusplus/SlotMap.hpp"
+#include "libcanplusplus/ReceiveDispatcher.hpp"
+#include "libcanplusplus/Span.hpp"
+
+#include <vector>
 
 
 class Bus;
@@ -54,12 +64,152 @@ public:
 	 */
 	DeviceManager* getDeviceManager();
 
+	/*! Gets a reference to the buffer of the joint states of all devices
+	 * @return joint state buffer
+	 */
+	JointStateBuffer* getJointStateBuffer();
+
+	/*! Gets a reference to the manager of the emergency objects of the nodes
+	 * @return EMCY manager
+	 */
+	EMCYManager* getEMCYManager();
+
+	/*! Gets a reference to the heartbeat consumer of all nodes
+	 * @return heartbeat monitor
+	 */
+	HeartbeatMonitor* getHeartbeatMonitor();
+
+	/*! Gets a reference to the scheduler of the messages that are sent within a cycle
+	 * @return transmit scheduler
+	 */
+	TransmitScheduler* getTransmitScheduler();
+
+	/*! Gets a reference to the acceptance filter of the received COB-IDs
+	 * @return acceptance filter, see updateAcceptanceFilter()
+	 */
+	AcceptanceFilter* getAcceptanceFilter();
+
+	/*! Gets a reference to the slots of the received frames
+	 * A producer of the frames may mark the slots it wrote dirty, e.g. CyclePipeline
+	 * marks the slots that received a frame in the current period.
+	 * @return slot map of the TxPDOs and SDO responses
+	 */
+	SlotMap* getReceiveSlots();
+
+	/*! Gets a reference to the slots of the sent frames
+	 * The slots of the frames that were flagged by the last emit() are dirty.
+	 * @return slot map of the RxPDOs and SDO requests
+	 */
+	SlotMap* getSendSlots();
+
+	/*! Gets the handlers that are invoked in the receive thread
+	 * @return receive dispatcher
+	 */
+	ReceiveDispatcher* getReceiveDispatcher();
+
+	/*! Allocates the slots of the devices that are added
+	 * The heartbeats of the devices get a slot each and the SDO slots of the nodes are
+	 * allocated when a device is added. The devices should then use SlotMap::autoSlot
+	 * for all their shared memory IDs. Must be invoked before the devices are added.
+	 * @param isAutomatic	if true, the slots are allocated
+	 */
+	void setAutomaticSlots(bool isAutomatic);
+
+	/*! Checks if the slots of the devices are allocated
+	 * @return true if automatic
+	 */
+	bool hasAutomaticSlots();
+
+	/*! Sets the overflow value of the SYNC counter of the bus
+	 * All nodes of a bus count the same SYNC, hence the overflow is shared by the
+	 * devices. It is passed to the RxPDOSync of the RxPDO manager and read by a
+	 * CyclePipeline that sends the SYNC.
+	 * @param overflow	overflow value (2-240), 0 for a SYNC without counter
+	 * @return false if the bus already counts up to a different overflow
+	 */
+	bool setSyncCounterOverflow(int overflow);
+
+	/*! Gets the overflow value of the SYNC counter of the bus
+	 * @return overflow value, 0 if the SYNC has no counter
+	 */
+	int getSyncCounterOverflow() const;
+
+	/*! Computes the acceptance filter from the COB-IDs the bus receives
+	 * These are the TxPDOs including the heartbeats, and the SDO responses and
+	 * emergency objects of the devices. Should be invoked after all devices
+	 * were added and before the filter is installed in the CAN driver.
+	 * @param maxFilters	maximum number of filters of the driver, 0 for no limit
+	 * @return number of filters
+	 */
+	int updateAcceptanceFilter(int maxFilters = 0);
+
+	/*! Processes the frames that were received in this cycle
+	 * Advances the heartbeat monitor, passes the frames to the TxPDOs and to the SDOs
+	 * that wait for a response (one per node). The emergency objects are dispatched by
+	 * getEMCYManager()->dispatch() in a thread that is not real-time.
+	 * @param frames	received frames indexed by the shared memory ID, a frame without flag is empty
+	 */
+	void ingest(Span<const CANMsg> frames);
+
+	/*! Fills the frames that are sent in this cycle
+	 * The flags of the frames of the last emit() are cleared. The RxPDOs are written if the RxPDO manager
+	 * is sending, and the next SDO of each node that is not busy. The flagged frames are
+	 * marked dirty in the slot map of the sent frames.
+	 * @param frames	frames indexed by the shared memory ID, the flag marks a frame to be sent
+	 */
+	void emit(Span<CANMsg> frames);
+
+	/*! First part of ingest(): advances the heartbeat monitor and passes the frames to the TxPDOs
+	 * Is overridden by a bus with further PDOs, e.g. StaticBus.
+	 * @param frames	received frames indexed by the shared memory ID
+	 */
+	virtual void ingestPDOs(Span<const CANMsg> frames);
+
+	/*! Second part of ingest(): passes the frames to the SDOs
+	 * @param frames	received frames indexed by the shared memory ID
+	 */
+	void ingestSDOs(Span<const CANMsg> frames);
+
+	/*! First part of emit(): clears the flags of the frames of the last emit() and writes the RxPDOs
+	 * The frames are cleared by the dirty slots of getSendSlots(), hence the same frames
+	 * should be passed in every cycle and the other flags must be 0.
+	 * Is overridden by a bus with further PDOs, e.g. StaticBus.
+	 * @param frames	frames indexed by the shared memory ID
+	 */
+	virtual void emitPDOs(Span<CANMsg> frames);
+
+	/*! Second part of emit(): writes the next SDO of each node
+	 * @param frames	frames indexed by the shared memory ID
+	 */
+	void emitSDOs(Span<CANMsg> frames);
+
 	/*! Gets the index of the bus
 	 * @return index of bus
 	 */
 	int iBus();
 
+protected:
+	/*! Adds the COB-IDs the bus receives to a filter
+	 * Is invoked by updateAcceptanceFilter().
+	 * @param filter	acceptance filter
+	 */
+	virtual void addReceivedCOBIds(AcceptanceFilter* filter);
+
 private:
+	//! PDO and the frame it is copied from or to
+	struct PDOSlot {
+		CANOpenMsg* pdo;
+		int smId;
+	};
+
+	/*! Collects the PDOs of a manager whose shared memory ID is within the frames
+	 * Is invoked if PDOs were added or the number of frames changed.
+	 * @param pdoManager	PDO manager
+	 * @param[out] slots	PDOs
+	 * @param nFrames		number of frames
+	 */
+	void updatePDOSlots(PDOManager* pdoManager, std::vector<PDOSlot>& slots, size_t nFrames);
+
 	//! PDO manager  that sends the PDOs to the nodes
 	PDOManager* rxPDOManager_;
 	//! PDO manager that receives the PDOs from the nodes
@@ -71,8 +221,55 @@ private:
 	//! device manager
 	DeviceManager* deviceManager_;
 
+	//! joint states of all devices
+	JointStateBuffer* jointStateBuffer_;
+
+	//! emergency objects of all nodes
+	EMCYManager* EMCYManager_;
+
+	//! heartbeat consumer of all nodes
+	HeartbeatMonitor* heartbeatMonitor_;
+
+	//! scheduler of the sent messages
+	TransmitScheduler* transmitScheduler_;
+
+	//! acceptance filter of the received messages
+	AcceptanceFilter* acceptanceFilter_;
+
+	//! slots of the received frames
+	SlotMap* receiveSlots_;
+
+	//! slots of the sent frames
+	SlotMap* sendSlots_;
+
+	//! handlers of the received frames
+	ReceiveDispatcher* receiveDispatcher_;
+
+	//! if true, the slots of the devices are allocated
+	bool isAutomaticSlots_;
+
+	//! overflow value of the SYNC counter, 0 if the SYNC has no counter
+	int syncCounterOverflow_;
+
 	//! index of the bus
 	int iBus_;
+
+	//! TxPDOs of ingest()
+	std::vector<PDOSlot> txPDOSlots_;
+	//! number of PDOs of the TxPDO manager when txPDOSlots_ was updated
+	int nTxPDOs_;
+	//! number of frames when txPDOSlots_ was updated
+	size_t nTxFrames_;
+
+	//! RxPDOs of emit()
+	std::vector<PDOSlot> rxPDOSlots_;
+	//! number of PDOs of the RxPDO manager when rxPDOSlots_ was updated
+	int nRxPDOs_;
+	//! number of frames when rxPDOSlots_ was updated
+	size_t nRxFrames_;
+
+	//! SDOs of the current cycle
+	SDOMsg* sdos_[SDOManager::maxNodes];
 };
 
 #endif /* BUS_HPP_ */
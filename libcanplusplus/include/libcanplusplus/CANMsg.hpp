@@ -3,22 +3,78 @@
 
 
 //! Simple container of a CAN message
+/*! A message with more than 8 data bytes is a CAN FD frame. The length of a CAN FD
+ * frame is one of 0-8, 12, 16, 20, 24, 32, 48 or 64 bytes, see getPaddedLength().
+ *
+ * The producer of a slot of received frames may number the frames it writes, see
+ * SlotMap::nextSequence(), such that a frame that is read twice is not decoded twice.
+ */
 class CANMsg {
  public:
+  //! maximum number of data bytes (CAN FD)
+  static const int maxLength = 64;
+  //! maximum number of data bytes of a classic CAN frame
+  static const int maxClassicLength = 8;
+
   char flag;
   char rtr;
+  //! if true, the message is a CAN FD frame
+  char fdf;
+  //! if true, the data phase of the CAN FD frame is sent with the data bitrate
+  char brs;
   int COBId;
   unsigned char length;
-  unsigned char value[8];
+  unsigned char value[maxLength];
+  //! number of the frame in its slot, 0 if the producer does not number the frames
+  unsigned int sequence;
 
   CANMsg()  {
     flag = 0;
     rtr = 0;
+    fdf = 0;
+    brs = 0;
     COBId = 0;
     length = 0;
-    for (int i=0; i<8; i++) {
+    sequence = 0;
+    for (int i=0; i<maxLength; i++) {
       value[i] = 0;
     }
   }
-};
 
+  /*! Converts a number of data bytes to the data length code
+   * @param length	number of data bytes (0-64)
+   * @return data length code (0-15), the length is rounded up to the next valid length
+   */
+  static unsigned char lengthToDLC(int length) {
+    if (length <= 8) {
+      return (unsigned char)(length < 0 ? 0 : length);
+    }
+    if (length <= 24) {
+      return (unsigned char)(9 + (length - 9)/4);
+    }
+    if (length <= 32) {
+      return 13;
+    }
+    if (length <= 48) {
+      return 14;
+    }
+    return 15;
+  }
+
+  /*! Converts a data length code to the number of data bytes
+   * @param dlc	data length code (0-15)
+   * @return number of data bytes
+   */
+  static int dlcToLength(unsigned char dlc) {
+    static const int lengths[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+    return lengths[dlc & 0x0F];
+  }
+
+  /*! Rounds a number of data bytes up to the next length a CAN FD frame can have
+   * @param length	number of data bytes (0-64)
+   * @return valid length
+   */
+  static int getPaddedLength(int length) {
+    return dlcToLength(lengthToDLC(length));
+  }
+};
@@ -12,6 +12,7 @@
 #define CANOpenMsg_HPP_
 
 #include "libcanplusplus/CANMsg.hpp"
+#include "libcanplusplus/MemoryPool.hpp"
 #include <stdint.h>
 
 //! General CANOpen message container
@@ -22,7 +23,7 @@
  * To send a message, the following information is needed:
  * 	COBId: the Communication Object Identifier
  * 	flag: if true, the CAN message will be sent
- * 	value[8]: a stack of max. 8 values, each element of the array represents maximal a 32bit value
+ * 	value[8]: a stack of values, each element of the array represents maximal a 32bit value
  *  length[8]: the length of each value in the stack in bytes (0-4)
  *
  * As an example, a PDO with a velocity command of 4bytes and a operation mode of 1byte
@@ -39,10 +40,40 @@
  * The stack of values is converted into a stream of unsigned chars by the function
  * getCANMsg().
  *
+ * If the stream is longer than 8 bytes or setFD() was invoked, the message is sent as
+ * CAN FD frame. The stream is padded with zeros to the next valid CAN FD length. The
+ * stack of a CANOpenMsg holds the 8 bytes of a classic frame, a message with up to
+ * 64 bytes is a CANOpenFDMsg. A received frame is truncated to the stack.
+ *
+ * A message that is sent periodically, e.g. a RxPDO, can be sent only if its payload
+ * changed, see setTransmissionPolicy(). getCANMsg() compares the encoded payload with
+ * the payload that was sent last and clears the flag of unchanged messages.
+ *
+ * A received message keeps its values if no new message arrived, i.e. setCANMsg() is
+ * invoked with a cleared flag. With a receive timeout, isStale() tells if the node
+ * stopped sending, e.g. an event-driven TxPDO whose event timer elapsed without a message.
+ * isUpdated() tells if the message was received in this cycle. The time is passed to
+ * setCANMsg() by the caller, e.g. Bus::ingest() reads the clock once for all messages,
+ * hence a message does not read the clock.
+ *
+ * If the producer numbers the frames of a slot (CANMsg::sequence), a frame whose number
+ * was already seen is not decoded again, even if its flag is still set. getAge_cycles()
+ * counts the calls of setCANMsg() without a new frame.
+ *
+ * The messages (PDOs and the messages of the SDOs) are allocated from a memory pool,
+ * see reservePool().
+ *
+ * A periodic message can be sent at a fraction of the cycle rate, see setRateDivisor().
+ * The message is then only sent in every n-th call of getCANMsg(), the phase selects the
+ * call within the period. The calls are counted from the construction of the message,
+ * hence the phases of the messages of a PDO manager are aligned. Spreading the phases of the slow messages keeps the bus load
+ * equal in all cycles, see PDOManager::setRateDivisor().
+ *
  * @ingroup robotCAN
  */
 
 namespace canopen {
+	constexpr int TxEMCYId = 0x80;
 	constexpr int TxPDO1Id = 0x180;
 	constexpr int TxPDO2Id = 0x280;
 	constexpr int TxPDO3Id = 0x380;
@@ -56,10 +87,46 @@ namespace canopen {
 	constexpr int RxPDO3Id = 0x400;
 	constexpr int RxPDO4Id = 0x500;
 	constexpr int RxSDOId = 0x600;
+
+	//! transmission types of a PDO (sub-index 2 of 0x1400-0x15FF and 0x1800-0x19FF)
+	constexpr int TransmissionTypeSynchronousAcyclic = 0x00;
+	constexpr int TransmissionTypeSynchronous = 0x01;
+	constexpr int TransmissionTypeSynchronousMax = 0xF0;
+	constexpr int TransmissionTypeEventManufacturer = 0xFE;
+	constexpr int TransmissionTypeEventProfile = 0xFF;
+
+	/*! Checks if a PDO is sent on an event instead of the SYNC
+	 * @param type	transmission type
+	 * @return true if event-driven (asynchronous)
+	 */
+	constexpr bool isEventDriven(int type) {
+		return type == TransmissionTypeEventManufacturer || type == TransmissionTypeEventProfile;
+	}
+
+	/*! Checks if a PDO is sent on every n-th SYNC
+	 * @param type	transmission type
+	 * @return true if cyclic synchronous, the type is the number of SYNCs between two PDOs
+	 */
+	constexpr bool isSynchronousCyclic(int type) {
+		return type >= TransmissionTypeSynchronous && type <= TransmissionTypeSynchronousMax;
+	}
 }
 
 class CANOpenMsg {
 public:
+	//! size of the stack of values of a classic message, see getStackSize()
+	static const int stackSize = CANMsg::maxClassicLength;
+
+	//! Policy that decides if a flagged message is sent by getCANMsg()
+	enum class TransmissionPolicies : uint8_t {
+		//! the message is sent whenever its flag is set
+		always = 0,
+		//! the message is only sent if the payload changed
+		onChange = 1,
+		//! the message is sent if the payload changed or the refresh period elapsed
+		onChangeOrRefresh = 2
+	};
+
 	/*! Constructor
 	 * @param	COBId	Communication Object Identifier
 	 * @param	SMId	Shared Memory Identifier
@@ -69,6 +136,23 @@ public:
 	//! Destructor
 	virtual ~CANOpenMsg();
 
+	//! Allocates a message from the pool of the messages
+	static void* operator new(size_t size);
+
+	//! Releases a message to the pool of the messages
+	static void operator delete(void* p);
+
+	/*! Allocates the messages at initialization
+	 * A PDO needs one message, an SDO two messages.
+	 * @param nMsgs		number of messages
+	 */
+	static void reservePool(unsigned int nMsgs);
+
+	/*! Gets the pool of the messages
+	 * @return pool
+	 */
+	static MemoryPool& getPool();
+
 	/*! Converts the stack of values to a stream of unsigned chars.
 	 * @param[out]	canDataDes struct of CAN message
 	 */
@@ -76,8 +160,9 @@ public:
 
 	/*! Converts a stream of unsigned chars to a stack of values.
 	 * @param[out]	canDataMeas struct of CAN message
+	 * @param time_us	monotonic time of the call [us], e.g. of the cycle, for the receive timeout
 	 */
-	virtual void setCANMsg(CANMsg *canDataMeas);
+	virtual void setCANMsg(const CANMsg *canDataMeas, int64_t time_us = 0);
 
 	/*! Hook function that is invoked by setCANMsg()
 	 *  Allows to process an incoming message
@@ -107,10 +192,15 @@ public:
 
 	/*! Gets the stack of values
 	 *
-	 * @return reference to value_[8]
+	 * @return reference to value_[getStackSize()]
 	 */
 	int* getValue();
 
+	/*! Gets the size of the stack of values
+	 * @return number of values, stackSize or CANOpenFDMsg::stackSize
+	 */
+	int getStackSize() const;
+
 	/*! Gets the lengths of the values in the stack
 	 * @return reference to length
 	 */
@@ -127,22 +217,115 @@ public:
 	void setRTR(int rtr);
 
 	/*! Sets the stack of values
-	 * @param value	 array of length 8
+	 * @param value	 array of length size
+	 * @param size	 number of values (max. getStackSize()), the remaining values are not changed
 	 */
-	void setValue(int* value);
+	void setValue(int* value, int size = 8);
 
 	/*! Length of the values in the stack
-	 * @param length array of length 8
+	 * @param length array of length size
+	 * @param size	 number of lengths (max. getStackSize()), the remaining lengths are not changed
+	 */
+	void setLength(int* length, int size = 8);
+
+	/*! Sends the message as CAN FD frame even if it has 8 bytes or less
+	 * @param fdf	if true, the message is a CAN FD frame
+	 * @param brs	if true, the data phase is sent with the data bitrate
+	 */
+	void setFD(bool fdf, bool brs = true);
+
+	/*! Checks if the message is a CAN FD frame
+	 * @return true if CAN FD
+	 */
+	bool isFD();
+
+	/*! Sets when a flagged message is sent
+	 * RTR frames are always sent.
+	 * @param policy			transmission policy
+	 * @param refreshPeriod		maximum number of calls of getCANMsg() between two
+	 * 							transmissions of an unchanged payload (onChangeOrRefresh)
+	 */
+	void setTransmissionPolicy(TransmissionPolicies policy, unsigned int refreshPeriod = 0);
+
+	/*! Gets the transmission policy
+	 * @return policy
+	 */
+	TransmissionPolicies getTransmissionPolicy();
+
+	/*! Sends the message with the next call of getCANMsg() even if the payload did not change
+	 * Should be invoked when the node lost its state, e.g. after a reset.
+	 */
+	void forceTransmission();
+
+	/*! Sends the message only in every n-th call of getCANMsg()
+	 * The transmission policy is only evaluated in the calls in which the message is due.
+	 * @param divisor	rate divisor, 1 sends the message in every call
+	 * @param phase		call within the period in which the message is sent (0..divisor-1)
+	 */
+	void setRateDivisor(unsigned int divisor, unsigned int phase = 0);
+
+	/*! Gets the rate divisor
+	 * @return rate divisor
+	 */
+	unsigned int getRateDivisor() const;
+
+	/*! Gets the phase within the period of the rate divisor
+	 * @return phase
+	 */
+	unsigned int getRatePhase() const;
+
+	/*! Sets the maximum time between two received messages
+	 * @param timeout_ms	timeout [ms], 0 disables the supervision
+	 */
+	void setReceiveTimeout(unsigned int timeout_ms);
+
+	/*! Checks if the message was received with the last call of setCANMsg()
+	 * @return true if the values were updated
+	 */
+	bool isUpdated() const;
+
+	/*! Checks if the node stopped sending the message
+	 * A message that was never received is stale.
+	 * @return true if no message arrived within the receive timeout until the last call of setCANMsg()
+	 */
+	bool isStale() const;
+
+	/*! Gets the time from the last reception to the last call of setCANMsg()
+	 * @return age [ms], -1 if the message was never received
 	 */
-	void setLength(int* length);
+	int64_t getAge_ms() const;
+
+	/*! Gets the number of calls of setCANMsg() since the last new message
+	 * @return age [cycles], 0 if received in this cycle, -1 if the message was never received
+	 */
+	int64_t getAge_cycles() const;
+
+	/*! Gets the sequence number of the last received frame
+	 * @return sequence number, 0 if the frames are not numbered
+	 */
+	unsigned int getSequence() const;
 
 	/*! Sets the Communication Object Identifier
 	 * @param COBId	Communication Object Identifier
 	 */
 	void setCOBId(int COBId);
 
+	/*! Sets the Shared Memory Identifier
+	 * Is invoked when the message is added to a bus with SlotMap::autoSlot.
+	 * @param SMId	Shared Memory Identifier
+	 */
+	void setSMId(int SMId);
 
 protected:
+	/*! Constructor of a message with a larger stack, e.g. CANOpenFDMsg
+	 * @param	COBId		Communication Object Identifier
+	 * @param	SMId		Shared Memory Identifier
+	 * @param	value		stack of values of the derived message
+	 * @param	length		lengths of the values of the derived message
+	 * @param	stackSize	size of the stacks
+	 */
+	CANOpenMsg(int COBId, int SMId, int* value, int* length, int stackSize);
+
 	//! Communication Object Identifier
 	int COBId_;
 
@@ -154,13 +337,125 @@ protected:
 
 	/*! Data of the CAN message
 	 */
-	int value_[8];
+	int* value_;
 
 	//! the lengths of the values in the stack value_
-	int length_[8];
+	int* length_;
 
   //! Is it a RTR frame
   int rtr_;
+
+	//! if true, the message is always sent as CAN FD frame
+	bool fdf_;
+
+	//! if true, the data phase of a CAN FD frame is sent with the data bitrate
+	bool brs_;
+
+private:
+	//! size of the stacks value_ and length_
+	int stackSize_;
+
+	//! stack of values of a classic message
+	int classicValue_[stackSize];
+
+	//! lengths of the values of a classic message
+	int classicLength_[stackSize];
+
+	/*! Checks if a message needs to be sent according to the transmission policy
+	 * @param transmitMessage	encoded message
+	 * @return true if the message is sent
+	 */
+	bool isTransmissionRequired(const CANMsg* transmitMessage);
+
+	//! transmission policy
+	TransmissionPolicies transmissionPolicy_;
+
+	//! maximum number of calls of getCANMsg() between two transmissions
+	unsigned int refreshPeriod_;
+
+	//! number of calls of getCANMsg() since the last transmission
+	unsigned int nSkippedCycles_;
+
+	//! if false, the message is sent with the next call of getCANMsg()
+	bool hasSentPayload_;
+
+	//! length of the payload that was sent last
+	unsigned char sentLength_;
+
+	//! payload that was sent last
+	unsigned char sentValue_[CANMsg::maxLength];
+
+	//! the message is sent in every rateDivisor_-th call of getCANMsg()
+	unsigned int rateDivisor_;
+
+	//! call within the period in which the message is sent
+	unsigned int ratePhase_;
+
+	//! number of calls of getCANMsg()
+	uint64_t nCalls_;
+
+	//! maximum time between two received messages [ms], 0 if not supervised
+	unsigned int receiveTimeout_ms_;
+
+	//! true if the message was received with the last call of setCANMsg()
+	bool isUpdated_;
+
+	//! monotonic time of the last reception [us], -1 if never received
+	int64_t receiveTime_us_;
+
+	//! monotonic time of the last call of setCANMsg() [us]
+	int64_t updateTime_us_;
+
+	//! calls of setCANMsg() since the last reception, -1 if never received
+	int64_t age_cycles_;
+
+	//! sequence number of the last received frame, 0 if not numbered
+	unsigned int sequence_;
+};
+
+//! CANOpen message with a stack for the 64 bytes of a CAN FD frame
+/*! Only the PDOs with more than 8 bytes derive from this class, the stack of a
+ * CANOpenMsg holds the 8 bytes of a classic frame. The messages are allocated from
+ * their own memory pool, see reservePool().
+ *
+ * @ingroup robotCAN
+ */
+class CANOpenFDMsg: public CANOpenMsg {
+public:
+	//! size of the stack of values
+	static const int stackSize = CANMsg::maxLength;
+
+	/*! Constructor
+	 * @param	COBId	Communication Object Identifier
+	 * @param	SMId	Shared Memory Identifier
+	 */
+	CANOpenFDMsg(int COBId, int SMId);
+
+	//! Destructor
+	virtual ~CANOpenFDMsg();
+
+	//! Allocates a message from the pool of the CAN FD messages
+	static void* operator new(size_t size);
+
+	//! Releases a message to its pool
+	static void operator delete(void* p);
+
+	/*! Allocates the messages at initialization
+	 * @param nMsgs		number of messages
+	 */
+	static void reservePool(unsigned int nMsgs);
+
+	/*! Gets the pool of the CAN FD messages
+	 * @return pool
+	 */
+	static MemoryPool& getPool();
+
+private:
+	//! stack of values
+	int fdValue_[stackSize];
+
+	//! lengths of the values
+	int fdLength_[stackSize];
 };
 
 #endif /* CANOpenMsg_HPP_ */
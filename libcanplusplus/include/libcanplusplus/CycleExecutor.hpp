@@ -0,0 +1,215 @@
+/*!
+ * @file 	CycleExecutor.hpp
+ * @brief	Periodic cycle of named phases with timing statistics
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef CYCLEEXECUTOR_HPP_
+#define CYCLEEXECUTOR_HPP_
+
+#include <stdint.h>
+#include <atomic>
+
+#include "libcanplusplus/RealTimeThread.hpp"
+#include "libcanplusplus/TimingStatistics.hpp"
+
+//! Runs the phases of a cycle periodically and measures each of them
+/*! The phases are invoked in the order of their enumeration. A phase without function
+ * is skipped. Every phase is timed with CLOCK_MONOTONIC, the statistics tell whether a
+ * long cycle came from the I/O, the decoding or the application:
+ * 	CycleExecutor executor(1000);
+ * 	executor.setPhase(CycleExecutor::Phase::rxDrain, receive, &bus);
+ * 	executor.setPhase(CycleExecutor::Phase::control, control, &robot);
+ * 	executor.setOverrunPolicy(CycleExecutor::OverrunPolicy::fault);
+ * 	executor.run(isRunning);
+ * 	executor.getPhaseStatistics(CycleExecutor::Phase::control).getPercentile_ns(99);
+ *
+ * A cycle overruns if it ends after the start of the next period. The policy selects
+ * the next cycle:
+ * 	skip:		starts at the next deadline in the future, the missed periods are lost
+ * 	compress:	starts immediately, the late cycles run back-to-back until they caught
+ * 				up, at most setMaxCompressedCycles() in a row, then the periods are skipped
+ * 	fault:		the fault handler is invoked and no cycle runs until resetFault()
+ *
+ * The jitter is the time between the deadline of a period and the start of its cycle.
+ *
+ * The functions run in the thread of run() and must be real-time safe.
+ *
+ * @ingroup robotCAN
+ */
+class CycleExecutor {
+public:
+	//! Phases of a cycle
+	enum class Phase : uint8_t {
+		rxDrain = 0,
+		decode = 1,
+		control = 2,
+		encode = 3,
+		sdoService = 4,
+		tx = 5
+	};
+
+	//! number of phases
+	static const int nPhases = 6;
+
+	//! Reaction to a cycle that ends after the start of the next period
+	enum class OverrunPolicy : uint8_t {
+		skip = 0,
+		compress = 1,
+		fault = 2
+	};
+
+	//! Function of a phase
+	typedef void (*PhaseFunction)(void* userData);
+
+	/*! Handler that is invoked by an overrun with the policy fault
+	 * @param lateness_ns	time between the start of the next period and the end of the cycle [ns]
+	 */
+	typedef void (*FaultHandler)(int64_t lateness_ns, void* userData);
+
+	/*! Constructor
+	 * @param period_us	period [us]
+	 */
+	CycleExecutor(unsigned int period_us);
+
+	//! Destructor
+	virtual ~CycleExecutor();
+
+	/*! Gets the name of a phase
+	 * @param phase	phase
+	 * @return name, e.g. "rx drain"
+	 */
+	static const char* getPhaseName(Phase phase);
+
+	/*! Sets the function of a phase
+	 * @param phase		phase
+	 * @param function	function, NULL to skip the phase
+	 * @param userData	pointer that is passed to the function
+	 */
+	void setPhase(Phase phase, PhaseFunction function, void* userData = NULL);
+
+	/*! Sets the reaction to overruns
+	 * @param policy	policy, skip by default
+	 */
+	void setOverrunPolicy(OverrunPolicy policy);
+
+	/*! Sets the maximum number of late cycles that run back-to-back with the policy compress
+	 * @param maxCycles	maximum number of cycles
+	 */
+	void setMaxCompressedCycles(unsigned int maxCycles);
+
+	/*! Sets the handler of the policy fault
+	 * @param handler	handler, NULL to disable
+	 * @param userData	pointer that is passed to the handler
+	 */
+	void setFaultHandler(FaultHandler handler, void* userData = NULL);
+
+	/*! Sets the index of the bus whose metrics are counted
+	 * @param iBus	index of the bus, -1 to disable the counting
+	 */
+	void setBusIndex(int iBus);
+
+	/*! Runs the cycles until isRunning is false or a fault occurred
+	 * @param isRunning	cleared by another thread to stop
+	 */
+	void run(const std::atomic<bool>& isRunning);
+
+	/*! Waits for the start of the next period and runs the phases
+	 * @return false if the cycle overran or the executor is faulted
+	 */
+	bool runCycle();
+
+	/*! Checks if an overrun with the policy fault occurred
+	 * @return true if faulted
+	 */
+	bool isFaulted() const;
+
+	//! Clears the fault, the periods start again at the current time
+	void resetFault();
+
+	/*! Gets the durations of a phase
+	 * @param phase	phase
+	 * @return statistics
+	 */
+	const TimingStatistics& getPhaseStatistics(Phase phase) const;
+
+	/*! Gets the durations of the cycles, from their start until the end of the last phase
+	 * @return statistics
+	 */
+	const TimingStatistics& getCycleStatistics() const;
+
+	/*! Gets the delays between the deadlines of the periods and the start of the cycles
+	 * @return statistics
+	 */
+	const TimingStatistics& getJitterStatistics() const;
+
+	/*! Gets the number of cycles that ended after the start of the next period
+	 * @return number of overruns
+	 */
+	unsigned int getNumberOfOverruns() const;
+
+	/*! Gets the number of cycles
+	 * @return number of cycles
+	 */
+	unsigned int getNumberOfCycles() const;
+
+	//! Removes the durations of all statistics
+	void resetStatistics();
+
+	/*! Gets the timer of the periods
+	 * @return timer
+	 */
+	PeriodicTimer* getTimer();
+
+private:
+	//! function of a phase
+	struct PhaseEntry {
+		PhaseFunction function;
+		void* userData;
+	};
+
+	//! Waits for the start of the next period according to the policy
+	void waitForNextPeriod();
+
+	//! periods
+	PeriodicTimer timer_;
+
+	//! functions of the phases
+	PhaseEntry phases_[nPhases];
+
+	//! reaction to overruns
+	OverrunPolicy policy_;
+	//! maximum number of cycles that run back-to-back
+	unsigned int maxCompressedCycles_;
+	//! number of cycles that ran back-to-back
+	unsigned int nCompressedCycles_;
+	//! true if the last cycle overran
+	bool isLate_;
+
+	//! handler of the policy fault
+	FaultHandler faultHandler_;
+	//! user data of the fault handler
+	void* faultHandlerUserData_;
+	//! true if an overrun with the policy fault occurred
+	std::atomic<bool> isFaulted_;
+
+	//! index of the bus in the metrics, -1 if not counted
+	int iBus_;
+
+	//! durations of the phases
+	TimingStatistics phaseStatistics_[nPhases];
+	//! durations of the cycles
+	TimingStatistics cycleStatistics_;
+	//! delays of the start of the cycles
+	TimingStatistics jitterStatistics_;
+
+	//! number of overruns
+	std::atomic<unsigned int> nOverruns_;
+	//! number of cycles
+	std::atomic<unsigned int> nCycles_;
+};
+
+#endif /* CYCLEEXECUTOR_HPP_ */
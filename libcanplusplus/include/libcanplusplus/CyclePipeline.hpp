@@ -0,0 +1,251 @@
+/*!
+ * @file 	CyclePipeline.hpp
+ * @brief	Cycle that senses, computes and actuates within one period
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef CYCLEPIPELINE_HPP_
+#define CYCLEPIPELINE_HPP_
+
+#include <stdint.h>
+#include <atomic>
+
+#include "libcanplusplus/Bus.hpp"
+#include "libcanplusplus/CANMsg.hpp"
+#include "libcanplusplus/CycleExecutor.hpp"
+#include "libcanplusplus/RealTimeThread.hpp"
+#include "libcanplusplus/SlotMap.hpp"
+
+//! Runs the cycle of a bus in one thread: SYNC, receive, control, send
+/*! With a main routine and a bus routine that run independently, a measurement of
+ * cycle k reaches the nodes in cycle k+1 or k+2. The pipeline does all steps in the
+ * same period. The steps are the phases of a CycleExecutor:
+ * 	rx drain:		waits for the start of the period, sends the SYNC and receives until
+ * 					the expected TxPDOs arrived or the receive deadline elapsed
+ * 	decode:			passes the received frames to the TxPDOs
+ * 	control:		invokes the control callback
+ * 	encode:			writes the RxPDOs
+ * 	SDO service:	passes the responses to the SDOs and writes the next SDOs
+ * 	tx:				sends the frames through the transmit scheduler of the bus
+ * The timing of the phases and the overrun policy are accessed by getExecutor().
+ *
+ * The CAN driver is accessed by two functions, e.g. for a SocketCANChannel:
+ * 	CyclePipeline pipeline(bus, 1000);
+ * 	pipeline.setTransport(
+ * 			[](const CANMsg& frame, void* channel) { return ((SocketCANChannel*)channel)->send(frame); },
+ * 			[](CANMsg* frame, int64_t timeout_us, void* channel) { return ((SocketCANChannel*)channel)->receive(frame, timeout_us); },
+ * 			&channel);
+ * 	pipeline.setControl(control, &robot);
+ * 	pipeline.expectPDO(txPDO);
+ * 	pipeline.setReceiveDeadline(400);
+ * 	pipeline.run(isRunning);
+ *
+ * The SYNC is sent by the pipeline, hence the RxPDO manager of the bus must not hold a
+ * RxPDOSync, its counter counts up to Bus::getSyncCounterOverflow(). Received frames
+ * that have no slot are passed to the EMCY manager, whose events are dispatched by
+ * another thread of the application. All frames are passed to the receive dispatcher
+ * and the receive hook. The transmit hook
+ * may add frames that are not RxPDOs of the bus, see MasterServer. The frames of the
+ * pipeline are stored in the slots of the bus, they are sized by SlotMap::maxSlots,
+ * hence the pipeline does not allocate memory while it runs. The slots that received
+ * a frame in the current period are dirty in the receive slot map of the bus, their
+ * flags are cleared at the start of the next period, hence a frame is processed in one
+ * period only. Only the dirty slots of the send slot map are sent.
+ *
+ * The transport counts the sent and received frames in the metrics, as SocketCANChannel
+ * does, the pipeline counts the cycles and overruns. The static PDOs of a StaticBus are
+ * processed by its overrides of Bus::ingestPDOs() and Bus::emitPDOs().
+ *
+ * The callbacks run in the thread of run() and must be real-time safe.
+ *
+ * @ingroup robotCAN, bus
+ */
+class CyclePipeline {
+public:
+	/*! Sends a frame
+	 * @return 1 if the frame was sent, 0 if the transmit buffer is full, -1 on error
+	 */
+	typedef int (*SendFunction)(const CANMsg& frame, void* userData);
+
+	/*! Receives a frame, waits at most timeout_us
+	 * @return 1 if a frame was received, 0 if the timeout elapsed, -1 on error
+	 */
+	typedef int (*ReceiveFunction)(CANMsg* frame, int64_t timeout_us, void* userData);
+
+	//! Control callback that is invoked between ingest() and emit()
+	typedef void (*ControlCallback)(void* userData);
+
+	//! Hook that is invoked with every received frame, before the frame is stored
+	typedef void (*ReceiveHook)(const CANMsg& frame, void* userData);
+
+	//! Hook that is invoked after the emitted frames were added to the scheduler, may add frames
+	typedef void (*TransmitHook)(TransmitScheduler* scheduler, void* userData);
+
+	/*! Constructor
+	 * @param bus		bus, it is not deleted
+	 * @param period_us	period [us]
+	 */
+	CyclePipeline(Bus* bus, unsigned int period_us);
+
+	//! Destructor
+	virtual ~CyclePipeline();
+
+	/*! Sets the functions that access the CAN driver
+	 * @param send		sends a frame
+	 * @param receive	receives a frame
+	 * @param userData	pointer that is passed to the functions
+	 */
+	void setTransport(SendFunction send, ReceiveFunction receive, void* userData = NULL);
+
+	/*! Sets the control callback
+	 * @param control	callback, NULL if the frames are only exchanged
+	 * @param userData	pointer that is passed to the callback
+	 */
+	void setControl(ControlCallback control, void* userData = NULL);
+
+	/*! Sets the hooks of the received and sent frames, e.g. for frames that are not
+	 * handled by PDOs of the bus
+	 * @param receive	hook of the received frames, NULL to disable
+	 * @param transmit	hook of the sent frames, NULL to disable
+	 * @param userData	pointer that is passed to the hooks
+	 */
+	void setHooks(ReceiveHook receive, TransmitHook transmit, void* userData = NULL);
+
+	/*! Enables the SYNC at the start of a period
+	 * @param isEnabled	if true, a SYNC is sent (default)
+	 */
+	void setSync(bool isEnabled);
+
+	/*! Sets the time until which the expected TxPDOs are awaited
+	 * @param deadline_us	time since the start of the period [us]
+	 */
+	void setReceiveDeadline(unsigned int deadline_us);
+
+	/*! Adds a COB-ID that is awaited in every period
+	 * @param COBId	COB-ID of a received frame that has a slot
+	 * @return false if the COB-ID has no slot
+	 */
+	bool expectCOBId(int COBId);
+
+	/*! Adds a TxPDO that is awaited in every period
+	 * @param pdo	TxPDO that was added to the bus
+	 * @return false if the PDO has no slot
+	 */
+	bool expectPDO(CANOpenMsg* pdo);
+
+	/*! Runs the cycles until isRunning is false
+	 * @param isRunning	cleared by another thread to stop
+	 */
+	void run(const std::atomic<bool>& isRunning);
+
+	/*! Runs one period, waits for its start
+	 * @return true if all expected frames arrived before the receive deadline
+	 */
+	bool runCycle();
+
+	/*! Gets the bus
+	 * @return bus
+	 */
+	Bus* getBus();
+
+	/*! Gets the executor of the phases
+	 * @return executor, e.g. for the timing statistics and the overrun policy
+	 */
+	CycleExecutor* getExecutor();
+
+	/*! Gets the timer of the periods
+	 * @return timer
+	 */
+	PeriodicTimer* getTimer();
+
+	/*! Gets the number of periods
+	 * @return number of cycles
+	 */
+	unsigned int getNumberOfCycles() const;
+
+	/*! Gets the number of periods in which expected frames were missing
+	 * @return number of incomplete cycles
+	 */
+	unsigned int getNumberOfIncompleteCycles() const;
+
+	/*! Gets the longest time from the start of a cycle until the last frame was sent
+	 * @return duration [us]
+	 */
+	int64_t getMaxCycleTime_us() const;
+
+private:
+	//! number of words of a bitmap of the slots
+	static const int nWords = SlotMap::maxSlots/64;
+
+	//! Phases of the executor, userData is the pipeline
+	static void rxDrainPhase(void* pipeline);
+	static void decodePhase(void* pipeline);
+	static void controlPhase(void* pipeline);
+	static void encodePhase(void* pipeline);
+	static void sdoServicePhase(void* pipeline);
+	static void txPhase(void* pipeline);
+
+	//! Receives frames until the expected frames arrived or the deadline elapsed
+	bool receiveFrames();
+
+	//! Stores a received frame in its slot
+	void storeFrame(const CANMsg& frame);
+
+	//! Sends the emitted frames
+	void sendFrames();
+
+	//! bus
+	Bus* bus_;
+
+	//! phases and periods
+	CycleExecutor executor_;
+
+	//! sends a frame
+	SendFunction send_;
+	//! receives a frame
+	ReceiveFunction receive_;
+	//! user data of the transport
+	void* transportUserData_;
+
+	//! control callback
+	ControlCallback control_;
+	//! user data of the control callback
+	void* controlUserData_;
+
+	//! hook of the received frames
+	ReceiveHook receiveHook_;
+	//! hook of the sent frames
+	TransmitHook transmitHook_;
+	//! user data of the hooks
+	void* hookUserData_;
+
+	//! if true, a SYNC is sent at the start of a period
+	bool isSync_;
+	//! SYNC frame
+	CANMsg sync_;
+	//! counter of the last SYNC, see Bus::setSyncCounterOverflow()
+	int syncCounter_;
+
+	//! receive deadline [us]
+	unsigned int receiveDeadline_us_;
+
+	//! slots of the expected frames
+	uint64_t expected_[nWords];
+	//! slots of the frames that arrived in the current period
+	uint64_t arrived_[nWords];
+
+	//! received frames indexed by the slot
+	CANMsg received_[SlotMap::maxSlots];
+	//! emitted frames indexed by the slot
+	CANMsg sent_[SlotMap::maxSlots];
+
+	//! true if all expected frames arrived in the current period
+	bool isComplete_;
+	//! number of periods with missing frames
+	std::atomic<unsigned int> nIncompleteCycles_;
+};
+
+#endif /* CYCLEPIPELINE_HPP_ */
@@ -14,7 +14,9 @@
 #include <string>
 #include "Bus.hpp"
 #include "canopen_pdos.hpp"
+#include "EMCYManager.hpp"
 class Bus;
+class BootManager;
 
 
 //! A device that is connected via CAN.
@@ -49,6 +51,14 @@ public:
 	 */
 	void setBus(Bus* bus);
 
+	/*! Sets the shared memory index of the NMT state (heartbeat, boot-up message and
+	 * node guarding response) of the node
+	 * Invoke it before the device is added to the bus. Without automatic slots and
+	 * without this index, the NMT state of the node is not received.
+	 * @param SMId	shared memory index
+	 */
+	void setNMTSMId(int SMId);
+
 	/*! Adds PDOs to the RxPDO manager
 	 *  This function is invoked by the device manager when this device is added.
 	 */
@@ -65,16 +75,26 @@ public:
 	 */
 	virtual bool initDevice() = 0;
 
+	/*! Configures the device in the state pre-operational (send SDOs to configure it)
+	 * In contrast to initDevice(), the device is neither switched to pre-operational nor started.
+	 * This function is invoked by the boot manager after receiving the bootup message.
+	 * The default implementation invokes initDevice().
+	 * @return true if successfully configured
+	 */
+	virtual bool configureDevice();
+
 	/*! Initialize the heartbeat reception.
 	 * This does NOT configure the heartbeat generation on the device. Do that manually in the initDevice function.
-	 * It only sets the expected heartbeat time
+	 * It only sets the expected heartbeat time and registers the node at the heartbeat monitor of the bus.
+	 * The node is missing if no heartbeat arrives within 1.5 times the heartbeat time.
 	 * @param heartBeatTime time in ms at which the producer sends heartbeat messages
 	 * @return true if successfully initialized
 	 */
-	bool initHeartbeat(const unsigned int heartBeatTime);
+	virtual bool initHeartbeat(const unsigned int heartBeatTime);
 
-	/*! Checks if the last heartbeat message has arrived recently and save the CAN-state of the device
-	 * @return true if within time window
+	/*! Saves the CAN-state of the device and checks if the heartbeat monitor of the bus reported the node as missing
+	 * The state is set to CANStates::missing if the node is missing.
+	 * @return true if the heartbeat is within the time window
 	 */
 	bool checkHeartbeat();
 
@@ -93,11 +113,39 @@ public:
 	const std::string& getName() const;
 	void setName(const std::string& name);
 
+	/*! Gets the CAN node ID
+	 * @return node ID
+	 */
+	int getNodeId() const;
+
 protected:
+	//! the boot manager drives the CAN state during the boot-up
+	friend class BootManager;
+
+	/*! Gets the manufacturer of the node, which selects the vendor-specific
+	 * descriptions of its emergency objects
+	 * @return vendor
+	 */
+	virtual canopen::EMCYVendor getEMCYVendor() const;
+
 	void sendSDO(SDOMsg* sdoMsg);
 	bool checkSDOResponses(bool& success);
 
 protected:
+	/*! Gets the time within which the heartbeat of the node is expected
+	 * @return consumer time [ms]
+	 */
+	unsigned int getConsumerHeartBeatTime() const;
+
+	/*! Sets the SYNC counter of the bus for a TxPDO that is sent every n-th SYNC
+	 * The start value has to be within the counter and the overflow a multiple of the
+	 * divisor, otherwise the phase of the PDO changes when the counter wraps.
+	 * @param overflow			overflow value of the SYNC counter (2-240)
+	 * @param rateDivisor		the PDO is sent every rateDivisor-th SYNC
+	 * @param syncStartValue	counter of the first SYNC the PDO is sent with
+	 * @return false if the values do not fit or the bus counts up to a different overflow
+	 */
+	bool setSyncCounterOverflow(int overflow, int rateDivisor, int syncStartValue);
 
 	//!  reference to the CAN bus the device is connected to
 	Bus* bus_;
@@ -106,8 +154,13 @@ protected:
 
 	std::string name_;
 
+	//! number of SDOs that sdos_ holds without allocating
+	static const int maxPendingSDOs = 64;
+
 	//! List of SDO messages
 	std::vector<SDOMsgPtr> sdos_;
+	//! true if an SDO of sdos_ timed out and was released before checkSDOResponses()
+	bool hasFailedSDO_;
 
 	//! the can state the device is in
 	CANStates canState_;
@@ -0,0 +1,208 @@
+/*!
+ * @file 	EMCYManager.hpp
+ * @brief	Reception and decoding of emergency objects
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef EMCYMANAGER_HPP_
+#define EMCYMANAGER_HPP_
+
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "libcanplusplus/CANMsg.hpp"
+#include "libcanplusplus/SPSCQueue.hpp"
+
+namespace canopen {
+
+//! Manufacturer of a node, selects the vendor-specific part of the EMCY code table
+enum class EMCYVendor : uint8_t {
+	generic = 0,
+	maxon = 1,
+	elmo = 2
+};
+
+//! Entry of the EMCY code table
+struct EMCYCode {
+	//! emergency error code
+	uint16_t code;
+	//! vendor the code belongs to, generic for CiA 301/402 codes
+	EMCYVendor vendor;
+	//! human readable description
+	const char* description;
+};
+
+/*! Looks up the description of an emergency error code
+ * Vendor-specific codes are preferred over the CiA 301/402 codes. If there is no
+ * exact match, the description of the error class (e.g. 0x2300) is returned.
+ * @param code		emergency error code
+ * @param vendor	manufacturer of the node
+ * @return description, never NULL
+ */
+const char* getEMCYDescription(uint16_t code, EMCYVendor vendor = EMCYVendor::generic);
+
+} // namespace canopen
+
+//! Decoded emergency object
+struct EMCYEvent {
+	//! CAN node ID of the sender
+	uint8_t nodeId;
+	//! error register (object 0x1001)
+	uint8_t errorRegister;
+	//! emergency error code
+	uint16_t code;
+	//! manufacturer-specific error field
+	uint8_t data[5];
+	//! description of the error code (string literal of the code table)
+	const char* description;
+	//! reception time (steady clock) [ns]
+	int64_t time_ns;
+
+	//! true if the object signals that the errors of the node were reset
+	bool isErrorReset() const { return code == 0x0000; }
+};
+
+//! Emergency object (EMCY) manager
+/*! Receives the emergency objects (COB-ID 0x80+nodeId) of the registered nodes.
+ *
+ * receiveMsg() is called from the thread that receives the CAN messages. It decodes
+ * the message, invokes the real-time fault handler and pushes the event into a lock-free
+ * queue. It neither allocates memory nor prints anything.
+ *
+ * dispatch() is called from a non real-time thread (e.g. the main loop). It pops the
+ * events and invokes the callbacks, which may log or publish the errors.
+ *
+ * @ingroup robotCAN
+ */
+class EMCYManager {
+public:
+	//! maximum number of queued events
+	static const std::size_t queueSize = 64;
+
+	/*! Handler that is invoked in the receive thread for every error (not for error resets)
+	 * Must be real-time safe: no locks, no allocations, no I/O.
+	 */
+	typedef void (*FaultHandler)(const EMCYEvent& event, void* userData);
+
+	//! Callback that is invoked by dispatch()
+	typedef std::function<void(const EMCYEvent& event)> Callback;
+
+	//! Constructor
+	EMCYManager();
+
+	//! Destructor
+	virtual ~EMCYManager();
+
+	/*! Registers a node whose emergency objects are handled
+	 * @param nodeId	CAN node ID (1-127)
+	 * @param vendor	manufacturer of the node
+	 */
+	void registerNode(int nodeId, canopen::EMCYVendor vendor = canopen::EMCYVendor::generic);
+
+	/*! Unregisters a node
+	 * @param nodeId	CAN node ID (1-127)
+	 */
+	void unregisterNode(int nodeId);
+
+	/*! Checks if a node is registered
+	 * @param nodeId	CAN node ID (1-127)
+	 * @return true if registered
+	 */
+	bool isRegistered(int nodeId) const;
+
+	/*! Sets the handler that is invoked in the receive thread
+	 * @param handler	handler, NULL to disable
+	 * @param userData	pointer that is passed to the handler
+	 */
+	void setFaultHandler(FaultHandler handler, void* userData = NULL);
+
+	/*! Adds a callback that is invoked by dispatch()
+	 * Add all callbacks before the bus is started.
+	 * @param callback	callback
+	 * @param nodeId	CAN node ID, 0 for all nodes
+	 */
+	void addCallback(const Callback& callback, int nodeId = 0);
+
+	/*! Processes a received CAN message (receive thread)
+	 * @param msg	received CAN message
+	 * @return true if the message is an emergency object of a registered node
+	 */
+	bool receiveMsg(const CANMsg* msg);
+
+	/*! Pops an event from the queue (consumer thread)
+	 * @param[out] event	event
+	 * @return false if there is no event
+	 */
+	bool popEvent(EMCYEvent& event);
+
+	/*! Pops all events and invokes the callbacks (consumer thread)
+	 * @return number of dispatched events
+	 */
+	int dispatch();
+
+	/*! Checks if the last emergency object of a node signals an error
+	 * @param nodeId	CAN node ID (1-127)
+	 * @return true if the node has an active error
+	 */
+	bool hasActiveError(int nodeId) const;
+
+	/*! Gets the error code of the last emergency object of a node
+	 * @param nodeId	CAN node ID (1-127)
+	 * @return error code, 0 if there is no active error
+	 */
+	uint16_t getActiveErrorCode(int nodeId) const;
+
+	/*! Gets the number of events that were dropped because the queue was full
+	 * @return number of dropped events
+	 */
+	unsigned int getNumberOfDroppedEvents() const;
+
+	/*! Sets the index of the bus whose metrics are counted
+	 * @param iBus	index of the bus, -1 to disable the counting
+	 */
+	void setBusIndex(int iBus);
+
+private:
+	//! maximum number of nodes
+	static const int maxNodes = 128;
+
+	//! registration of a node
+	struct Node {
+		std::atomic<bool> isRegistered;
+		canopen::EMCYVendor vendor;
+		std::atomic<uint16_t> activeCode;
+	};
+
+	//! callback of a node
+	struct NodeCallback {
+		int nodeId;
+		Callback callback;
+	};
+
+	//! registered nodes indexed by node ID
+	Node nodes_[maxNodes];
+
+	//! handler invoked in the receive thread
+	std::atomic<FaultHandler> faultHandler_;
+	//! user data of the fault handler
+	std::atomic<void*> faultHandlerUserData_;
+
+	//! callbacks invoked by dispatch()
+	std::vector<NodeCallback> callbacks_;
+
+	//! events that are not yet dispatched
+	SPSCQueue<EMCYEvent, queueSize> queue_;
+
+	//! number of dropped events
+	std::atomic<unsigned int> nDroppedEvents_;
+
+	//! index of the bus in the metrics, -1 if not counted
+	int iBus_;
+};
+
+#endif /* EMCYMANAGER_HPP_ */
@@ -0,0 +1,169 @@
+/*!
+ * @file 	HeartbeatMonitor.hpp
+ * @brief	Heartbeat consumer of a bus based on a hierarchical timer wheel
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef HEARTBEATMONITOR_HPP_
+#define HEARTBEATMONITOR_HPP_
+
+#include <stdint.h>
+#include <functional>
+
+//! Heartbeat consumer of all nodes of a bus
+/*! Every supervised node has a deadline in a hierarchical timer wheel with two levels.
+ * The first level has one slot per tick, the second level one slot per revolution
+ * of the first level. A received heartbeat moves the node to a new slot in O(1),
+ * tick() reads the clock once per cycle and only visits the slots of the elapsed ticks.
+ *
+ * If a node does not send a heartbeat within its consumer time, it is marked as
+ * missing and the callback is invoked. The next heartbeat of the node clears the flag.
+ *
+ * The monitor is not thread-safe. heartbeatReceived() and tick() need to be called from
+ * the same thread, typically the main loop that also decodes the TxPDOs.
+ *
+ * @ingroup robotCAN, bus
+ */
+class HeartbeatMonitor {
+public:
+	//! Callback that is invoked if a node goes missing or comes back
+	typedef std::function<void(int nodeId, bool isMissing)> Callback;
+
+	/*! Constructor
+	 * @param tickPeriod_us	resolution of the timer wheel [us]
+	 */
+	HeartbeatMonitor(unsigned int tickPeriod_us = 1000);
+
+	//! Destructor
+	virtual ~HeartbeatMonitor();
+
+	/*! Adds a node to the supervision
+	 * The supervision starts with the first heartbeat of the node.
+	 * @param nodeId			CAN node ID (1-127)
+	 * @param consumerTime_ms	maximum time between two heartbeats [ms], 0 disables the supervision
+	 */
+	void addNode(int nodeId, unsigned int consumerTime_ms);
+
+	/*! Removes a node from the supervision
+	 * @param nodeId	CAN node ID (1-127)
+	 */
+	void removeNode(int nodeId);
+
+	/*! Sets the callback that is invoked by tick() and heartbeatReceived()
+	 * @param callback	callback
+	 */
+	void setCallback(const Callback& callback);
+
+	/*! Restarts the deadline of a node
+	 * Is invoked by the TxPDO of the NMT state (heartbeat or node guarding response).
+	 * The time of the last tick is used as reception time, hence the clock is not read.
+	 * @param nodeId	CAN node ID (1-127)
+	 */
+	void heartbeatReceived(int nodeId);
+
+	/*! Stops the supervision of a node until its next heartbeat
+	 * Is invoked by the TxPDO of the NMT state when the node sends its boot-up message,
+	 * because the node needs to be configured again before it produces heartbeats.
+	 * @param nodeId	CAN node ID (1-127)
+	 */
+	void bootupReceived(int nodeId);
+
+	/*! Advances the timer wheel to the current time and marks the nodes whose deadline has passed
+	 * Call this function once per cycle, after the heartbeats of the cycle were passed
+	 * to heartbeatReceived().
+	 */
+	void tick();
+
+	/*! Advances the timer wheel to the given time
+	 * @param time_us	monotonic time [us]
+	 */
+	void tick(int64_t time_us);
+
+	/*! Checks if a node is missing
+	 * @param nodeId	CAN node ID (1-127)
+	 * @return true if the heartbeat of the node has not arrived in time
+	 */
+	bool isMissing(int nodeId) const;
+
+	/*! Checks if a node is supervised
+	 * @param nodeId	CAN node ID (1-127)
+	 * @return true if the node was added and has sent its first heartbeat
+	 */
+	bool isSupervised(int nodeId) const;
+
+	/*! Sets the index of the bus whose metrics are counted
+	 * @param iBus	index of the bus, -1 to disable the counting
+	 */
+	void setBusIndex(int iBus);
+
+private:
+	//! maximum number of nodes
+	static const int maxNodes = 128;
+	//! number of bits of the slot index of the first level
+	static const int level0Bits = 8;
+	//! number of bits of the slot index of the second level
+	static const int level1Bits = 6;
+	//! number of slots of the first level
+	static const int level0Size = 1 << level0Bits;
+	//! number of slots of the second level
+	static const int level1Size = 1 << level1Bits;
+	//! number of slots of both levels
+	static const int nSlots = level0Size + level1Size;
+	//! marks the end of a list
+	static const int none = -1;
+
+	//! supervision of a node
+	struct Node {
+		//! consumer time [ticks], 0 if not supervised
+		uint32_t timeout;
+		//! tick at which the node is missing
+		uint64_t deadline;
+		//! slot the node is linked into, none if not scheduled
+		int slot;
+		//! previous node in the slot
+		int prev;
+		//! next node in the slot
+		int next;
+		//! true if the heartbeat has not arrived in time
+		bool isMissing;
+	};
+
+	//! Advances the timer wheel by one tick
+	void advance();
+
+	//! Links a node into the slot of its deadline
+	void schedule(int nodeId);
+
+	//! Unlinks a node from its slot
+	void unschedule(int nodeId);
+
+	//! Moves the nodes of a slot of the second level to the first level
+	void cascade(int slot);
+
+	//! Processes the nodes of a slot of the first level
+	void expire(int slot);
+
+	//! resolution [us]
+	int64_t tickPeriod_us_;
+	//! tick that was processed last
+	uint64_t currentTick_;
+	//! time of the first tick [us]
+	int64_t startTime_us_;
+	//! true if the time of the first tick is set
+	bool isStarted_;
+	//! index of the bus in the metrics, -1 if not counted
+	int iBus_;
+
+	//! supervision of the nodes indexed by node ID
+	Node nodes_[maxNodes];
+	//! first node of each slot
+	int slots_[nSlots];
+
+	//! callback
+	Callback callback_;
+};
+
+#endif /* HEARTBEATMONITOR_HPP_ */
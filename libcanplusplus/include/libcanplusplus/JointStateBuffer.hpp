@@ -0,0 +1,137 @@
+/*!
+ * @file 	JointStateBuffer.hpp
+ * @brief	Structure-of-arrays buffer of the joint states of a bus
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef JOINTSTATEBUFFER_HPP_
+#define JOINTSTATEBUFFER_HPP_
+
+#include <stdint.h>
+
+//! Joint states of all devices of a bus stored as structure of arrays
+/*! The TxPDOs of the devices write the raw values (ticks, velocity in device
+ * units and current in device units) into the buffer when they are decoded.
+ * update() converts all joints at once to SI units by multiplying with
+ * precomputed reciprocal scale factors. The arrays are padded to a multiple
+ * of the vector width, hence the conversion is a single loop without a tail.
+ *
+ * Typical usage in the main loop:
+ * 	bus->getJointStateBuffer()->update();
+ * 	const double* positions = bus->getJointStateBuffer()->getPositions();
+ *
+ * @ingroup robotCAN, bus
+ */
+class JointStateBuffer {
+public:
+	//! maximum number of joints per bus
+	static const int maxJoints = 128;
+
+	//! Constructor
+	JointStateBuffer();
+
+	//! Destructor
+	virtual ~JointStateBuffer();
+
+	/*! Adds a joint to the buffer
+	 * The scale factors convert the raw values to SI units, e.g.
+	 * positionScale = 1.0/(gearratio_motor*RAD_TO_TICKS).
+	 * @param positionScale	factor from raw position to [rad]
+	 * @param velocityScale	factor from raw velocity to [rad/s]
+	 * @param currentScale	factor from raw current to [A]
+	 * @return index of the joint, -1 if the buffer is full
+	 */
+	int addJoint(double positionScale, double velocityScale, double currentScale);
+
+	/*! Changes the scale factors of a joint
+	 * @param joint			index of the joint
+	 * @param positionScale	factor from raw position to [rad]
+	 * @param velocityScale	factor from raw velocity to [rad/s]
+	 * @param currentScale	factor from raw current to [A]
+	 */
+	void setScale(int joint, double positionScale, double velocityScale, double currentScale);
+
+	/*! Gets the number of joints
+	 * @return number of joints
+	 */
+	int getSize() const;
+
+	/*! Stores the raw position and velocity of a joint
+	 * Is invoked by the TxPDOs when a message is decoded.
+	 * @param joint		index of the joint
+	 * @param position	position [ticks]
+	 * @param velocity	velocity [device units]
+	 */
+	inline void setRawPositionVelocity(int joint, int32_t position, int32_t velocity)
+	{
+		rawPosition_[joint] = position;
+		rawVelocity_[joint] = velocity;
+	}
+
+	/*! Stores the raw current of a joint
+	 * Is invoked by the TxPDOs when a message is decoded.
+	 * @param joint		index of the joint
+	 * @param current	current [device units]
+	 */
+	inline void setRawCurrent(int joint, int32_t current)
+	{
+		rawCurrent_[joint] = current;
+	}
+
+	//! Converts the raw values of all joints to SI units
+	void update();
+
+	/*! Gets the joint positions of all joints
+	 * @return array of getSize() positions [rad]
+	 */
+	const double* getPositions() const;
+
+	/*! Gets the joint velocities of all joints
+	 * @return array of getSize() velocities [rad/s]
+	 */
+	const double* getVelocities() const;
+
+	/*! Gets the currents of all joints
+	 * @return array of getSize() currents [A]
+	 */
+	const double* getCurrents() const;
+
+	/*! Gets the raw positions of all joints
+	 * @return array of getSize() positions [ticks]
+	 */
+	const int32_t* getRawPositions() const;
+
+	/*! Gets the raw velocities of all joints
+	 * @return array of getSize() velocities [device units]
+	 */
+	const int32_t* getRawVelocities() const;
+
+	/*! Gets the raw currents of all joints
+	 * @return array of getSize() currents [device units]
+	 */
+	const int32_t* getRawCurrents() const;
+
+private:
+	//! number of joints
+	int nJoints_;
+
+	//! number of joints rounded up to a multiple of the vector width
+	int nPadded_;
+
+	alignas(16) int32_t rawPosition_[maxJoints];
+	alignas(16) int32_t rawVelocity_[maxJoints];
+	alignas(16) int32_t rawCurrent_[maxJoints];
+
+	alignas(16) double positionScale_[maxJoints];
+	alignas(16) double velocityScale_[maxJoints];
+	alignas(16) double currentScale_[maxJoints];
+
+	alignas(16) double position_[maxJoints];
+	alignas(16) double velocity_[maxJoints];
+	alignas(16) double current_[maxJoints];
+};
+
+#endif /* JOINTSTATEBUFFER_HPP_ */
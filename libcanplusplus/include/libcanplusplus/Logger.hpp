@@ -0,0 +1,301 @@
+/*!
+ * @file 	Logger.hpp
+ * @brief	Asynchronous logging of the diagnostics of the library
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef LOGGER_HPP_
+#define LOGGER_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <type_traits>
+
+//! Severity of a log message
+enum class LogLevels : uint8_t {
+	debug = 0,
+	info = 1,
+	warn = 2,
+	error = 3
+};
+
+//! Unformatted log message
+/*! Stores the printf format and the arguments in binary form. Strings are copied into
+ * the record, hence it can be formatted by another thread. The format itself must be
+ * a string literal.
+ *
+ * @ingroup robotCAN
+ */
+class LogRecord {
+public:
+	//! maximum number of arguments
+	static const int maxArguments = 24;
+	//! storage of the string arguments [bytes]
+	static const int textSize = 96;
+
+	/*! Initializes the record
+	 * @param level		severity
+	 * @param format	printf format (string literal)
+	 */
+	void reset(LogLevels level, const char* format);
+
+	//! Appends an integer argument of the given size [bytes]
+	void addInteger(int64_t value, bool isSigned, int size);
+
+	//! Appends a floating-point argument
+	void addDouble(double value);
+
+	//! Appends a string argument, the string is copied and may be truncated
+	void addString(const char* value);
+
+	//! Appends a pointer argument
+	void addPointer(const void* value);
+
+	/*! Formats the message like snprintf()
+	 * @param buffer	output
+	 * @param size		size of the output [bytes]
+	 * @return length of the message (without terminating zero)
+	 */
+	int format(char* buffer, size_t size) const;
+
+	/*! Gets the severity
+	 * @return level
+	 */
+	LogLevels getLevel() const { return level_; }
+
+	/*! Gets the time the record was created
+	 * @return time since epoch [ns]
+	 */
+	int64_t getTime_ns() const { return time_ns_; }
+
+private:
+	//! types of the arguments
+	enum class Types : uint8_t {
+		integer = 0,
+		unsignedInteger = 1,
+		floatingPoint = 2,
+		string = 3,
+		pointer = 4
+	};
+
+	//! binary argument
+	struct Argument {
+		union {
+			int64_t integer;
+			double floatingPoint;
+			const void* pointer;
+			//! offset of the string in text_
+			uint16_t textOffset;
+		};
+		Types type;
+		//! size of the integer [bytes]
+		uint8_t size;
+	};
+
+	//! severity
+	LogLevels level_;
+	//! printf format
+	const char* format_;
+	//! time of the record since epoch [ns]
+	int64_t time_ns_;
+	//! number of arguments
+	int nArguments_;
+	//! arguments
+	Argument arguments_[maxArguments];
+	//! used bytes of text_
+	int textLength_;
+	//! copied strings
+	char text_[textSize];
+};
+
+//! Output of the formatted log messages
+/*! write() is invoked by the background thread of the Logger, or by the logging
+ * thread if the background thread is not running.
+ *
+ * @ingroup robotCAN
+ */
+class LogSink {
+public:
+	virtual ~LogSink() {}
+
+	/*! Writes a formatted message
+	 * @param level		severity
+	 * @param time_ns	time the message was logged, since epoch [ns]
+	 * @param message	message without trailing newline
+	 */
+	virtual void write(LogLevels level, int64_t time_ns, const char* message) = 0;
+};
+
+//! Writes the messages to stderr, errors and warnings are coloured on a terminal
+/*!
+ * @ingroup robotCAN
+ */
+class StderrLogSink : public LogSink {
+public:
+	StderrLogSink();
+	virtual ~StderrLogSink();
+	virtual void write(LogLevels level, int64_t time_ns, const char* message);
+private:
+	//! if true, ANSI colours are used
+	bool isTerminal_;
+};
+
+//! Appends the messages with time stamp to a file
+/*!
+ * @ingroup robotCAN
+ */
+class FileLogSink : public LogSink {
+public:
+	/*! Constructor, opens the file
+	 * @param path	path of the file
+	 */
+	FileLogSink(const char* path);
+
+	//! Destructor, closes the file
+	virtual ~FileLogSink();
+
+	/*! Checks if the file was opened
+	 * @return true if open
+	 */
+	bool isOpen() const;
+
+	virtual void write(LogLevels level, int64_t time_ns, const char* message);
+private:
+	FILE* file_;
+};
+
+//! Logging of the diagnostics of the library
+/*! log() stores the format and the arguments in a LogRecord and pushes it into a
+ * lock-free queue. It neither allocates memory, formats nor blocks, and can be
+ * invoked from the real-time cycle. A background thread (see start()) pops the
+ * records, formats them and writes them to the sink. If the queue is full, the
+ * record is dropped and counted.
+ *
+ * As long as the background thread is not running, log() formats the message and
+ * writes it to the sink immediately. The default sink writes to stderr, ROS users
+ * can install a RosLogSink (RosLogSink.hpp).
+ *
+ * 	Logger::setSink(&sink);
+ * 	Logger::start();
+ * 	...
+ * 	Logger::log(LogLevels::error, "Node %d: error code %04X", nodeId, code);
+ *
+ * @ingroup robotCAN
+ */
+class Logger {
+public:
+	//! maximum number of queued records
+	static const size_t queueSize = 256;
+
+	//! length of a formatted message, longer messages are truncated
+	static const size_t maxMessageLength = 512;
+
+	/*! Logs a message
+	 * @param level		severity, the message is ignored if it is below the level of the logger
+	 * @param format	printf format (string literal)
+	 * @param args		arguments: integers, floating-point numbers, strings and pointers
+	 */
+	template <typename... Args>
+	static void log(LogLevels level, const char* format, Args... args)
+	{
+		if (level < getLevel()) {
+			return;
+		}
+		LogRecord record;
+		record.reset(level, format);
+		addArguments(record, args...);
+		submit(record);
+	}
+
+	/*! Sets the output of the messages
+	 * @param sink	sink (not owned, must outlive the logger), NULL for stderr
+	 */
+	static void setSink(LogSink* sink);
+
+	/*! Sets the minimum severity of the logged messages
+	 * @param level	level
+	 */
+	static void setLevel(LogLevels level);
+
+	/*! Gets the minimum severity of the logged messages
+	 * @return level
+	 */
+	static LogLevels getLevel();
+
+	/*! Starts the background thread that formats the messages
+	 * Should be invoked at initialization, it allocates the thread.
+	 * @param period_ms	period in which the queue is emptied [ms]
+	 */
+	static void start(unsigned int period_ms = 10);
+
+	//! Stops the background thread and writes the queued messages
+	static void stop();
+
+	/*! Checks if the background thread is running
+	 * @return true if running
+	 */
+	static bool isRunning();
+
+	//! Formats and writes the queued messages in the calling thread
+	static void flush();
+
+	/*! Gets the number of messages that were dropped because the queue was full
+	 * @return number of dropped messages
+	 */
+	static unsigned int getNumberOfDroppedRecords();
+
+private:
+	//! Queues the record or writes it if the background thread is not running
+	static void submit(const LogRecord& record);
+
+	static void addArguments(LogRecord&) {}
+
+	template <typename T, typename... Args>
+	static void addArguments(LogRecord& record, T value, Args... args)
+	{
+		addArgument(record, value);
+		addArguments(record, args...);
+	}
+
+	template <typename T>
+	static typename std::enable_if<std::is_integral<T>::value>::type
+	addArgument(LogRecord& record, T value)
+	{
+		record.addInteger((int64_t)value, std::is_signed<T>::value, sizeof(T));
+	}
+
+	template <typename T>
+	static typename std::enable_if<std::is_enum<T>::value>::type
+	addArgument(LogRecord& record, T value)
+	{
+		record.addInteger((int64_t)value, true, sizeof(int));
+	}
+
+	template <typename T>
+	static typename std::enable_if<std::is_floating_point<T>::value>::type
+	addArgument(LogRecord& record, T value)
+	{
+		record.addDouble(value);
+	}
+
+	static void addArgument(LogRecord& record, const char* value)
+	{
+		record.addString(value);
+	}
+
+	static void addArgument(LogRecord& record, char* value)
+	{
+		record.addString(value);
+	}
+
+	static void addArgument(LogRecord& record, const void* value)
+	{
+		record.addPointer(value);
+	}
+};
+
+#endif /* LOGGER_HPP_ */
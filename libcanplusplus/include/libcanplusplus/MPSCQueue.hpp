@@ -0,0 +1,116 @@
+/*!
+ * @file 	MPSCQueue.hpp
+ * @brief	Lock-free multi-producer single-consumer queue
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef MPSCQUEUE_HPP_
+#define MPSCQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+//! Bounded lock-free queue for several producer threads and one consumer thread
+/*! Each element has a sequence number that tells if it is free, written or read.
+ * A producer reserves an element by incrementing the tail with compare-and-swap,
+ * hence producers never block each other. As in SPSCQueue, the storage is part
+ * of the object and push() fails if the queue is full.
+ *
+ * @tparam T	type of the elements (copy assignable)
+ * @tparam Size	capacity of the queue, must be a power of two
+ * @ingroup robotCAN
+ */
+template <typename T, std::size_t Size>
+class MPSCQueue {
+	static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Size must be a power of two");
+public:
+	//! Constructor
+	MPSCQueue():head_(0),tail_(0)
+	{
+		for (std::size_t i=0; i<Size; i++) {
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	/*! Appends an element (any thread)
+	 * @param item	element to append
+	 * @return false if the queue is full
+	 */
+	bool push(const T& item)
+	{
+		std::size_t tail = tail_.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;) {
+			cell = &cells_[tail & (Size - 1)];
+			const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const intptr_t difference = (intptr_t)sequence - (intptr_t)tail;
+			if (difference == 0) {
+				/* the element is free, reserve it */
+				if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (difference < 0) {
+				/* the element was not yet read */
+				return false;
+			} else {
+				/* another producer reserved the element */
+				tail = tail_.load(std::memory_order_relaxed);
+			}
+		}
+		cell->item = item;
+		cell->sequence.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*! Removes the oldest element (consumer thread only)
+	 * @param[out] item	removed element
+	 * @return false if the queue is empty or the oldest element is still being written
+	 */
+	bool pop(T& item)
+	{
+		const std::size_t head = head_.load(std::memory_order_relaxed);
+		Cell& cell = cells_[head & (Size - 1)];
+		if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+			return false;
+		}
+		item = cell.item;
+		cell.sequence.store(head + Size, std::memory_order_release);
+		head_.store(head + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/*! Gets the capacity of the queue
+	 * @return capacity
+	 */
+	static std::size_t getCapacity()
+	{
+		return Size;
+	}
+
+private:
+	//! size of a cache line
+	static const std::size_t cacheLineSize = 64;
+
+	//! element with its sequence number
+	struct Cell {
+		std::atomic<std::size_t> sequence;
+		T item;
+	};
+
+	//! index of the next element to pop, only written by the consumer
+	std::atomic<std::size_t> head_;
+	//! keeps head_ and tail_ on different cache lines
+	char padding_[cacheLineSize - sizeof(std::atomic<std::size_t>)];
+	//! index of the next free element, incremented by the producers
+	std::atomic<std::size_t> tail_;
+	//! keeps tail_ and the buffer on different cache lines
+	char padding2_[cacheLineSize - sizeof(std::atomic<std::size_t>)];
+	//! ring buffer
+	Cell cells_[Size];
+};
+
+#endif /* MPSCQUEUE_HPP_ */
@@ -0,0 +1,149 @@
+/*!
+ * @file 	MasterClient.hpp
+ * @brief	Client side of the shared memory interface of the master
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef MASTERCLIENT_HPP_
+#define MASTERCLIENT_HPP_
+
+#include <stdint.h>
+
+#include "libcanplusplus/MasterServer.hpp"
+
+//! Accesses the buses of a master daemon through its shared memory segment
+/*! A tool attaches to the segment of a process that runs a MasterServer, e.g. the
+ * daemon canopenMaster, and works against the live buses without owning a channel:
+ * 	MasterClient client;
+ * 	client.attach(MasterServer::defaultName, "teleop", 10);
+ * 	client.readFrames(0, COBIds, nFrames, frames);	// frames of the last cycle
+ * 	client.submitSetpoint(0, frame);				// sent in every cycle during the lease
+ * 	const uint32_t id = client.queueSDORead(0, nodeId, 0x6041, 0x00);
+ * 	...
+ * 	MasterSDOResult result;
+ * 	while (client.getSDOResult(0, &result)) { ... }
+ *
+ * The setpoints of a COB-ID are sent only for one client at a time, see MasterServer.
+ * A client keeps its COB-IDs by submitting setpoints at least once per lease.
+ *
+ * A client is used by one thread, none of the functions allocates memory or blocks,
+ * hence a client may run in a real-time thread after attach().
+ *
+ * @ingroup robotCAN
+ */
+class MasterClient {
+public:
+	//! Constructor
+	MasterClient();
+
+	//! Destructor, detaches
+	virtual ~MasterClient();
+
+	/*! Maps the segment of a daemon and takes a free client slot
+	 * @param name		name of the segment
+	 * @param clientName	name of the client, for diagnostics
+	 * @param priority	priority of the setpoints, higher priorities take over COB-IDs
+	 * @return false if the segment does not exist, has a different layout or all slots are used
+	 */
+	bool attach(const char* name = MasterServer::defaultName, const char* clientName = "",
+			int priority = 0);
+
+	//! Frees the client slot and unmaps the segment, the COB-IDs of the client are free again
+	void detach();
+
+	/*! Checks if the client is attached to a running daemon
+	 * @return true if attached and the daemon did not remove the segment
+	 */
+	bool isAttached() const;
+
+	/*! Checks if the daemon runs a cycle on a bus
+	 * @param iBus	index of the bus
+	 * @return true if the bus is active
+	 */
+	bool isBusActive(int iBus) const;
+
+	/*! Gets the period of the cycle of a bus
+	 * @param iBus	index of the bus
+	 * @return period [us], 0 if the bus is not active
+	 */
+	unsigned int getPeriod_us(int iBus) const;
+
+	/*! Copies frames that were received in the same cycle (state snapshot)
+	 * A frame whose flag is 0 was never received, the sequence of a frame is the
+	 * cycle in which it was received.
+	 * @param iBus		index of the bus
+	 * @param COBIds	COB-IDs of the frames (11 bits)
+	 * @param nFrames	number of frames
+	 * @param[out] frames	frames
+	 * @param[out] cycle	number of the cycle of the snapshot, may be NULL
+	 * @return false if the bus is not active or the daemon wrote the frames during all attempts
+	 */
+	bool readFrames(int iBus, const int* COBIds, int nFrames, CANMsg* frames, uint32_t* cycle = NULL) const;
+
+	/*! Copies the last received frame of a COB-ID
+	 * @param iBus		index of the bus
+	 * @param COBId		COB-ID (11 bits)
+	 * @param[out] frame	frame
+	 * @return false if the bus is not active
+	 */
+	bool readFrame(int iBus, int COBId, CANMsg* frame) const;
+
+	/*! Submits a frame that is sent in every cycle until the lease expires
+	 * @param iBus	index of the bus
+	 * @param frame	frame with a COB-ID of 11 bits
+	 * @return false if not attached or the ring is full
+	 */
+	bool submitSetpoint(int iBus, const CANMsg& frame);
+
+	/*! Gets the number of setpoints that the daemon rejected, e.g. because another
+	 * client owns the COB-ID
+	 * @param iBus	index of the bus
+	 * @return number of rejected setpoints
+	 */
+	unsigned int getNumberOfRejectedSetpoints(int iBus) const;
+
+	/*! Queues an upload (read) of an object of a node
+	 * @param iBus		index of the bus
+	 * @param nodeId	ID of the CAN node
+	 * @param index		index of the object
+	 * @param subIndex	sub-index of the object
+	 * @return identifier of the request, 0 if not attached or the ring is full
+	 */
+	uint32_t queueSDORead(int iBus, int nodeId, int index, int subIndex);
+
+	/*! Queues an expedited download (write) of an object of a node
+	 * @param iBus		index of the bus
+	 * @param nodeId	ID of the CAN node
+	 * @param index		index of the object
+	 * @param subIndex	sub-index of the object
+	 * @param length	number of data bytes (1, 2 or 4)
+	 * @param value		value
+	 * @return identifier of the request, 0 if not attached or the ring is full
+	 */
+	uint32_t queueSDOWrite(int iBus, int nodeId, int index, int subIndex, int length, int32_t value);
+
+	/*! Takes the next result of an SDO request
+	 * @param iBus	index of the bus
+	 * @param[out] result	result
+	 * @return false if there is none
+	 */
+	bool getSDOResult(int iBus, MasterSDOResult* result);
+
+private:
+	//! Queues an SDO request
+	uint32_t queueSDO(int iBus, MasterSDORequest& request);
+
+	//! mapped segment, NULL if not attached
+	MasterSegment* segment_;
+	//! client slot, NULL if not attached
+	MasterClientSegment* client_;
+	//! generation of the client slot
+	uint32_t generation_;
+	//! identifier of the last SDO request
+	uint32_t lastId_;
+};
+
+#endif /* MASTERCLIENT_HPP_ */
@@ -0,0 +1,164 @@
+/*!
+ * @file 	MasterSegment.hpp
+ * @brief	Layout of the shared memory segment of the master daemon
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef MASTERSEGMENT_HPP_
+#define MASTERSEGMENT_HPP_
+
+#include <stdint.h>
+#include <atomic>
+
+#include "libcanplusplus/CANMsg.hpp"
+#include "libcanplusplus/SPSCQueue.hpp"
+
+//! Setpoint frame of a client, see MasterClient::submitSetpoint()
+struct MasterSetpoint {
+	//! generation of the client that submitted the frame
+	uint32_t generation;
+	//! frame with a COB-ID of 11 bits
+	CANMsg frame;
+};
+
+//! SDO request of a client, see MasterClient::queueSDORead()
+struct MasterSDORequest {
+	//! generation of the client that queued the request
+	uint32_t generation;
+	//! identifier of the request, chosen by the client
+	uint32_t id;
+	//! ID of the CAN node (1-127)
+	int32_t nodeId;
+	//! 1 for a download (write), 0 for an upload (read)
+	int32_t isWrite;
+	//! number of data bytes of a download (1, 2 or 4)
+	int32_t length;
+	//! index of the object
+	int32_t index;
+	//! sub-index of the object
+	int32_t subIndex;
+	//! value of a download
+	int32_t value;
+};
+
+//! Outcome of an SDO request
+enum class MasterSDOStatus : int32_t {
+	//! the node confirmed the transfer
+	completed = 0,
+	//! the node aborted the transfer, see MasterSDOResult::abortCode
+	aborted = 1,
+	//! the node did not respond
+	timeout = 2,
+	//! the daemon refused the request, e.g. an invalid node ID
+	rejected = 3
+};
+
+//! Result of an SDO request, see MasterClient::getSDOResult()
+struct MasterSDOResult {
+	//! generation of the client that queued the request
+	uint32_t generation;
+	//! identifier of the request
+	uint32_t id;
+	//! outcome
+	MasterSDOStatus status;
+	//! abort code if aborted
+	uint32_t abortCode;
+	//! value of an upload
+	int32_t value;
+};
+
+//! Frames of a bus that are published once per cycle
+/*! The daemon increments the sequence before and after it writes the frames of a
+ * cycle. A reader copies the frames it needs and retries if the sequence was odd or
+ * changed meanwhile (seqlock), hence the daemon never waits for a client.
+ */
+struct MasterBusSegment {
+	//! number of frames per bus, indexed by the COB-ID of 11 bits
+	static const int nCOBIds = 0x800;
+
+	//! odd while the daemon writes the frames
+	std::atomic<uint32_t> sequence;
+	//! 1 if the daemon runs a cycle on the bus
+	std::atomic<uint32_t> isActive;
+	//! number of the last published cycle
+	std::atomic<uint32_t> cycle;
+	//! period of the cycle [us]
+	uint32_t period_us;
+	//! last received frame of each COB-ID, flag is 0 if none was received,
+	//! sequence is the cycle in which it was received
+	CANMsg frames[nCOBIds];
+};
+
+//! Rings and counters of a client on a bus
+struct MasterClientBus {
+	//! capacity of the setpoint ring
+	static const int nSetpoints = 64;
+	//! capacity of the SDO rings
+	static const int nSDOs = 16;
+
+	//! frames from the client to the daemon
+	SPSCQueue<MasterSetpoint, nSetpoints> setpoints;
+	//! SDO requests from the client to the daemon
+	SPSCQueue<MasterSDORequest, nSDOs> sdoRequests;
+	//! SDO results from the daemon to the client
+	SPSCQueue<MasterSDOResult, nSDOs> sdoResults;
+	//! setpoints that were refused because another client owns the COB-ID
+	std::atomic<uint32_t> nRejectedSetpoints;
+};
+
+//! Slot of a client process
+/*! A client claims a free slot by writing its process ID with compare-and-swap and
+ * increments the generation. The entries of the rings carry the generation, hence
+ * the entries that a former client of the slot left behind are discarded.
+ */
+struct MasterClientSegment {
+	//! maximum number of buses
+	static const int maxBuses = 8;
+	//! maximum length of the name
+	static const int maxNameLength = 32;
+
+	//! process ID of the client, 0 if the slot is free
+	std::atomic<int32_t> pid;
+	//! incremented whenever a client takes the slot
+	std::atomic<uint32_t> generation;
+	//! priority of the setpoints, a higher priority takes over the COB-IDs of a lower one
+	std::atomic<int32_t> priority;
+	//! name of the client, for diagnostics
+	char name[maxNameLength];
+	//! rings per bus
+	MasterClientBus buses[maxBuses];
+};
+
+//! Layout of the shared memory segment of the master daemon
+/*! As for MetricsSegment, a client checks magic, version and size before it uses the
+ * segment. The daemon writes the magic number last.
+ */
+struct MasterSegment {
+	//! identifies the segment
+	static const uint32_t magicNumber = 0x4D4D414E;
+	//! version of the layout
+	static const uint32_t layoutVersion = 1;
+	//! maximum number of buses
+	static const int maxBuses = MasterClientSegment::maxBuses;
+	//! maximum number of clients
+	static const int maxClients = 16;
+
+	std::atomic<uint32_t> magic;
+	uint32_t version;
+	//! size of the segment [bytes]
+	uint32_t size;
+	uint32_t nBuses;
+	uint32_t nClients;
+	//! process of the daemon
+	int32_t pid;
+	//! time the segment was created, since epoch [ns]
+	int64_t startTime_ns;
+
+	MasterBusSegment buses[maxBuses];
+	MasterClientSegment clients[maxClients];
+};
+
+#endif /* MASTERSEGMENT_HPP_ */
@@ -0,0 +1,201 @@
+/*!
+ * @file 	MasterServer.hpp
+ * @brief	Daemon side of the shared memory interface of the master
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef MASTERSERVER_HPP_
+#define MASTERSERVER_HPP_
+
+#include <stdint.h>
+#include <string>
+
+#include "libcanplusplus/CyclePipeline.hpp"
+#include "libcanplusplus/MasterSegment.hpp"
+#include "libcanplusplus/SDOMsg.hpp"
+
+//! Shares the buses of a process with client processes through shared memory
+/*! The process that owns the CAN channels runs a CyclePipeline per bus and adds the
+ * pipelines to the server. Clients attach with MasterClient and
+ * 	read the frames that were received in the last cycle (state snapshot),
+ * 	submit setpoint frames that are sent in every cycle,
+ * 	queue SDOs and read their results.
+ * 	MasterServer server;
+ * 	server.open();
+ * 	server.addPipeline(&pipeline);		// replaces the control callback and the hooks
+ * 	pipeline.run(isRunning);			// in the thread of the bus
+ * 	server.reapClients();				// periodically in another thread
+ *
+ * The server is serviced by the control phase of the pipeline:
+ * 	- the frames of the cycle are published under the seqlock of the bus
+ * 	- the setpoints are arbitrated per COB-ID: the first client owns the COB-ID, a
+ * 	  client with a higher priority takes it over, the setpoints of other clients are
+ * 	  rejected. The last setpoint is sent in every cycle until its owner did not submit
+ * 	  a setpoint for the lease (see setLease()), then the COB-ID is free again.
+ * 	- the SDO requests are taken round-robin from the clients, at most
+ * 	  setMaxSDOsPerCycle() per cycle and maxPendingSDOsPerClient per client in flight.
+ * 	  The SDO manager of the bus processes one SDO per node at a time.
+ *
+ * The frames, setpoints and SDOs are kept in arrays that are sized at addPipeline(),
+ * and the SDOs are taken from the pools, hence servicing does not allocate memory.
+ * Frames with a COB-ID of 29 bits are neither published nor accepted as setpoints.
+ *
+ * @ingroup robotCAN, bus
+ */
+class MasterServer {
+public:
+	//! default name of the shared memory segment
+	static const char* const defaultName;
+
+	//! maximum number of COB-IDs with setpoints per bus
+	static const int maxSetpoints = 64;
+	//! maximum number of SDOs in flight per bus
+	static const int maxPendingSDOs = 32;
+	//! maximum number of SDOs in flight per client and bus
+	static const int maxPendingSDOsPerClient = 4;
+
+	//! Constructor
+	MasterServer();
+
+	//! Destructor, closes the segment
+	virtual ~MasterServer();
+
+	/*! Creates the shared memory segment
+	 * @param name	name of the segment (starts with '/')
+	 * @return true if successful
+	 */
+	bool open(const char* name = defaultName);
+
+	//! Removes the shared memory segment and the buses, is invoked after the pipelines stopped
+	void close();
+
+	/*! Services a bus in the cycle of a pipeline
+	 * Sets the control callback and the hooks of the pipeline. Is invoked at
+	 * initialization, after open().
+	 * @param pipeline	pipeline, the index of its bus must be below MasterSegment::maxBuses
+	 * @return false if the segment is not open or the bus index is out of range
+	 */
+	bool addPipeline(CyclePipeline* pipeline);
+
+	/*! Sets the number of cycles a setpoint is sent without a new one of its owner
+	 * @param nCycles	number of cycles (default 100)
+	 */
+	void setLease(unsigned int nCycles);
+
+	/*! Sets the maximum number of SDO requests that are taken per cycle and bus
+	 * @param maxSDOs	number of SDO requests (default 4)
+	 */
+	void setMaxSDOsPerCycle(unsigned int maxSDOs);
+
+	/*! Frees the slots of clients whose process terminated without detaching
+	 * Is not real-time safe, invoke it periodically from a thread other than the cycles.
+	 * @return number of freed slots
+	 */
+	int reapClients();
+
+	/*! Gets the number of attached clients
+	 * @return number of clients
+	 */
+	int getNumberOfClients() const;
+
+	/*! Gets the segment
+	 * @return segment, NULL if not open
+	 */
+	MasterSegment* getSegment();
+
+private:
+	//! last setpoint of a COB-ID and its owner
+	struct Setpoint {
+		//! COB-ID, -1 if the entry is free
+		int COBId;
+		//! index of the owner
+		int client;
+		//! generation of the owner
+		uint32_t generation;
+		//! cycle of the last setpoint of the owner
+		uint32_t cycle;
+		//! frame
+		CANMsg frame;
+	};
+
+	//! SDO that was queued by a client
+	struct PendingSDO {
+		//! SDO, NULL if the entry is free
+		SDOMsgPtr sdo;
+		//! index of the client
+		int client;
+		//! request
+		MasterSDORequest request;
+	};
+
+	//! State of a bus, only accessed by the thread of its pipeline
+	struct BusState {
+		MasterServer* server;
+		CyclePipeline* pipeline;
+		//! index of the bus in the segment
+		int index;
+		//! number of the current cycle
+		uint32_t cycle;
+		//! frames received in the current cycle, flag is 1 if received
+		CANMsg received[MasterBusSegment::nCOBIds];
+		//! COB-IDs received in the current cycle
+		int16_t receivedCOBIds[MasterBusSegment::nCOBIds];
+		//! number of COB-IDs received in the current cycle
+		int nReceived;
+		//! index of the setpoint of each COB-ID, -1 if none
+		int16_t setpointIndex[MasterBusSegment::nCOBIds];
+		//! setpoints
+		Setpoint setpoints[maxSetpoints];
+		//! SDOs in flight
+		PendingSDO sdos[maxPendingSDOs];
+		//! SDOs in flight per client
+		int nPendingSDOs[MasterSegment::maxClients];
+		//! SDOs in flight of all clients
+		int nAllPendingSDOs;
+		//! client that is asked first for SDO requests in the next cycle
+		int nextClient;
+	};
+
+	//! Control callback of a pipeline, userData is the state of the bus
+	static void service(void* busState);
+	//! Receive hook of a pipeline
+	static void receiveFrame(const CANMsg& frame, void* busState);
+	//! Transmit hook of a pipeline
+	static void transmitFrames(TransmitScheduler* scheduler, void* busState);
+
+	//! Publishes the frames that were received in the current cycle
+	void publishFrames(BusState& bus);
+	//! Takes the setpoints of the clients
+	void takeSetpoints(BusState& bus);
+	//! Applies a setpoint of a client
+	bool applySetpoint(BusState& bus, int client, const MasterSetpoint& setpoint);
+	//! Checks if the owner of a setpoint is attached and its lease did not expire
+	bool isOwned(const BusState& bus, const Setpoint& setpoint) const;
+	//! Returns the results of the finished SDOs to the clients
+	void completeSDOs(BusState& bus);
+	//! Takes the SDO requests of the clients
+	void takeSDORequests(BusState& bus);
+	//! Queues an SDO request of a client
+	void queueSDO(BusState& bus, int client, const MasterSDORequest& request);
+	//! Returns a result to a client
+	bool returnResult(BusState& bus, int client, const MasterSDORequest& request,
+			MasterSDOStatus status, uint32_t abortCode, int32_t value);
+
+	//! segment, NULL if not open
+	MasterSegment* segment_;
+	//! name of the segment
+	std::string name_;
+
+	//! states of the buses, NULL if a bus was not added
+	BusState* buses_[MasterSegment::maxBuses];
+
+	//! lease of the setpoints [cycles]
+	unsigned int lease_;
+	//! maximum number of SDO requests per cycle
+	unsigned int maxSDOsPerCycle_;
+};
+
+#endif /* MASTERSERVER_HPP_ */
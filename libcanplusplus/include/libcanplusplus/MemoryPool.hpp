@@ -0,0 +1,160 @@
+/*!
+ * @file 	MemoryPool.hpp
+ * @brief	Pool of memory blocks with a fixed size
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef MEMORYPOOL_HPP_
+#define MEMORYPOOL_HPP_
+
+#include <stddef.h>
+#include <atomic>
+
+//! Pool of memory blocks with a fixed size
+/*! The blocks are taken from chunks that are allocated on the heap. A released block
+ * is put back into the pool and the chunks are never freed, i.e. the heap is only used
+ * if more blocks are in use than ever before. reserve() allocates the blocks at
+ * initialization, hence the cycle does not allocate memory as long as the number of
+ * blocks suffices.
+ *
+ * Each block has a header with its pool. allocateBlock() falls back to the heap if the
+ * size exceeds the block size, deallocateBlock() returns the block to its origin.
+ * The pool is protected by a spin lock (std::atomic_flag::test_and_set) and can be used
+ * by several threads. The lock does not yield, hence a pool must not be shared by
+ * SCHED_FIFO threads of different priorities on the same CPU: a thread that preempts
+ * the holder of the lock spins forever. The cycle threads of RealTimeThread should have
+ * the same priority or run on different CPUs, other threads should use the pool only
+ * at initialization.
+ *
+ * Usage as class-specific allocation:
+ * 	void* operator new(size_t size) { return MemoryPool::allocateBlock(getPool(), size); }
+ * 	void operator delete(void* p) { MemoryPool::deallocateBlock(p); }
+ *
+ * @ingroup robotCAN
+ */
+class MemoryPool {
+public:
+	/*! Constructor
+	 * @param blockSize	size of a block in bytes
+	 */
+	MemoryPool(size_t blockSize);
+
+	//! Destructor, frees the chunks
+	virtual ~MemoryPool();
+
+	/*! Adds blocks to the pool
+	 * @param nBlocks	total number of blocks the pool should have
+	 */
+	void reserve(size_t nBlocks);
+
+	/*! Gets the size of a block
+	 * @return size [bytes]
+	 */
+	size_t getBlockSize() const;
+
+	/*! Gets the number of blocks of the pool
+	 * @return number of blocks
+	 */
+	size_t getNumberOfBlocks() const;
+
+	/*! Gets the number of blocks that are in use
+	 * @return number of used blocks
+	 */
+	size_t getNumberOfUsedBlocks() const;
+
+	/*! Allocates a block of a pool
+	 * @param pool	pool
+	 * @param size	requested size, the heap is used if it is larger than the block size
+	 * @return memory
+	 */
+	static void* allocateBlock(MemoryPool& pool, size_t size);
+
+	/*! Releases a block that was allocated with allocateBlock()
+	 * @param p		memory
+	 */
+	static void deallocateBlock(void* p);
+
+private:
+	//! Size of the header of a block that stores the pool, keeps the alignment of the block
+	static const size_t headerSize = 16;
+
+	//! Takes a block of the pool, grows the pool if it is empty
+	void* takeBlock();
+
+	//! Puts a block back into the pool
+	void putBlock(void* block);
+
+	//! Allocates a chunk with a number of blocks, must be invoked with the lock held
+	void addChunk(size_t nBlocks);
+
+	//! Acquires the spin lock
+	void lock();
+
+	//! Releases the spin lock
+	void unlock();
+
+	//! size of a block without header
+	const size_t blockSize_;
+	//! size of a block with header
+	const size_t stride_;
+	//! first free block, the free blocks are linked by their header
+	void* freeBlocks_;
+	//! first chunk, the chunks are linked by their first word
+	void* chunks_;
+	//! number of blocks
+	size_t nBlocks_;
+	//! number of used blocks
+	size_t nUsedBlocks_;
+	//! spin lock
+	std::atomic_flag isLocked_;
+};
+
+//! Allocator of a standard container that takes its elements from a memory pool
+/*! Single elements (e.g. the nodes of a std::list) are allocated from a pool per element
+ * type, arrays are allocated on the heap. The pool is never destroyed such that
+ * containers with static storage can release their elements at exit.
+ *
+ * @ingroup robotCAN
+ */
+template <typename T>
+class PoolAllocator {
+public:
+	typedef T value_type;
+
+	PoolAllocator() {}
+
+	template <typename U>
+	PoolAllocator(const PoolAllocator<U>&) {}
+
+	T* allocate(size_t n) {
+		if (n != 1) {
+			return static_cast<T*>(::operator new(n*sizeof(T)));
+		}
+		return static_cast<T*>(MemoryPool::allocateBlock(getPool(), sizeof(T)));
+	}
+
+	void deallocate(T* p, size_t n) {
+		if (n != 1) {
+			::operator delete(p);
+			return;
+		}
+		MemoryPool::deallocateBlock(p);
+	}
+
+	//! Gets the pool of the elements
+	static MemoryPool& getPool() {
+		static MemoryPool* pool = new MemoryPool(sizeof(T));
+		return *pool;
+	}
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) { return false; }
+
+#endif /* MEMORYPOOL_HPP_ */
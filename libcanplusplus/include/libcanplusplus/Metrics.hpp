@@ -0,0 +1,180 @@
+/*!
+ * @file 	Metrics.hpp
+ * @brief	Counters of the buses and nodes in a shared memory segment
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef METRICS_HPP_
+#define METRICS_HPP_
+
+#include <stdint.h>
+#include <atomic>
+
+//! Counter of the metrics, incremented with relaxed atomics
+typedef std::atomic<uint64_t> MetricsCounter;
+
+//! Counters of a bus
+struct BusMetrics {
+	//! received frames
+	MetricsCounter framesReceived;
+	//! sent frames
+	MetricsCounter framesSent;
+	//! frames that were dropped because they were outdated
+	MetricsCounter framesDropped;
+	//! frames that were not sent because the transmit buffer was full
+	MetricsCounter txBufferFull;
+	//! errors of the CAN driver or controller
+	MetricsCounter busErrors;
+	//! cycles
+	MetricsCounter cycles;
+	//! cycles that started late because the previous cycle took too long
+	MetricsCounter cycleOverruns;
+};
+
+//! Counters of a node
+struct NodeMetrics {
+	//! number of abort codes that are counted separately, the last one counts the other codes
+	static const int nAbortCodes = 16;
+
+	//! queued SDO requests
+	MetricsCounter sdoRequests;
+	//! SDO requests that were answered with an abort
+	MetricsCounter sdoAborts;
+	//! aborts per code, see MetricsSegment::abortCodes
+	MetricsCounter sdoAbortsByCode[nAbortCodes];
+	//! SDO requests without response
+	MetricsCounter sdoTimeouts;
+	//! SDO requests that were sent again
+	MetricsCounter sdoRetries;
+	//! heartbeats that did not arrive in time
+	MetricsCounter heartbeatMisses;
+	//! received emergency objects
+	MetricsCounter emcyCount;
+};
+
+//! Layout of the shared memory segment
+/*! The segment starts with a header that identifies the layout. A reader checks magic,
+ * version and size before it reads the counters. A new counter requires a new version.
+ */
+struct MetricsSegment {
+	//! identifies the segment
+	static const uint32_t magicNumber = 0x4D43414E;
+	//! version of the layout
+	static const uint32_t layoutVersion = 1;
+	//! maximum number of buses
+	static const int maxBuses = 8;
+	//! maximum number of nodes per bus
+	static const int maxNodes = 128;
+
+	uint32_t magic;
+	uint32_t version;
+	//! size of the segment [bytes]
+	uint32_t size;
+	uint32_t nBuses;
+	uint32_t nNodes;
+	uint32_t nAbortCodes;
+	//! process that writes the counters
+	int32_t pid;
+	uint32_t reserved;
+	//! time the segment was created, since epoch [ns]
+	int64_t startTime_ns;
+	//! abort code of each entry of NodeMetrics::sdoAbortsByCode, 0 for the other codes
+	uint32_t abortCodes[NodeMetrics::nAbortCodes];
+
+	BusMetrics buses[maxBuses];
+	NodeMetrics nodes[maxBuses][maxNodes];
+};
+
+//! Counters of the buses and nodes that can be read by other processes
+/*! The library increments the counters with relaxed atomic additions, which neither
+ * lock nor allocate. As long as open() was not invoked, the counters are kept in the
+ * memory of the process. open() creates a POSIX shared memory segment, such that a
+ * tool (e.g. metricsDump) can take snapshots without disturbing the process:
+ * 	Metrics::open();				// at initialization, before the buses are added
+ * 	...
+ * 	Metrics::increment(Metrics::getBus(iBus).cycles);
+ *
+ * The counters of a bus or node that is out of range are discarded.
+ *
+ * @ingroup robotCAN
+ */
+class Metrics {
+public:
+	//! default name of the shared memory segment
+	static const char* const defaultName;
+
+	/*! Creates the shared memory segment and moves the counters into it
+	 * The counts of the process are moved into the segment.
+	 * @param name	name of the segment (starts with '/')
+	 * @return true if successful, otherwise the counters stay in the process
+	 */
+	static bool open(const char* name = defaultName);
+
+	/*! Removes the shared memory segment, the counters are kept in the process again
+	 * The threads that count may still hold a reference into the segment, hence close()
+	 * is invoked after they stopped, e.g. after the bus threads were joined.
+	 */
+	static void close();
+
+	/*! Checks if the counters are in a shared memory segment
+	 * @return true if open() succeeded
+	 */
+	static bool isShared();
+
+	/*! Maps a segment of another process for reading
+	 * @param name	name of the segment
+	 * @return segment or NULL if it does not exist or has a different layout,
+	 * 			release it with detach()
+	 */
+	static const MetricsSegment* attach(const char* name = defaultName);
+
+	/*! Unmaps a segment that was mapped by attach()
+	 * @param segment	segment
+	 */
+	static void detach(const MetricsSegment* segment);
+
+	/*! Gets the segment that is written by this process
+	 * @return segment
+	 */
+	static MetricsSegment& getSegment();
+
+	/*! Gets the counters of a bus
+	 * @param iBus	index of the bus
+	 * @return counters
+	 */
+	static BusMetrics& getBus(int iBus);
+
+	/*! Gets the counters of a node
+	 * @param iBus		index of the bus
+	 * @param nodeId	CAN node ID
+	 * @return counters
+	 */
+	static NodeMetrics& getNode(int iBus, int nodeId);
+
+	/*! Increments a counter
+	 * @param counter	counter
+	 * @param n			increment
+	 */
+	static void increment(MetricsCounter& counter, uint64_t n = 1)
+	{
+		counter.fetch_add(n, std::memory_order_relaxed);
+	}
+
+	/*! Counts an SDO abort
+	 * @param iBus		index of the bus
+	 * @param nodeId	CAN node ID
+	 * @param code		abort code
+	 */
+	static void countSDOAbort(int iBus, int nodeId, uint32_t code);
+
+	/*! Gets the entry of an abort code in NodeMetrics::sdoAbortsByCode
+	 * @param code	abort code
+	 * @return index, the last index if the code is not counted separately
+	 */
+	static int getAbortCodeIndex(uint32_t code);
+};
+
+#endif /* METRICS_HPP_ */
@@ -13,6 +13,7 @@
 
 #include <boost/ptr_container/ptr_vector.hpp>
 #include "libcanplusplus/CANOpenMsg.hpp"
+#include "libcanplusplus/SlotMap.hpp"
 
 //! Process Data Object (PDO) Manager
 /*!
@@ -28,10 +29,17 @@ public:
 
 	/*! Adds a PDO to the list
 	 * Memory deallocation is managed by boost shared ptr.
+	 * A PDO with the shared memory ID SlotMap::autoSlot gets the next slot of the slot map.
 	 * @param pdo	reference to the PDO
 	 */
 	void addPDO(CANOpenMsg* pdo);
 
+	/*! Sets the slots of the frames of the PDOs
+	 * Is invoked by the bus.
+	 * @param slots	slot map, NULL if the shared memory IDs are not recorded
+	 */
+	void setSlotMap(SlotMap* slots);
+
 	/*! Gets the reference to a PDO by index
 	 *
 	 * @param index	index of the PDO in the list
@@ -39,6 +47,11 @@ public:
 	 */
 	CANOpenMsg*  getPDO(unsigned int index);
 
+	/*! Reserves the storage of the list such that addPDO() does not allocate memory
+	 * @param nPDOs	number of PDOs
+	 */
+	void reserve(unsigned int nPDOs);
+
 	/*! Gets the first PDO with a given COBId
 	 *
 	 * @param id	desired COBId
@@ -59,10 +72,28 @@ public:
 	int getSize();
 
 	/*! Gets the flag whether the manager is sending PDOs
+	 * If the sending is enabled, all PDOs are sent once regardless of their transmission policy.
 	 * @param isSending
 	 */
 	void setSending(bool isSending);
 
+	/*! Sets the transmission policy of all PDOs except of the SYNC
+	 * @param policy			transmission policy
+	 * @param refreshPeriod		maximum number of cycles between two transmissions of an unchanged PDO
+	 */
+	void setTransmissionPolicy(CANOpenMsg::TransmissionPolicies policy, unsigned int refreshPeriod = 0);
+
+	/*! Sends a PDO at a fraction of the cycle rate and staggers its phase
+	 * The phase is chosen such that the PDO collides with the least number of
+	 * slow PDOs of this manager, e.g. four PDOs with divisor 4 are sent in four
+	 * different cycles. For TxPDOs, the divisor and phase are only recorded and
+	 * define the transmission type and SYNC start value of the node.
+	 * @param pdo		PDO of this manager
+	 * @param divisor	rate divisor, 1 sends the PDO in every cycle
+	 * @return phase of the PDO (0..divisor-1)
+	 */
+	unsigned int setRateDivisor(CANOpenMsg* pdo, unsigned int divisor);
+
 	/*! Gets the flag whether the manager is sending PDOs
 	 * @return true if it is sending
 	 */
@@ -75,6 +106,9 @@ private:
 
 	//! true if manage is sending PDOs
 	bool isSending_;
+
+	//! slots of the frames of the PDOs
+	SlotMap* slots_;
 };
 
 
@@ -0,0 +1,160 @@
+/*!
+ * @file 	RealTimeThread.hpp
+ * @brief	Creation of real-time threads and periodic timing of their cycles
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef REALTIMETHREAD_HPP_
+#define REALTIMETHREAD_HPP_
+
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+//! Creates the threads of the cycles with a real-time policy
+/*! The memory of the process should be locked once at initialization, before the threads
+ * are created:
+ * 	RealTimeThread::lockMemory();
+ * 	RealTimeThread::Parameters parameters;
+ * 	parameters.priority = 80;
+ * 	CPU_SET(1, &parameters.cpus);
+ * 	RealTimeThread::create(&thread, bus_routine, NULL, parameters);
+ *
+ * If the process is not permitted to use the real-time policy (e.g. no CAP_SYS_NICE or
+ * rtprio limit), the thread is created with the default policy and a warning is logged.
+ *
+ * @ingroup robotCAN
+ */
+class RealTimeThread {
+public:
+	//! Scheduling and memory of a thread
+	struct Parameters {
+		//! Constructor, SCHED_FIFO with priority 80 on all CPUs
+		Parameters();
+
+		//! scheduling policy, SCHED_FIFO, SCHED_RR or SCHED_OTHER
+		int policy;
+		//! priority (1-99 for SCHED_FIFO and SCHED_RR)
+		int priority;
+		//! CPUs the thread may run on, empty for all CPUs
+		cpu_set_t cpus;
+		//! size of the stack [bytes], 0 for the default size
+		size_t stackSize;
+		//! size of the stack that is touched before the routine starts [bytes]
+		size_t prefaultStackSize;
+	};
+
+	/*! Locks the current and future memory of the process and prefaults the heap
+	 * Freed memory is not returned to the system anymore, such that the pages stay mapped.
+	 * @param prefaultHeapSize	size of the heap that is touched [bytes]
+	 * @return true if the memory is locked
+	 */
+	static bool lockMemory(size_t prefaultHeapSize = 8*1024*1024);
+
+	/*! Creates a thread
+	 * @param[out] thread	created thread
+	 * @param routine		routine of the thread
+	 * @param arg			argument of the routine
+	 * @param parameters	scheduling and memory of the thread
+	 * @return 0 if successful, otherwise the error number of pthread_create()
+	 */
+	static int create(pthread_t* thread, void* (*routine)(void*), void* arg,
+			const Parameters& parameters = Parameters());
+
+	/*! Applies the scheduling to the calling thread
+	 * Is used for threads that were not created by create(), e.g. the main thread.
+	 * @param parameters	scheduling of the thread, the stack size is ignored
+	 * @return true if successful
+	 */
+	static bool configureCurrentThread(const Parameters& parameters);
+};
+
+//! Wakes up a thread periodically at absolute deadlines of CLOCK_MONOTONIC
+/*! The deadlines are multiples of the period after start(), such that the period does
+ * not drift and jumps of the wall clock have no effect. If a cycle takes longer than a
+ * period, the missed deadlines are counted and skipped, i.e. the next cycle starts at the
+ * next deadline in the future instead of several cycles in a row:
+ * 	PeriodicTimer timer(2500);
+ * 	timer.start();
+ * 	while (true) {
+ * 		if (!timer.waitForNextCycle()) { ... }	// missed deadline
+ * 		...
+ * 		timer.sleepUntil(500);					// 500 us after the start of the cycle
+ * 	}
+ *
+ * waitForNextDeadline() does not skip the missed deadlines, see CycleExecutor.
+ *
+ * @ingroup robotCAN
+ */
+class PeriodicTimer {
+public:
+	/*! Constructor
+	 * @param period_us	period [us]
+	 */
+	PeriodicTimer(unsigned int period_us);
+
+	//! Destructor
+	virtual ~PeriodicTimer();
+
+	//! Sets the start of the current cycle to the current time
+	void start();
+
+	/*! Sleeps until the start of the next cycle
+	 * @return false if the deadline of the next cycle had already passed
+	 */
+	bool waitForNextCycle();
+
+	/*! Sleeps until the deadline that follows the current cycle
+	 * Unlike waitForNextCycle(), a deadline that had passed is not skipped, the cycle
+	 * starts immediately and the cycles run back-to-back until they caught up.
+	 * @return false if the deadline had already passed
+	 */
+	bool waitForNextDeadline();
+
+	/*! Sleeps until a time relative to the start of the current cycle
+	 * @param offset_us	time since the start of the cycle [us]
+	 */
+	void sleepUntil(unsigned int offset_us);
+
+	/*! Gets the time since the start of the current cycle
+	 * @return elapsed time [us]
+	 */
+	int64_t getElapsedTime_us() const;
+
+	/*! Gets the start of the current cycle
+	 * @return time of CLOCK_MONOTONIC
+	 */
+	const struct timespec& getCycleStartTime() const;
+
+	/*! Gets the period
+	 * @return period [us]
+	 */
+	unsigned int getPeriod_us() const;
+
+	/*! Gets the number of deadlines that were missed
+	 * @return number of missed deadlines, a late cycle may miss several deadlines
+	 */
+	unsigned int getNumberOfMissedDeadlines() const;
+
+	/*! Gets the maximum time a cycle started after its deadline
+	 * @return lateness [us]
+	 */
+	int64_t getMaxLateness_us() const;
+
+private:
+	//! period [ns]
+	int64_t period_ns_;
+	//! start of the current cycle
+	struct timespec cycleStart_;
+	//! number of missed deadlines
+	unsigned int nMissedDeadlines_;
+	//! maximum lateness [ns]
+	int64_t maxLateness_ns_;
+};
+
+#endif /* REALTIMETHREAD_HPP_ */
@@ -0,0 +1,147 @@
+/*!
+ * @file 	ReceiveDispatcher.hpp
+ * @brief	Handlers that are invoked when a frame is received
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef RECEIVEDISPATCHER_HPP_
+#define RECEIVEDISPATCHER_HPP_
+
+#include <stdint.h>
+#include <atomic>
+
+#include "libcanplusplus/CANMsg.hpp"
+#include "libcanplusplus/AcceptanceFilter.hpp"
+
+class CANOpenMsg;
+
+//! Decodes latency-critical PDOs in the receive thread and invokes their handlers
+/*! The main loop sees a received frame in its next cycle. A handler that is added to
+ * the dispatcher is invoked by dispatch() as soon as the frame arrives, e.g. by the
+ * message handler of the CAN driver:
+ * 	busManager.getBus(iBus)->getReceiveDispatcher()->dispatch(frame);
+ *
+ * The PDO of a handler decodes the frame in the receive thread. It is owned by the
+ * caller and must not be added to a PDO manager, the main loop keeps its own PDO of
+ * the COB-ID. The frame is still passed on to the slots of the main loop.
+ *
+ * Real-time constraints of the handlers: they run in the receive thread and delay
+ * the following frames. They must not lock, allocate, print or block and should
+ * return within the budget, see setBudget(). The duration of each handler is
+ * measured, the handlers that exceeded the budget are counted.
+ *
+ * Handlers are added before the receive thread is started, removeHandler() may be
+ * invoked at any time by the control thread. It waits until a dispatch() that may still
+ * use the PDO of the handler returned, afterwards the PDO may be deleted and the
+ * COB-ID may get a new handler. dispatch() is invoked by one receive thread only.
+ *
+ * @ingroup robotCAN, bus
+ */
+class ReceiveDispatcher {
+public:
+	//! maximum number of handlers
+	static const int maxHandlers = 32;
+
+	/*! Handler that is invoked in the receive thread after the PDO decoded a frame
+	 * Must be real-time safe: no locks, no allocations, no I/O.
+	 */
+	typedef void (*Handler)(CANOpenMsg* pdo, void* userData);
+
+	//! Constructor
+	ReceiveDispatcher();
+
+	//! Destructor
+	virtual ~ReceiveDispatcher();
+
+	/*! Adds a handler for the COB-ID of a PDO
+	 * @param pdo		PDO that decodes the frames, it is not deleted
+	 * @param handler	handler
+	 * @param userData	pointer that is passed to the handler
+	 * @return false if the COB-ID has a handler or all handlers are used
+	 */
+	bool addHandler(CANOpenMsg* pdo, Handler handler, void* userData = NULL);
+
+	/*! Disables the handler of a COB-ID and waits until it is no longer invoked
+	 * Must not be invoked by a handler.
+	 * @param COBId	COB-ID
+	 */
+	void removeHandler(int COBId);
+
+	/*! Checks if a COB-ID has a handler
+	 * @param COBId	COB-ID
+	 * @return true if a frame of the COB-ID is dispatched
+	 */
+	bool hasHandler(int COBId) const;
+
+	/*! Decodes a received frame and invokes its handler (receive thread)
+	 * @param frame	received frame
+	 * @return true if the COB-ID has a handler
+	 */
+	bool dispatch(const CANMsg& frame);
+
+	/*! Sets the time a handler may take
+	 * @param budget_ns	budget [ns], 0 disables the supervision
+	 */
+	void setBudget(int64_t budget_ns);
+
+	/*! Gets the number of dispatched frames
+	 * @return number of invoked handlers
+	 */
+	unsigned int getNumberOfDispatches() const;
+
+	/*! Gets the number of handlers that took longer than the budget
+	 * @return number of overruns
+	 */
+	unsigned int getNumberOfOverruns() const;
+
+	/*! Gets the longest duration of a handler including the decoding
+	 * @return duration [ns]
+	 */
+	int64_t getMaxDuration_ns() const;
+
+	/*! Adds the COB-IDs of the handlers to a filter
+	 * @param filter	acceptance filter
+	 */
+	void addCOBIds(AcceptanceFilter* filter) const;
+
+private:
+	//! number of COB-IDs, only standard identifiers are dispatched
+	static const int nCOBIds = 0x800;
+
+	//! handler of a COB-ID
+	struct Entry {
+		int COBId;
+		CANOpenMsg* pdo;
+		std::atomic<Handler> handler;
+		void* userData;
+	};
+
+	//! index of the entry of each COB-ID, -1 if none
+	std::atomic<int8_t> entries_[nCOBIds];
+
+	//! handlers
+	Entry handlers_[maxHandlers];
+
+	//! number of used entries
+	int nHandlers_;
+
+	//! incremented when dispatch() starts and when it returns, odd while a frame is dispatched
+	std::atomic<unsigned int> dispatchEpoch_;
+
+	//! budget of a handler [ns], 0 if not supervised
+	std::atomic<int64_t> budget_ns_;
+
+	//! number of dispatched frames
+	std::atomic<unsigned int> nDispatches_;
+
+	//! number of handlers that exceeded the budget
+	std::atomic<unsigned int> nOverruns_;
+
+	//! longest duration of a handler [ns]
+	std::atomic<int64_t> maxDuration_ns_;
+};
+
+#endif /* RECEIVEDISPATCHER_HPP_ */
@@ -0,0 +1,48 @@
+/*!
+ * @file 	RosLogSink.hpp
+ * @brief	Output of the log messages of the library with rosconsole
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef ROSLOGSINK_HPP_
+#define ROSLOGSINK_HPP_
+
+#include <ros/ros.h>
+#include "libcanplusplus/Logger.hpp"
+
+//! Writes the log messages with the ROS logging macros
+/*! The library itself does not depend on ROS, this sink is only compiled by the
+ * ROS nodes that include it:
+ * 	static RosLogSink rosLogSink;
+ * 	Logger::setSink(&rosLogSink);
+ *
+ * @ingroup robotCAN
+ */
+class RosLogSink : public LogSink {
+public:
+	virtual ~RosLogSink() {}
+
+	virtual void write(LogLevels level, int64_t time_ns, const char* message)
+	{
+		switch (level) {
+		case LogLevels::debug:
+			ROS_DEBUG("%s", message);
+			break;
+		case LogLevels::info:
+			ROS_INFO("%s", message);
+			break;
+		case LogLevels::warn:
+			ROS_WARN("%s", message);
+			break;
+		case LogLevels::error:
+		default:
+			ROS_ERROR("%s", message);
+			break;
+		}
+	}
+};
+
+#endif /* ROSLOGSINK_HPP_ */
@@ -13,15 +13,31 @@
 
 
 #include "libcanplusplus/SDOMsg.hpp"
+#include "libcanplusplus/MemoryPool.hpp"
+#include "libcanplusplus/SlotMap.hpp"
 #include <list>
 
 
 //! Service Data Object (SDO) Manager
-/*!
+/*! The SDOs are processed in the order they were added.
+ *
+ * getSendSDO() and getReceiveSDO() process one SDO of the bus at a time.
+ * getSendSDOs() and getReceiveSDOs() process one SDO per node at a time, i.e. the nodes
+ * are configured concurrently. The SDOs of one node are still processed in order and a
+ * broadcast NMT command (node ID 0) waits until all previous SDOs are processed.
+ * This requires that the nodes use distinct shared memory indices for their SDOs.
+ * An SDO with the shared memory IDs SlotMap::autoSlot gets the slots of the SDO COB-IDs
+ * of its node, see setSlotMaps().
+ *
+ * The nodes of the list are taken from a memory pool, see reserve().
+ *
  * @ingroup robotCAN
  */
 class SDOManager {
 public:
+	//! maximum number of nodes
+	static const int maxNodes = 128;
+
 	/*! Constructor
 	 * @param iBus	identifier of the CAN bus (channel)
 	 */
@@ -30,6 +46,12 @@ public:
 	//! Destructor
 	virtual ~SDOManager();
 
+	/*! Allocates the list entries for a number of queued SDOs at initialization
+	 * The entries are shared by all SDO managers.
+	 * @param nSDOs		number of SDOs
+	 */
+	void reserve(unsigned int nSDOs);
+
 	/*! Adds an SDO message to the list
 	 * @param sdo 	reference to the SDO
 	 */
@@ -41,6 +63,13 @@ public:
 	 */
 	virtual void addSDO(SDOMsgPtr sdo);
 
+	/*! Sets the slots of the frames of the SDOs
+	 * Is invoked by the bus.
+	 * @param receiveSlots	slots of the responses, NULL if the shared memory IDs are not recorded
+	 * @param sendSlots		slots of the requests, NULL if the shared memory IDs are not recorded
+	 */
+	void setSlotMaps(SlotMap* receiveSlots, SlotMap* sendSlots);
+
 	/*! Gets the reference to a SDO by index
 	 * @param 	index		index of the SDO in the list
 	 * @return 	reference to SDO
@@ -79,15 +108,92 @@ public:
 	 */
 	virtual SDOMsg* getReceiveSDO();
 
+	/*! Gets the SDOs that are sent, at most one per node
+	 * Removes the SDOs that were sent and received.
+	 * @param[out] sdos		array of the SDOs
+	 * @param maxSDOs		size of the array
+	 * @return number of SDOs
+	 */
+	virtual int getSendSDOs(SDOMsg** sdos, int maxSDOs);
+
+	/*! Gets the SDOs that wait for a response, at most one per node
+	 * Removes the SDOs that have a timeout.
+	 * @param[out] sdos		array of the SDOs
+	 * @param maxSDOs		size of the array
+	 * @return number of SDOs
+	 */
+	virtual int getReceiveSDOs(SDOMsg** sdos, int maxSDOs);
+
+	/*! Gets the number of SDOs of a node that are not yet processed
+	 * @param nodeId	ID of the CAN node, 0 for broadcast NMT commands
+	 * @return number of SDOs
+	 */
+	int getNumberOfSDOs(int nodeId);
+
+	/*! Gets the number of SDOs of a node that were removed due to a timeout
+	 * @param nodeId	ID of the CAN node
+	 * @return number of timeouts
+	 */
+	unsigned int getNumberOfTimeouts(int nodeId);
+
+	/*! Gets the number of SDOs of a node that the node answered with an abort
+	 * @param nodeId	ID of the CAN node
+	 * @return number of aborts
+	 */
+	unsigned int getNumberOfAborts(int nodeId);
+
+	/*! Passes a frame to an SDO that waits for its response and counts the abort
+	 * @param sdo	SDO that waits for a response
+	 * @param msg	frame of the response slot of the SDO
+	 */
+	void receiveResponse(SDOMsg* sdo, const CANMsg* msg);
+
 protected:
+	/*! Collects the first SDO of each node
+	 * @param[out] sdos		array of the SDOs
+	 * @param maxSDOs		size of the array
+	 * @return number of SDOs
+	 */
+	int getFirstSDOs(SDOMsg** sdos, int maxSDOs);
+
+	/*! Prints the SDO that has a timeout and counts the timeout
+	 * @param sdo	SDO with timeout
+	 */
+	void reportTimeout(SDOMsg* sdo);
+
+	/*! Counts the abort of an SDO that is removed after its response
+	 * @param sdo	SDO that was sent and received
+	 */
+	void countAbort(SDOMsg* sdo);
+
+	/*! Resolves or records the shared memory IDs of an SDO that is added
+	 * @param sdo	SDO
+	 */
+	void assignSlots(SDOMsg* sdo);
+
+	//! list of SDO messages whose nodes are taken from a pool
+	typedef std::list<SDOMsgPtr, PoolAllocator<SDOMsgPtr> > SDOList;
+
 	//! List of SDO messages that works as a buffer
-	std::list<SDOMsgPtr>sdos_;
+	SDOList sdos_;
 
 	//! An empty SDO message
 	SDOMsg* emptySDO_;
 
 	//! identifier of the CAN bus (channel)
 	int iBus_;
+
+	//! number of timeouts per node
+	unsigned int nTimeouts_[maxNodes];
+
+	//! number of aborts per node
+	unsigned int nAborts_[maxNodes];
+
+	//! slots of the responses
+	SlotMap* receiveSlots_;
+
+	//! slots of the requests
+	SlotMap* sendSlots_;
 };
 
 #endif /* SDOMANAGER_HPP_ */
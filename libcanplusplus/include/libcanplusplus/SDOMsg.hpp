@@ -11,7 +11,8 @@
 #define SDOMSG_HPP_
 
 #include "libcanplusplus/CANOpenMsg.hpp"
-#include <boost/shared_ptr.hpp>
+#include <atomic>
+#include <boost/intrusive_ptr.hpp>
 
 
 //! Service Data Object Message Container
@@ -24,6 +25,10 @@
  *  	received:	has received a response from the CAN node
  *  	timeout:	has not received a response after a while
  *
+ * The SDOs are reference counted by SDOMsgPtr (boost::intrusive_ptr) and allocated from
+ * a memory pool, see reservePool(). Thus creating an SDO in the cycle does not allocate
+ * memory as long as the pools suffice.
+ *
  * @ingroup robotCAN
  */
 class SDOMsg {
@@ -39,6 +44,23 @@ public:
 	//! Destructor
 	virtual ~SDOMsg();
 
+	//! Allocates an SDO from the pool of the SDOs
+	static void* operator new(size_t size);
+
+	//! Releases an SDO to the pool of the SDOs
+	static void operator delete(void* p);
+
+	/*! Allocates the SDOs at initialization
+	 * Each SDO needs two messages of the pool of CANOpenMsg.
+	 * @param nSDOs		number of SDOs
+	 */
+	static void reservePool(unsigned int nSDOs);
+
+	/*! Gets the pool of the SDOs
+	 * @return pool
+	 */
+	static MemoryPool& getPool();
+
 	/*! Gets the reference to the output message
 	 * @return	 output message
 	 */
@@ -92,9 +114,10 @@ public:
 	void sendMsg(CANMsg *canDataDes);
 
 	/*! Sets the input CAN message that was received from the CAN node
+	 * A cycle without a response counts towards the timeout once the SDO was sent.
 	 * @param[in] canDataMeas	input CAN message
 	 */
-	void receiveMsg(CANMsg *canDataMeas);
+	void receiveMsg(const CANMsg *canDataMeas);
 
 	inline uint8_t readuint8() const
 	{
@@ -129,6 +152,27 @@ public:
       return value;
   }
 
+  /*! Checks if the node answered with an abort transfer
+   * @return true if the received command specifier is 0x80
+   */
+  inline bool isAborted() const
+  {
+      return isReceived_ && (inputMsg_->getValue()[0] & 0xFF) == 0x80;
+  }
+
+  /*! Gets the abort code of an aborted transfer
+   * @return abort code, see isAborted()
+   */
+  inline uint32_t getAbortCode() const
+  {
+      return (uint32_t)readint32();
+  }
+
+  /*! Gets the ID of the CAN node
+   * @return node ID, 0 for a broadcast NMT command
+   */
+  int getNodeId() const {return nodeId_;}
+
   //! getters for index and subindex for message verfication
   int getIndex() {return index_;}
   int getSubIndex() {return subIndex_;}
@@ -174,9 +218,30 @@ protected:
 	//! output CAN message that will be sent to the CAN node
 	CANOpenMsg* outputMsg_;
 
+private:
+	friend void intrusive_ptr_add_ref(SDOMsg* sdo);
+	friend void intrusive_ptr_release(SDOMsg* sdo);
+
+	//! number of references of SDOMsgPtr
+	std::atomic<int> refCount_;
+
 };
 
-//! Boost shared point of an SDO message
-typedef boost::shared_ptr<SDOMsg> SDOMsgPtr;
+//! Increments the reference count of an SDO
+inline void intrusive_ptr_add_ref(SDOMsg* sdo)
+{
+	sdo->refCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+//! Decrements the reference count of an SDO and deletes it with the last reference
+inline void intrusive_ptr_release(SDOMsg* sdo)
+{
+	if (sdo->refCount_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		delete sdo;
+	}
+}
+
+//! Reference counted pointer of an SDO message
+typedef boost::intrusive_ptr<SDOMsg> SDOMsgPtr;
 
 #endif /* SDOMSG_HPP_ */
@@ -0,0 +1,93 @@
+/*!
+ * @file 	SPSCQueue.hpp
+ * @brief	Lock-free single-producer single-consumer queue
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef SPSCQUEUE_HPP_
+#define SPSCQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+//! Bounded lock-free queue for one producer thread and one consumer thread
+/*! The storage is part of the object, hence neither push() nor pop() allocate
+ * memory. push() fails if the queue is full instead of blocking.
+ *
+ * @tparam T	type of the elements (copy assignable)
+ * @tparam Size	capacity of the queue, must be a power of two
+ * @ingroup robotCAN
+ */
+template <typename T, std::size_t Size>
+class SPSCQueue {
+	static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Size must be a power of two");
+public:
+	//! Constructor
+	SPSCQueue():head_(0),tail_(0) {}
+
+	/*! Appends an element (producer thread only)
+	 * @param item	element to append
+	 * @return false if the queue is full
+	 */
+	bool push(const T& item)
+	{
+		const std::size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail - head_.load(std::memory_order_acquire) >= Size) {
+			return false;
+		}
+		buffer_[tail & (Size - 1)] = item;
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*! Removes the oldest element (consumer thread only)
+	 * @param[out] item	removed element
+	 * @return false if the queue is empty
+	 */
+	bool pop(T& item)
+	{
+		const std::size_t head = head_.load(std::memory_order_relaxed);
+		if (head == tail_.load(std::memory_order_acquire)) {
+			return false;
+		}
+		item = buffer_[head & (Size - 1)];
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*! Checks if the queue is empty
+	 * @return true if there is no element in the queue
+	 */
+	bool isEmpty() const
+	{
+		return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+	}
+
+	/*! Gets the capacity of the queue
+	 * @return capacity
+	 */
+	static std::size_t getCapacity()
+	{
+		return Size;
+	}
+
+private:
+	//! size of a cache line
+	static const std::size_t cacheLineSize = 64;
+
+	//! index of the next element to pop, only written by the consumer
+	std::atomic<std::size_t> head_;
+	//! keeps head_ and tail_ on different cache lines
+	char padding_[cacheLineSize - sizeof(std::atomic<std::size_t>)];
+	//! index of the next free element, only written by the producer
+	std::atomic<std::size_t> tail_;
+	//! keeps tail_ and the buffer on different cache lines
+	char padding2_[cacheLineSize - sizeof(std::atomic<std::size_t>)];
+	//! ring buffer
+	T buffer_[Size];
+};
+
+#endif /* SPSCQUEUE_HPP_ */
@@ -0,0 +1,143 @@
+/*!
+ * @file 	SlotMap.hpp
+ * @brief	Slots of the frames of a bus
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef SLOTMAP_HPP_
+#define SLOTMAP_HPP_
+
+#include <atomic>
+#include <stdint.h>
+
+//! Maps the COB-IDs of a bus to the slots of its frames, i.e. the shared memory IDs
+/*! A bus has one map for the received and one for the sent frames. The PDOs and SDOs
+ * that are added with the shared memory ID autoSlot get the next free slot, such that
+ * the slots are dense and the frames of a bus can be sized with getSize():
+ * 	bus->setAutomaticSlots(true);
+ * 	bus->getTxPDOManager()->addPDO(new TxPDOPositionVelocity(nodeId, SlotMap::autoSlot));
+ * 	...
+ * 	CANMsg received[bus->getReceiveSlots()->getSize()];
+ * 	received[bus->getReceiveSlots()->getSlot(frame.COBId)] = frame;
+ *
+ * A slot may be shared by several COB-IDs, but a COB-ID has only one slot. The SDOs
+ * of a node use the slots of the COB-IDs 0x580 + node ID and 0x600 + node ID, also
+ * for the NMT commands.
+ *
+ * The dirty bitmap marks the slots that were written in a cycle, e.g. Bus::emit()
+ * marks the frames it flagged and clears them in the next cycle, and CyclePipeline
+ * marks the received frames, such that they are visited without a scan of all frames.
+ * The bitmap describes the frames of its producer. A consumer that gets the frames
+ * through a copy, e.g. the shared memory of the bus routines of the examples, does not
+ * know to which cycle the bitmap belongs and scans the flags of the copy instead.
+ * Slots are allocated at initialization or in the thread of the cycle, getSlot() and
+ * the bitmap may be used by other threads.
+ *
+ * The producer of the received frames numbers the frames of a slot with
+ * nextSequence(), such that the messages decode only the frames they did not see:
+ * 	received[slot] = frame;
+ * 	received[slot].sequence = map->nextSequence(slot);
+ *
+ * @ingroup robotCAN, bus
+ */
+class SlotMap {
+public:
+	//! shared memory ID of a message whose slot is allocated when it is added to a bus
+	static const int autoSlot = -1;
+
+	//! shared memory ID of a message that is not exchanged through a slot
+	static const int noSlot = -2;
+
+	//! maximum number of slots
+	static const int maxSlots = 512;
+
+	//! number of COB-IDs, only standard identifiers are mapped
+	static const int nCOBIds = 0x800;
+
+	//! Constructor
+	SlotMap();
+
+	//! Destructor
+	virtual ~SlotMap();
+
+	/*! Gets the slot of a COB-ID, a new slot is allocated if the COB-ID has none
+	 * @param COBId	COB-ID
+	 * @return slot, -1 if the COB-ID is not a standard identifier or all slots are used
+	 */
+	int allocate(int COBId);
+
+	/*! Maps a COB-ID to a given slot
+	 * Is used for messages with a fixed shared memory ID.
+	 * @param COBId	COB-ID
+	 * @param slot	slot
+	 * @return false if the COB-ID already has another slot or the arguments are invalid
+	 */
+	bool assign(int COBId, int slot);
+
+	/*! Gets the slot of a COB-ID
+	 * @param COBId	COB-ID
+	 * @return slot, -1 if the COB-ID has none
+	 */
+	int getSlot(int COBId) const;
+
+	/*! Gets the number of slots
+	 * @return highest slot + 1
+	 */
+	int getSize() const;
+
+	//! Removes all COB-IDs and slots
+	void clear();
+
+	/*! Marks a slot as written
+	 * @param slot	slot
+	 */
+	void setDirty(int slot);
+
+	/*! Checks if a slot was written
+	 * @param slot	slot
+	 * @return true if marked
+	 */
+	bool isDirty(int slot) const;
+
+	/*! Gets the next slot that was written
+	 * 	for (int slot=map->getNextDirtySlot(0); slot>=0; slot=map->getNextDirtySlot(slot+1)) { ... }
+	 * @param slot	first slot that is checked
+	 * @return slot, -1 if there is none
+	 */
+	int getNextDirtySlot(int slot) const;
+
+	/*! Gets the number of slots that were written
+	 * @return number of marked slots
+	 */
+	int getNumberOfDirtySlots() const;
+
+	//! Clears the marks of all slots
+	void clearDirty();
+
+	/*! Numbers a new frame of a slot
+	 * @param slot	slot
+	 * @return sequence number of the frame, never 0, 0 if the slot is invalid
+	 */
+	unsigned int nextSequence(int slot);
+
+private:
+	//! number of bits of a word of the bitmap
+	static const int bitsPerWord = 64;
+
+	//! slot of each COB-ID, -1 if none
+	std::atomic<int16_t> slots_[nCOBIds];
+
+	//! highest slot + 1
+	std::atomic<int> size_;
+
+	//! bitmap of the written slots
+	std::atomic<uint64_t> dirty_[maxSlots/bitsPerWord];
+
+	//! sequence number of the last frame of each slot
+	std::atomic<unsigned int> sequences_[maxSlots];
+};
+
+#endif /* SLOTMAP_HPP_ */
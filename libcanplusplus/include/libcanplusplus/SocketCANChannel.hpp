@@ -0,0 +1,116 @@
+/*!
+ * @file 	SocketCANChannel.hpp
+ * @brief	CAN channel based on Linux SocketCAN with CAN FD support
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef SOCKETCANCHANNEL_HPP_
+#define SOCKETCANCHANNEL_HPP_
+
+#include <stdint.h>
+
+#include "libcanplusplus/CANMsg.hpp"
+#include "libcanplusplus/AcceptanceFilter.hpp"
+
+//! Sends and receives CAN messages over a SocketCAN interface
+/*! The raw socket is non-blocking, hence send() and receive() can be invoked from the
+ * bus routine like the functions of the CPC driver.
+ *
+ * If the channel is opened with CAN FD, messages with CANMsg::fdf are sent as
+ * canfd_frame with up to 64 bytes and the bit rate switch of CANMsg::brs.
+ * Classic frames are still sent and received as can_frame.
+ *
+ * With setAcceptanceFilter(), the kernel drops all frames that are not received by the
+ * bus, i.e. foreign traffic on a shared bus does not wake up the process.
+ *
+ * Usage:
+ * 	SocketCANChannel channel;
+ * 	if (!channel.open("can0", true)) { ... }
+ * 	while (channel.receive(&msg) > 0) { ... }
+ * 	channel.send(msg);
+ *
+ * @ingroup robotCAN, bus
+ */
+class SocketCANChannel {
+public:
+	//! Constructor
+	SocketCANChannel();
+
+	//! Destructor, closes the socket
+	virtual ~SocketCANChannel();
+
+	/*! Opens a raw CAN socket and binds it to an interface
+	 * @param interfaceName	name of the network interface, e.g. can0
+	 * @param enableFD		if true, CAN FD frames are sent and received
+	 * @return true if successful
+	 */
+	bool open(const char* interfaceName, bool enableFD = false);
+
+	//! Closes the socket
+	void close();
+
+	/*! Installs the computed filters of the bus in the kernel (CAN_RAW_FILTER)
+	 * Extended frames are rejected. Without filters, no frame is received.
+	 * @param filter	computed acceptance filter, see Bus::updateAcceptanceFilter()
+	 * @return true if successful
+	 */
+	bool setAcceptanceFilter(const AcceptanceFilter& filter);
+
+	/*! Checks if the socket is open
+	 * @return true if open
+	 */
+	bool isOpen() const;
+
+	/*! Checks if CAN FD frames are enabled
+	 * @return true if CAN FD is enabled
+	 */
+	bool isFD() const;
+
+	/*! Gets the file descriptor of the socket, e.g. to wait with poll()
+	 * @return file descriptor, -1 if the socket is not open
+	 */
+	int getFileDescriptor() const;
+
+	/*! Sends a message
+	 * @param msg	CAN message
+	 * @return 1 if the message was sent, 0 if the transmit queue is full, -1 on error
+	 */
+	int send(const CANMsg& msg);
+
+	/*! Receives a message without blocking
+	 * @param msg	received CAN message
+	 * @return 1 if a message was received, 0 if no message is available, -1 on error
+	 */
+	int receive(CANMsg* msg);
+
+	/*! Receives a message, waits if no message is available
+	 * @param msg			received CAN message
+	 * @param timeout_us	maximum time to wait [us]
+	 * @return 1 if a message was received, 0 if the timeout elapsed, -1 on error
+	 */
+	int receive(CANMsg* msg, int64_t timeout_us);
+
+	/*! Sets the index of the bus whose metrics are counted
+	 * @param iBus	index of the bus, -1 to disable the counting
+	 */
+	void setBusIndex(int iBus);
+
+private:
+	//! Writes a frame to the socket, see send()
+	int sendFrame(const CANMsg& msg);
+
+	//! Reads a frame from the socket, see receive()
+	int receiveFrame(CANMsg* msg);
+
+	//! file descriptor of the socket
+	int socket_;
+	//! if true, CAN FD frames are enabled
+	bool isFD_;
+	//! index of the bus in the metrics, -1 if not counted
+	int iBus_;
+};
+
+#endif /* SOCKETCANCHANNEL_HPP_ */
@@ -0,0 +1,64 @@
+/*!
+ * @file 	Span.hpp
+ * @brief	View of a contiguous array
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef SPAN_HPP_
+#define SPAN_HPP_
+
+#include <stddef.h>
+#include <type_traits>
+
+//! View of a contiguous array that does not own the elements
+/*! Is passed by value. A Span<T> converts to a Span<const T>:
+ * 	CANMsg frames[nFrames];
+ * 	bus->ingest(Span<const CANMsg>(frames, nFrames));
+ * 	bus->ingest(frames);	// size of the array is deduced
+ *
+ * @ingroup robotCAN
+ */
+template <typename T>
+class Span {
+public:
+	//! Constructor of an empty span
+	Span(): data_(NULL), size_(0) {}
+
+	/*! Constructor
+	 * @param data	first element
+	 * @param size	number of elements
+	 */
+	Span(T* data, size_t size): data_(data), size_(size) {}
+
+	//! Constructor of a span of an array
+	template <size_t N>
+	Span(T (&array)[N]): data_(array), size_(N) {}
+
+	//! Converts a span of mutable elements to a span of const elements
+	template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+	Span(const Span<U>& other): data_(other.data()), size_(other.size()) {}
+
+	//! Gets the first element
+	T* data() const { return data_; }
+
+	//! Gets the number of elements
+	size_t size() const { return size_; }
+
+	//! Checks if the span has no elements
+	bool empty() const { return size_ == 0; }
+
+	//! Gets an element without range check
+	T& operator[](size_t index) const { return data_[index]; }
+
+	T* begin() const { return data_; }
+	T* end() const { return data_ + size_; }
+
+private:
+	T* data_;
+	size_t size_;
+};
+
+#endif /* SPAN_HPP_ */
@@ -0,0 +1,329 @@
+/*!
+ * @file 	StaticBus.hpp
+ * @brief	Bus whose PDOs are known at compile time
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef STATICBUS_HPP_
+#define STATICBUS_HPP_
+
+#include "libcanplusplus/Bus.hpp"
+#include "libcanplusplus/CANMsg.hpp"
+#include "libcanplusplus/Span.hpp"
+#include "libcanplusplus/Trace.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tuple>
+#include <type_traits>
+
+//! PDO whose type is known at compile time (CRTP)
+/*! The derived class decodes and encodes the data bytes without virtual functions:
+ * 	class TxPDOPosition: public StaticPDO<TxPDOPosition> {
+ * 	public:
+ * 		TxPDOPosition(int nodeId, int SMId): StaticPDO<TxPDOPosition>(0x180 + nodeId, SMId) {}
+ * 		void decode(const unsigned char* data, int length) { position_ = ...; }
+ * 		int encode(unsigned char* data) { ...; return length; }	// only for RxPDOs
+ * 	};
+ *
+ * As CANOpenMsg::setCANMsg(), receive() skips frames whose sequence number was seen.
+ *
+ * @ingroup robotCAN
+ */
+template <typename Derived>
+class StaticPDO {
+public:
+	/*! Constructor
+	 * @param COBId	COB-ID of the PDO
+	 * @param SMId	index of the frame in the frames of the bus
+	 */
+	StaticPDO(int COBId, int SMId)
+	:COBId_(COBId),
+	 SMId_(SMId),
+	 flag_(0),
+	 isUpdated_(false),
+	 age_cycles_(-1),
+	 sequence_(0)
+	{
+
+	}
+
+	/*! Gets the COB-ID
+	 * @return COB-ID
+	 */
+	int getCOBId() const { return COBId_; }
+
+	/*! Gets the index of the frame
+	 * @return shared memory ID
+	 */
+	int getSMId() const { return SMId_; }
+
+	/*! Sets the index of the frame
+	 * @param SMId	shared memory ID
+	 */
+	void setSMId(int SMId) { SMId_ = SMId; }
+
+	/*! Sets the flag that the PDO is sent in the next cycle
+	 * @param flag	1 to send the PDO
+	 */
+	void setFlag(char flag) { flag_ = flag; }
+
+	/*! Checks if the PDO was received in this cycle
+	 * @return true if the values were updated
+	 */
+	bool isUpdated() const { return isUpdated_; }
+
+	/*! Gets the number of calls of receive() since the last new frame
+	 * @return age [cycles], -1 if the PDO was never received
+	 */
+	int64_t getAge_cycles() const { return age_cycles_; }
+
+	/*! Passes a received frame to Derived::decode()
+	 * @param frame	received frame, an empty frame or a frame that was seen keeps the values
+	 */
+	void receive(const CANMsg& frame)
+	{
+		isUpdated_ = (frame.flag != 0) && (frame.sequence == 0 || frame.sequence != sequence_);
+		if (isUpdated_) {
+			age_cycles_ = 0;
+			sequence_ = frame.sequence;
+			LIBCANPLUSPLUS_TRACE3(pdo_decode, COBId_, frame.length, frame.sequence);
+			static_cast<Derived*>(this)->decode(frame.value, frame.length);
+		} else if (age_cycles_ >= 0) {
+			age_cycles_++;
+		}
+	}
+
+	/*! Fills the frame to send with Derived::encode()
+	 * @param[out] frame	frame, its flag is the flag of the PDO
+	 */
+	void transmit(CANMsg& frame)
+	{
+		frame.COBId = COBId_;
+		frame.rtr = 0;
+		frame.fdf = 0;
+		frame.brs = 0;
+		frame.length = (unsigned char) static_cast<Derived*>(this)->encode(frame.value);
+		frame.flag = flag_;
+	}
+
+protected:
+	//! COB-ID
+	int COBId_;
+	//! index of the frame
+	int SMId_;
+	//! 1 if the PDO is sent
+	char flag_;
+	//! true if the PDO was received in this cycle
+	bool isUpdated_;
+	//! calls of receive() since the last new frame, -1 if never received
+	int64_t age_cycles_;
+	//! sequence number of the last received frame
+	unsigned int sequence_;
+};
+
+//! PDOs of a bus that are stored by value
+/*! The PDOs are stored in a std::tuple, hence the loops over the PDOs are unrolled at
+ * compile time and the calls of decode() and encode() can be inlined.
+ *
+ * @ingroup robotCAN
+ */
+template <typename... PDOs>
+class StaticPDOTable {
+public:
+	//! number of PDOs
+	static const size_t size = sizeof...(PDOs);
+
+	/*! Constructor
+	 * @param pdos	PDOs, they are copied
+	 */
+	StaticPDOTable(const PDOs&... pdos): pdos_(pdos...) {}
+
+	//! Gets a PDO
+	template <size_t I>
+	typename std::tuple_element<I, std::tuple<PDOs...> >::type& get()
+	{
+		return std::get<I>(pdos_);
+	}
+
+	/*! Passes the received frames to the PDOs
+	 * @param frames	frames indexed by the shared memory ID
+	 */
+	void ingest(Span<const CANMsg> frames)
+	{
+		ingestFrom<0>(frames);
+	}
+
+	/*! Fills the frames of the PDOs
+	 * @param frames	frames indexed by the shared memory ID
+	 * @param slots		slot map in which the flagged frames are marked dirty, may be NULL
+	 */
+	void emit(Span<CANMsg> frames, SlotMap* slots = NULL)
+	{
+		emitFrom<0>(frames, slots);
+	}
+
+	/*! Adds the COB-IDs of the PDOs to a filter
+	 * @param filter	acceptance filter
+	 */
+	void addCOBIds(AcceptanceFilter* filter)
+	{
+		addCOBIdsFrom<0>(filter);
+	}
+
+	/*! Allocates the slots of the PDOs with SlotMap::autoSlot and records the others
+	 * @param slots	slot map
+	 */
+	void assignSlots(SlotMap* slots)
+	{
+		assignSlotsFrom<0>(slots);
+	}
+
+private:
+	template <size_t I>
+	typename std::enable_if<(I < sizeof...(PDOs))>::type ingestFrom(Span<const CANMsg> frames)
+	{
+		const int smId = std::get<I>(pdos_).getSMId();
+		if (smId >= 0 && (size_t)smId < frames.size()) {
+			std::get<I>(pdos_).receive(frames[smId]);
+		}
+		ingestFrom<I+1>(frames);
+	}
+
+	template <size_t I>
+	typename std::enable_if<(I == sizeof...(PDOs))>::type ingestFrom(Span<const CANMsg>) {}
+
+	template <size_t I>
+	typename std::enable_if<(I < sizeof...(PDOs))>::type emitFrom(Span<CANMsg> frames, SlotMap* slots)
+	{
+		const int smId = std::get<I>(pdos_).getSMId();
+		if (smId >= 0 && (size_t)smId < frames.size()) {
+			std::get<I>(pdos_).transmit(frames[smId]);
+			if (slots != NULL && frames[smId].flag) {
+				slots->setDirty(smId);
+			}
+		}
+		emitFrom<I+1>(frames, slots);
+	}
+
+	template <size_t I>
+	typename std::enable_if<(I == sizeof...(PDOs))>::type emitFrom(Span<CANMsg>, SlotMap*) {}
+
+	template <size_t I>
+	typename std::enable_if<(I < sizeof...(PDOs))>::type addCOBIdsFrom(AcceptanceFilter* filter)
+	{
+		filter->addCOBId(std::get<I>(pdos_).getCOBId());
+		addCOBIdsFrom<I+1>(filter);
+	}
+
+	template <size_t I>
+	typename std::enable_if<(I == sizeof...(PDOs))>::type addCOBIdsFrom(AcceptanceFilter*) {}
+
+	template <size_t I>
+	typename std::enable_if<(I < sizeof...(PDOs))>::type assignSlotsFrom(SlotMap* slots)
+	{
+		if (std::get<I>(pdos_).getSMId() == SlotMap::autoSlot) {
+			std::get<I>(pdos_).setSMId(slots->allocate(std::get<I>(pdos_).getCOBId()));
+		} else {
+			slots->assign(std::get<I>(pdos_).getCOBId(), std::get<I>(pdos_).getSMId());
+		}
+		assignSlotsFrom<I+1>(slots);
+	}
+
+	template <size_t I>
+	typename std::enable_if<(I == sizeof...(PDOs))>::type assignSlotsFrom(SlotMap*) {}
+
+	//! PDOs
+	std::tuple<PDOs...> pdos_;
+};
+
+//! Bus with a statically typed configuration of PDOs
+/*! The PDOs of the tables are processed without virtual calls before the PDOs of the
+ * PDO managers, which may still hold PDOs that are added at run time (e.g. heartbeats).
+ * SDOs, heartbeats and emergency objects are handled by Bus.
+ * 	typedef StaticPDOTable<TxPDOPosition, TxPDOPosition> TxPDOs;
+ * 	typedef StaticPDOTable<RxPDOVelocity, RxPDOVelocity> RxPDOs;
+ * 	StaticBus<TxPDOs, RxPDOs> bus(0, TxPDOs(TxPDOPosition(1, 0), TxPDOPosition(2, 1)),
+ * 			RxPDOs(RxPDOVelocity(1, 0), RxPDOVelocity(2, 1)));
+ * 	bus.ingest(received);
+ * 	bus.getStaticTxPDOs().get<0>().getPosition();
+ *
+ * The PDOs may use SlotMap::autoSlot, their slots are allocated by the constructor.
+ *
+ * The static PDOs are processed by the overrides of Bus::ingestPDOs() and Bus::emitPDOs(),
+ * hence also through a pointer to Bus, e.g. by CyclePipeline or BusManager.
+ *
+ * pdoBenchmark compares the cycle of 8 TxPDOs and 8 RxPDOs on a bus with virtual PDOs and
+ * on a StaticBus, see doc/README.txt for the measured times.
+ *
+ * @ingroup robotCAN, bus
+ */
+template <typename TxPDOTable, typename RxPDOTable>
+class StaticBus: public Bus {
+public:
+	/*! Constructor
+	 * @param iBus		index of the bus
+	 * @param txPDOs	PDOs that are received from the nodes
+	 * @param rxPDOs	PDOs that are sent to the nodes
+	 */
+	StaticBus(int iBus, const TxPDOTable& txPDOs, const RxPDOTable& rxPDOs)
+	:Bus(iBus),
+	 txPDOs_(txPDOs),
+	 rxPDOs_(rxPDOs)
+	{
+		txPDOs_.assignSlots(getReceiveSlots());
+		rxPDOs_.assignSlots(getSendSlots());
+	}
+
+	//! Destructor
+	virtual ~StaticBus() {}
+
+	/*! Gets the PDOs that are received from the nodes
+	 * @return PDOs
+	 */
+	TxPDOTable& getStaticTxPDOs() { return txPDOs_; }
+
+	/*! Gets the PDOs that are sent to the nodes
+	 * @return PDOs
+	 */
+	RxPDOTable& getStaticRxPDOs() { return rxPDOs_; }
+
+	/*! Passes the frames to the static TxPDOs and to the TxPDOs of the manager, see Bus::ingestPDOs()
+	 * @param frames	received frames indexed by the shared memory ID
+	 */
+	virtual void ingestPDOs(Span<const CANMsg> frames)
+	{
+		txPDOs_.ingest(frames);
+		Bus::ingestPDOs(frames);
+	}
+
+	/*! Writes the RxPDOs of the manager and the static RxPDOs, see Bus::emitPDOs()
+	 * The static RxPDOs are sent if the RxPDO manager is sending.
+	 * @param frames	frames indexed by the shared memory ID
+	 */
+	virtual void emitPDOs(Span<CANMsg> frames)
+	{
+		Bus::emitPDOs(frames);
+		if (getRxPDOManager()->isSending()) {
+			rxPDOs_.emit(frames, getSendSlots());
+		}
+	}
+
+protected:
+	virtual void addReceivedCOBIds(AcceptanceFilter* filter)
+	{
+		Bus::addReceivedCOBIds(filter);
+		txPDOs_.addCOBIds(filter);
+	}
+
+private:
+	//! PDOs that are received from the nodes
+	TxPDOTable txPDOs_;
+	//! PDOs that are sent to the nodes
+	RxPDOTable rxPDOs_;
+};
+
+#endif /* STATICBUS_HPP_ */
@@ -0,0 +1,98 @@
+/*!
+ * @file 	TimingStatistics.hpp
+ * @brief	Minimum, mean, maximum and percentiles of durations
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef TIMINGSTATISTICS_HPP_
+#define TIMINGSTATISTICS_HPP_
+
+#include <stdint.h>
+#include <atomic>
+
+//! Statistics of durations with a logarithmic histogram
+/*! The durations are counted in buckets whose width grows with the duration, each
+ * power of two is split into 8 buckets. A percentile is the upper bound of its
+ * bucket, hence it is at most 12.5 % too large. Minimum, mean and maximum are exact.
+ *
+ * add() is invoked by one thread (e.g. the cycle), the getters may be invoked by other
+ * threads. They do not allocate memory.
+ *
+ * @ingroup robotCAN
+ */
+class TimingStatistics {
+public:
+	//! Constructor
+	TimingStatistics();
+
+	//! Destructor
+	virtual ~TimingStatistics();
+
+	/*! Adds a duration
+	 * @param duration_ns	duration [ns], negative durations are counted as 0
+	 */
+	void add(int64_t duration_ns);
+
+	//! Removes all durations
+	void reset();
+
+	/*! Gets the number of durations
+	 * @return number of durations
+	 */
+	uint64_t getCount() const;
+
+	/*! Gets the shortest duration
+	 * @return duration [ns], 0 if there is none
+	 */
+	int64_t getMin_ns() const;
+
+	/*! Gets the mean duration
+	 * @return duration [ns], 0 if there is none
+	 */
+	int64_t getMean_ns() const;
+
+	/*! Gets the longest duration
+	 * @return duration [ns], 0 if there is none
+	 */
+	int64_t getMax_ns() const;
+
+	/*! Gets the duration that a percentage of the durations did not exceed
+	 * @param percent	percentage (0-100), e.g. 99 for the 99th percentile
+	 * @return duration [ns], 0 if there is none
+	 */
+	int64_t getPercentile_ns(double percent) const;
+
+private:
+	//! buckets per power of two
+	static const int nSubBuckets = 8;
+	//! number of buckets, durations up to 2^48 ns
+	static const int nBuckets = 48*nSubBuckets;
+
+	/*! Gets the bucket of a duration
+	 * @param duration_ns	duration [ns]
+	 * @return index of the bucket
+	 */
+	static int getBucket(int64_t duration_ns);
+
+	/*! Gets the upper bound of a bucket
+	 * @param bucket	index of the bucket
+	 * @return duration [ns]
+	 */
+	static int64_t getUpperBound(int bucket);
+
+	//! number of durations per bucket
+	std::atomic<uint32_t> buckets_[nBuckets];
+	//! number of durations
+	std::atomic<uint64_t> count_;
+	//! sum of the durations [ns]
+	std::atomic<int64_t> sum_ns_;
+	//! shortest duration [ns]
+	std::atomic<int64_t> min_ns_;
+	//! longest duration [ns]
+	std::atomic<int64_t> max_ns_;
+};
+
+#endif /* TIMINGSTATISTICS_HPP_ */
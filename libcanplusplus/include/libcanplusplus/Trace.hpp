@@ -0,0 +1,58 @@
+/*!
+ * @file 	Trace.hpp
+ * @brief	Statically defined tracepoints (USDT) of the frames, SDOs and cycles
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#ifndef TRACE_HPP_
+#define TRACE_HPP_
+
+/*! The library is built with the tracepoints if sys/sdt.h (systemtap-sdt-dev) is found,
+ * see the option TRACEPOINTS. A tracepoint is a nop instruction and a note in the ELF
+ * file, hence it costs nothing until a tracer attaches to it:
+ * 	bpftrace -l 'usdt:/path/to/liblibcanplusplus.so:libcanplusplus:*'
+ * 	bpftrace -e 'usdt:liblibcanplusplus.so:libcanplusplus:cycle_end { @[arg0] = hist(arg2); }'
+ * 	perf buildid-cache --add liblibcanplusplus.so && perf record -e sdt_libcanplusplus:frame_rx
+ *
+ * Tracepoints of the provider libcanplusplus and their arguments:
+ * 	frame_rx		iBus, COB-ID, length		SocketCANChannel::receive(), msg_handler of the examples
+ * 	frame_tx		iBus, COB-ID, length		SocketCANChannel::send(), bus routine of the examples
+ * 	pdo_decode		COB-ID, length, sequence	CANOpenMsg::setCANMsg(), StaticPDO::receive()
+ * 	sdo_send		COB-ID, index, subindex		SDOMsg::sendMsg(), once per request
+ * 	sdo_complete	COB-ID, index, subindex		SDOMsg::receiveMsg()
+ * 	sdo_abort		iBus, node ID, abort code	SDOManager
+ * 	sdo_timeout		iBus, node ID, COB-ID		SDOManager
+ * 	nmt_state		node ID, old state, state	TxPDONMT, 255 if the state was unknown
+ * 	cycle_start		iBus, cycle, jitter [ns]	CycleExecutor
+ * 	phase_end		iBus, phase, duration [ns]	CycleExecutor, see CycleExecutor::Phase
+ * 	cycle_end		iBus, cycle, duration [ns]	CycleExecutor
+ *
+ * The arguments are integers. They are evaluated in every call, hence they must be
+ * cheap, e.g. members that are already in a register.
+ *
+ * @ingroup robotCAN
+ */
+
+#ifdef LIBCANPLUSPLUS_TRACEPOINTS
+
+#include <sys/sdt.h>
+
+#define LIBCANPLUSPLUS_TRACE1(name, arg1) \
+	DTRACE_PROBE1(libcanplusplus, name, arg1)
+#define LIBCANPLUSPLUS_TRACE2(name, arg1, arg2) \
+	DTRACE_PROBE2(libcanplusplus, name, arg1, arg2)
+#define LIBCANPLUSPLUS_TRACE3(name, arg1, arg2, arg3) \
+	DTRACE_PROBE3(libcanplusplus, name, arg1, arg2, arg3)
+
+#else
+
+#define LIBCANPLUSPLUS_TRACE1(name, arg1) do {} while (0)
+#define LIBCANPLUSPLUS_TRACE2(name, arg1, arg2) do {} while (0)
+#define LIBCANPLUSPLUS_TRACE3(name, arg1, arg2, arg3) do {} while (0)
+
+#endif
+
+#endif /* TRACE_HPP_ */
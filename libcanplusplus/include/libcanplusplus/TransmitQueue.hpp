@@ -0,0 +1,95 @@
+/*!
+ * @file 	TransmitQueue.hpp
+ * @brief	Queue of CAN messages ordered by the priority of their COB-ID
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef TRANSMITQUEUE_HPP_
+#define TRANSMITQUEUE_HPP_
+
+#include <stdint.h>
+#include "libcanplusplus/CANMsg.hpp"
+
+//! Queue of CAN messages that are waiting for transmission
+/*! The messages are ordered like the arbitration on the bus, i.e. the message with
+ * the lowest COB-ID is sent first. Messages with the same COB-ID keep their order.
+ * The queue is a binary heap with a fixed capacity and does not allocate memory.
+ *
+ * @ingroup robotCAN, bus
+ */
+class TransmitQueue {
+public:
+	//! maximum number of queued messages
+	static const int capacity = 128;
+
+	//! Constructor
+	TransmitQueue();
+
+	//! Destructor
+	virtual ~TransmitQueue();
+
+	/*! Adds a message
+	 * @param msg	CAN message
+	 * @return false if the queue is full
+	 */
+	bool push(const CANMsg& msg);
+
+	/*! Removes the message with the highest priority
+	 * @param msg	removed message
+	 * @return false if the queue is empty
+	 */
+	bool pop(CANMsg* msg);
+
+	/*! Adds the message that was removed last with its original priority again
+	 * Is used if the message could not be handed to the CAN driver.
+	 * @return false if the queue is full or no message was removed
+	 */
+	bool requeue();
+
+	/*! Gets the message with the highest priority without removing it
+	 * @return message or NULL if the queue is empty
+	 */
+	const CANMsg* top() const;
+
+	//! Removes all messages
+	void clear();
+
+	/*! Gets the number of queued messages
+	 * @return number of messages
+	 */
+	int size() const;
+
+	/*! Checks if the queue is empty
+	 * @return true if no message is queued
+	 */
+	bool isEmpty() const;
+
+private:
+	//! queued message
+	struct Entry {
+		//! COB-ID in the upper and sequence number in the lower 32 bits
+		uint64_t key;
+		//! message
+		CANMsg msg;
+	};
+
+	//! Inserts an entry into the heap
+	bool insert(const Entry& entry);
+
+	//! heap
+	Entry entries_[capacity];
+	//! number of queued messages
+	int size_;
+	//! sequence number of the next message
+	uint32_t sequence_;
+
+	//! message that was removed last
+	Entry last_;
+	//! true if last_ can be requeued
+	bool hasLast_;
+};
+
+#endif /* TRANSMITQUEUE_HPP_ */
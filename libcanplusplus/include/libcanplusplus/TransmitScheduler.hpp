@@ -0,0 +1,238 @@
+/*!
+ * @file 	TransmitScheduler.hpp
+ * @brief	Time-slotted transmission of the CAN messages of a bus within a cycle
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#ifndef TRANSMITSCHEDULER_HPP_
+#define TRANSMITSCHEDULER_HPP_
+
+#include <stdint.h>
+#include <atomic>
+#include "libcanplusplus/TransmitQueue.hpp"
+
+//! Places the messages of a cycle at configured offsets within the cycle window
+/*! The messages are sorted into three slots: RxPDOs, SYNC and SDOs (including NMT).
+ * Each slot starts at its offset relative to the beginning of the cycle, the slots
+ * are served in the order of their offsets. A slot is only served when all slots
+ * with a smaller offset are empty, i.e. the RxPDOs always precede the SYNC.
+ * Within a slot, the frames are sent in the order of their COB-ID like on the bus.
+ *
+ * The number of SDO frames per cycle can be limited. SDO frames that exceed the limit
+ * or are not released until the end of the cycle are kept for the next cycle, whereas
+ * the remaining RxPDOs and SYNCs of a cycle are dropped since they are outdated.
+ * Hence a burst of configuration SDOs does not delay the control messages. The bus
+ * does not count the SDO timeouts while SDO frames are held back.
+ *
+ * The transmit queue of the CAN controller is modeled by the transmission time of the
+ * frames at the configured bitrate. A frame is only released if the number of frames
+ * that are still queued in the controller is smaller than the transmit queue depth.
+ * Thus the controller never runs out of transmit buffers and the frames are spread
+ * over the cycle.
+ *
+ * Usage in the bus routine:
+ * 	scheduler->beginCycle();
+ * 	for (all flagged messages) scheduler->addFrame(msg);
+ * 	while (scheduler->hasFrames()) {
+ * 		if (scheduler->getFrame(now_us, &msg)) {
+ * 			if (!send(msg)) scheduler->requeueFrame();
+ * 		}
+ * 		else sleep until scheduler->getNextReleaseTime();
+ * 	}
+ *
+ * The scheduler is not thread-safe and should only be used by the bus routine.
+ *
+ * @ingroup robotCAN, bus
+ */
+class TransmitScheduler {
+public:
+	//! Slots of a cycle
+	enum class Slots : uint8_t {
+		rxPDO = 0,
+		sync = 1,
+		sdo = 2
+	};
+
+	//! number of slots
+	static const int nSlots = 3;
+
+	//! maximum number of frames per slot
+	static const int maxFramesPerSlot = TransmitQueue::capacity;
+
+	//! Constructor
+	TransmitScheduler();
+
+	//! Destructor
+	virtual ~TransmitScheduler();
+
+	/*! Sets the duration of a cycle
+	 * @param cycleTime_us	cycle time [us]
+	 */
+	void setCycleTime(unsigned int cycleTime_us);
+
+	/*! Sets the bitrate that is used to compute the transmission time of a frame
+	 * @param bitrate	bitrate [bit/s]
+	 */
+	void setBitrate(unsigned int bitrate);
+
+	/*! Sets the bitrate of the data phase of CAN FD frames with bit rate switch
+	 * @param bitrate	data bitrate [bit/s]
+	 */
+	void setDataBitrate(unsigned int bitrate);
+
+	/*! Sets the number of frames the CAN controller can buffer for transmission
+	 * @param depth		transmit queue depth, at least 1
+	 */
+	void setTxQueueDepth(unsigned int depth);
+
+	/*! Sets an additional idle time after each frame
+	 * @param spacing_us	idle time between two frames [us]
+	 */
+	void setFrameSpacing(unsigned int spacing_us);
+
+	/*! Sets the start of a slot
+	 * @param slot		slot
+	 * @param offset_us	offset relative to the beginning of the cycle [us]
+	 */
+	void setSlotOffset(Slots slot, unsigned int offset_us);
+
+	/*! Limits the number of SDO frames (including NMT) that are sent per cycle
+	 * @param maxFrames	maximum number of frames per cycle, 0 for no limit
+	 */
+	void setMaxSDOFramesPerCycle(unsigned int maxFrames);
+
+	/*! Gets the slot of a message
+	 * @param COBId		COB-ID of the message
+	 * @return slot
+	 */
+	static Slots getSlot(int COBId);
+
+	/*! Gets the transmission time of a frame on the bus in the worst case (with bit stuffing)
+	 * @param length	number of data bytes
+	 * @return transmission time [us]
+	 */
+	unsigned int getFrameTime(int length) const;
+
+	/*! Gets the transmission time of a classic or CAN FD frame in the worst case
+	 * @param msg	CAN message
+	 * @return transmission time [us]
+	 */
+	unsigned int getFrameTime(const CANMsg& msg) const;
+
+	/*! Starts a new cycle
+	 * RxPDOs and SYNCs that were not released in the last cycle are dropped,
+	 * SDOs are kept.
+	 */
+	void beginCycle();
+
+	/*! Adds a frame to the slot given by its COB-ID
+	 * @param msg	CAN message
+	 * @return false if the slot is full
+	 */
+	bool addFrame(const CANMsg& msg);
+
+	/*! Adds a frame to a slot
+	 * @param slot	slot
+	 * @param msg	CAN message
+	 * @return false if the slot is full
+	 */
+	bool addFrame(Slots slot, const CANMsg& msg);
+
+	/*! Checks if there are frames left in this cycle
+	 * @return true if a frame is pending
+	 */
+	bool hasFrames() const;
+
+	/*! Gets the next frame that can be sent
+	 * @param time_us	time since the beginning of the cycle [us]
+	 * @param msg		released frame
+	 * @return true if a frame is released
+	 */
+	bool getFrame(unsigned int time_us, CANMsg* msg);
+
+	/*! Puts the frame that was released last back into its slot
+	 * Is used if the CAN driver has no free transmit buffer. The frame keeps its priority
+	 * and the next frame is released one frame time later.
+	 * @return false if the slot is full
+	 */
+	bool requeueFrame();
+
+	/*! Gets the time at which the next frame is released
+	 * @return time since the beginning of the cycle [us], the cycle time if no frame is pending
+	 */
+	unsigned int getNextReleaseTime() const;
+
+	/*! Gets the number of frames that could not be released within their cycle
+	 * @return number of dropped frames
+	 */
+	unsigned int getNumberOfDroppedFrames() const;
+
+	/*! Gets the number of frames that were put back because the driver was busy
+	 * @return number of requeued frames
+	 */
+	unsigned int getNumberOfRequeuedFrames() const;
+
+	/*! Gets the number of SDO frames that were kept from the last cycle, e.g. because of
+	 * the limit of SDO frames per cycle
+	 * May be invoked by another thread, e.g. the main routine that counts the SDO timeouts.
+	 * @return number of SDO frames that were not sent when the current cycle began
+	 */
+	unsigned int getNumberOfHeldSDOFrames() const;
+
+	/*! Sets the index of the bus whose metrics are counted
+	 * @param iBus	index of the bus, -1 to disable the counting
+	 */
+	void setBusIndex(int iBus);
+
+private:
+	//! Gets the index of the first slot with pending frames, -1 if all slots are empty
+	int getActiveSlot() const;
+
+	//! frames of a slot
+	struct Slot {
+		//! offset relative to the beginning of the cycle [us]
+		unsigned int offset_us;
+		//! frames ordered by their COB-ID
+		TransmitQueue frames;
+	};
+
+	//! slots
+	Slot slots_[nSlots];
+	//! indices of the slots sorted by their offsets
+	int order_[nSlots];
+
+	//! cycle time [us]
+	unsigned int cycleTime_us_;
+	//! bitrate [bit/s]
+	unsigned int bitrate_;
+	//! bitrate of the data phase of CAN FD frames [bit/s]
+	unsigned int dataBitrate_;
+	//! transmit queue depth of the CAN controller
+	unsigned int txQueueDepth_;
+	//! idle time between two frames [us]
+	unsigned int frameSpacing_us_;
+	//! maximum number of SDO frames per cycle, 0 for no limit
+	unsigned int maxSDOFramesPerCycle_;
+	//! number of SDO frames released in this cycle
+	unsigned int nSDOFrames_;
+	//! number of SDO frames that were kept from the last cycle
+	std::atomic<unsigned int> nHeldSDOFrames_;
+	//! slot of the frame that was released last, -1 if none
+	int iLastSlot_;
+
+	//! time at which the controller has sent all released frames, relative to the beginning of the cycle [us]
+	int64_t busFreeTime_us_;
+
+	//! number of frames that were not released within their cycle
+	unsigned int nDroppedFrames_;
+	//! number of frames that were put back
+	unsigned int nRequeuedFrames_;
+
+	//! index of the bus in the metrics, -1 if not counted
+	int iBus_;
+};
+
+#endif /* TRANSMITSCHEDULER_HPP_ */
@@ -7,27 +7,70 @@
 
 #pragma once
 
-#include <chrono>
-
 #include "CANOpenMsg.hpp"
+#include "HeartbeatMonitor.hpp"
 
 namespace canopen {
 
 //////////////////////////////////////////////////////////////////////////////
 class RxPDOSync: public CANOpenMsg {
 public:
-  RxPDOSync(int SMId):CANOpenMsg(0x80, SMId) {
+  RxPDOSync(int SMId):CANOpenMsg(0x80, SMId),
+  counterOverflow_(0),
+  counter_(0)
+  {
     flag_ = 1;
   };
   virtual ~RxPDOSync() {};
+
+  /*! Adds the SYNC counter (1..overflow) to the SYNC
+   * With the counter, a TxPDO with the transmission type n (every n-th SYNC) starts at
+   * the SYNC whose counter equals its SYNC start value, i.e. the phases of slow TxPDOs
+   * can be staggered. The overflow should be a common multiple of the transmission
+   * types and has to be written to 0x1019 of the nodes.
+   * @param overflow  overflow value of the counter (2-240), 0 for a SYNC without counter
+   */
+  void setCounterOverflow(int overflow) {
+    counterOverflow_ = (overflow > 1) ? overflow : 0;
+    counter_ = 0;
+    value_[0] = 0;
+    length_[0] = (counterOverflow_ > 0) ? 1 : 0;
+  }
+
+  /*! Gets the overflow value of the SYNC counter
+   * @return overflow value, 0 if the SYNC has no counter
+   */
+  int getCounterOverflow() const {
+    return counterOverflow_;
+  }
+
+  virtual void getCANMsg(CANMsg *canDataDes) {
+    if (counterOverflow_ > 0) {
+      counter_ = counter_ % counterOverflow_ + 1;
+      value_[0] = counter_;
+    }
+    CANOpenMsg::getCANMsg(canDataDes);
+  }
+
+private:
+  //! overflow value of the SYNC counter, 0 if the SYNC has no counter
+  int counterOverflow_;
+  //! counter of the last SYNC
+  int counter_;
 };
 
 //////////////////////////////////////////////////////////////////////////////
 class TxPDONMT: public CANOpenMsg {
 public:
-  TxPDONMT(int nodeId):CANOpenMsg(TxNMT+nodeId, 0),
+  /*! Constructor
+   * @param nodeId  ID of the CAN node
+   * @param SMId    shared memory index of the NMT state, SlotMap::noSlot if it is not received
+   */
+  TxPDONMT(int nodeId, int SMId = 0):CANOpenMsg(TxNMT+nodeId, SMId),
+  nodeId_(nodeId),
   state_(-1),
-  timeReceived_()
+  nBootups_(0),
+  heartbeatMonitor_(nullptr)
   {
     //0x00 - Bootup; 0x04 - Stopped; 0x05 - Operational; 0x7F - Pre-Operational.
   };
@@ -36,11 +79,15 @@ public:
   {
   };
 
-  virtual void processMsg()
-  {
-    timeReceived_ = std::chrono::steady_clock::now();
-    state_ = (uint8_t)(value_[0]);
-  };
+  //! Decodes the NMT state and notifies the heartbeat consumer, see canopen_pdos.cpp
+  virtual void processMsg();
+
+  /*! Sets the heartbeat consumer that is notified about every received heartbeat
+   * @param heartbeatMonitor	heartbeat consumer of the bus
+   */
+  void setHeartbeatMonitor(HeartbeatMonitor* heartbeatMonitor) {
+    heartbeatMonitor_ = heartbeatMonitor;
+  }
 
   bool isBootup() const
   {
@@ -66,12 +113,16 @@ public:
 	  return state_;
   }
 
-  const std::chrono::time_point<std::chrono::steady_clock>& getTime() const {
-    return timeReceived_;
+  //! Gets the number of received boot-up messages
+  unsigned int getNumberOfBootups() const {
+    return nBootups_;
   }
+
 private:
+  int nodeId_;
   uint8_t state_;
-  std::chrono::time_point<std::chrono::steady_clock> timeReceived_;
+  unsigned int nBootups_;
+  HeartbeatMonitor* heartbeatMonitor_;
 
 };
 } // namespace canopen
@@ -2,7 +2,7 @@
 
 #include <libcanplusplus/SDOWriteMsg.hpp>
 #include <libcanplusplus/SDOReadMsg.hpp>
-#include <ros/ros.h>
+#include <libcanplusplus/Logger.hpp>
 
 #define WRITE_1_BYTE 0x2f
 #define WRITE_2_BYTE 0x2b
@@ -20,91 +20,68 @@ public:
   virtual ~SDOWrite(){};
 protected:
 
-  bool getErrorName(std::string& name) const {
+  /*! Gets the name of the SDO abort code of the received message
+   * @return name or NULL if the code is unknown
+   */
+  const char* getErrorName() const {
     const int32_t error = (inputMsg_->getValue()[4] + (inputMsg_->getValue()[5]<<8) + (inputMsg_->getValue()[6]<<16) + (inputMsg_->getValue()[7]<<24));
     switch (error) {
       case 0x00000000:
-        name = std::string{"No Communication Error"};
-        break;
+        return "No Communication Error";
       case 0x05030000:
-        name = std::string{"Toggle Error"};
-        break;
+        return "Toggle Error";
       case 0x05040000:
-        name = std::string{"SDO Time Out"};
-        break;
+        return "SDO Time Out";
       case 0x05040001:
-        name = std::string{"Client / Server Specifier Error"};
-        break;
+        return "Client / Server Specifier Error";
       case 0x05040005:
-        name = std::string{"Out of Memory Error"};
-        break;
+        return "Out of Memory Error";
       case 0x06010000:
-        name = std::string{"Access Error"};
-        break;
+        return "Access Error";
       case 0x06010001:
-        name = std::string{"Write Only"};
-        break;
+        return "Write Only";
       case 0x06010002:
-        name = std::string{"Read Only"};
-        break;
+        return "Read Only";
       case 0x06020000:
-        name = std::string{"Object does not exist Error"};
-        break;
+        return "Object does not exist Error";
       case 0x06040041:
-        name = std::string{"PDO mapping Error"};
-        break;
+        return "PDO mapping Error";
       case 0x06040042:
-        name = std::string{"PDO Length Error"};
-        break;
+        return "PDO Length Error";
       case 0x06040043:
-        name = std::string{"General Parameter Error"};
-        break;
+        return "General Parameter Error";
       case 0x06040047:
-        name = std::string{"General internal Incompatibility Error"};
-        break;
+        return "General internal Incompatibility Error";
       case 0x06060000:
-        name = std::string{"Hardware Error"};
-        break;
+        return "Hardware Error";
       case 0x06070010:
-        name = std::string{"Service Parameter Error"};
-        break;
+        return "Service Parameter Error";
       case 0x06070012:
-        name = std::string{"Service Parameter too long Error"};
-        break;
+        return "Service Parameter too long Error";
       case 0x06070013:
-        name = std::string{"Service Parameter too short Error"};
-        break;
+        return "Service Parameter too short Error";
       case 0x06090011:
-        name = std::string{"Object Subindex Error"};
-        break;
+        return "Object Subindex Error";
       case 0x06090030:
-        name = std::string{"Value Range Error"};
-        break;
+        return "Value Range Error";
       case 0x06090031:
-        name = std::string{"Value too high Error"};
-        break;
+        return "Value too high Error";
       case 0x06090032:
-        name = std::string{"Value too low Error"};
-        break;
+        return "Value too low Error";
       case 0x06090036:
-        name = std::string{"Maximum less Minimum Error"};
-        break;
+        return "Maximum less Minimum Error";
       case 0x08000000:
-        name = std::string{"General Error"};
-        break;
+        return "General Error";
       case 0x08000020:
-        name = std::string{"Transfer or store Error"};
-        break;
+        return "Transfer or store Error";
       case 0x08000021:
-        name = std::string{"Local Control Error"};
-        break;
+        return "Local Control Error";
       case 0x08000022:
-          name = std::string{"Wrong Device State"};
-          break;
+          return "Wrong Device State";
       default:
-        return false;
+        break;
     }
-    return true;
+    return NULL;
   }
 
 
@@ -114,12 +91,12 @@ protected:
       if (inputMsg_->getValue()[0] == 0x80)
       {
 
-       std::string errorName;
-        if (getErrorName(errorName)) {
-          ROS_ERROR("SDO Write Error: Node: 0x%02X: %s! Error code: %02X%02X%02X%02X, "
+        const char* errorName = getErrorName();
+        if (errorName != NULL) {
+          Logger::log(LogLevels::error, "SDO Write Error: Node: 0x%02X: %s! Error code: %02X%02X%02X%02X, "
               "COB ID: %04X, Index: 0x%02X%02X, Subindex: 0x%02X, CAN message: %02X %02X %02X %02X %02X %02X %02X %02X",
                      outputMsg_->getCOBId()-0x600,
-                     errorName.c_str(),
+                     errorName,
                      inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4],
                      outputMsg_->getCOBId(),
                      inputMsg_->getValue()[2], inputMsg_->getValue()[1], // index
@@ -128,7 +105,7 @@ protected:
         }
         else {
           ///< Check for recData[0]==0x60! recData[0]==0x80 means an error happend
-          ROS_ERROR("SDO Error: Can't write! Error code: %02X%02X%02X%02X Output msg: COB ID: %04X Data: %02X %02X %02X %02X %02X %02X %02X %02X",
+          Logger::log(LogLevels::error, "SDO Error: Can't write! Error code: %02X%02X%02X%02X Output msg: COB ID: %04X Data: %02X %02X %02X %02X %02X %02X %02X %02X",
                         inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4],
                         outputMsg_->getCOBId(),
                         inputMsg_->getValue()[0], inputMsg_->getValue()[1], inputMsg_->getValue()[2], inputMsg_->getValue()[3], inputMsg_->getValue()[4], inputMsg_->getValue()[5], inputMsg_->getValue()[6], inputMsg_->getValue()[7]);
@@ -174,7 +151,10 @@ protected:
       if (inputMsg_->getValue()[0] == 0x80)
       {
         ///< Check for recData[0]==0x60! recData[0]==0x80 means an error happend
-        printf("\e[0;31mAN ERROR HAPPEND. CAN'T WRITE CHECK CHAP. 12.3 of the firmware specification for the error code: %02X%02X%02X%02X\n\e[0m",inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4]);
+        Logger::log(LogLevels::error, "SDO Error: Can't read! Error code: %02X%02X%02X%02X Output msg: COB ID: %04X, Index: 0x%02X%02X, Subindex: 0x%02X",
+                    inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4],
+                    outputMsg_->getCOBId(),
+                    outputMsg_->getValue()[2], outputMsg_->getValue()[1], outputMsg_->getValue()[3]);
       }
     }
 
@@ -530,6 +510,16 @@ public:
   virtual ~SDOSetCOBIDSYNC(){};
 };
 
+//////////////////////////////////////////////////////////////////////////////
+class SDOSetSyncCounterOverflow: public SDOWrite
+{
+public:
+  SDOSetSyncCounterOverflow(int inSDOSMId, int outSDOSMId, int nodeId, int overflow):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_1_BYTE, 0x1019, 0x00, overflow)
+  {};
+  virtual ~SDOSetSyncCounterOverflow(){};
+};
+
 //////////////////////////////////////////////////////////////////////////////
 class SDOSaveAllParameters: public SDOWrite
 {
@@ -608,6 +598,26 @@ public:
   virtual ~SDOTxPDO1SetTransmissionType(){};
 };
 
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO1SetEventTimer: public SDOWrite
+{
+public:
+  SDOTxPDO1SetEventTimer(int inSDOSMId, int outSDOSMId, int nodeId, int time_ms):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1800, 0x05, time_ms)
+  {};
+  virtual ~SDOTxPDO1SetEventTimer(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO1SetSyncStartValue: public SDOWrite
+{
+public:
+  SDOTxPDO1SetSyncStartValue(int inSDOSMId, int outSDOSMId, int nodeId, int value):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_1_BYTE, 0x1800, 0x06, value)
+  {};
+  virtual ~SDOTxPDO1SetSyncStartValue(){};
+};
+
 //////////////////////////////////////////////////////////////////////////////
 class SDOTxPDO1SetMapping: public SDOWrite
 {
@@ -661,6 +671,36 @@ public:
   virtual ~SDOTxPDO2SetTransmissionType(){};
 };
 
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO2SetInhibitTime: public SDOWrite
+{
+public:
+  SDOTxPDO2SetInhibitTime(int inSDOSMId, int outSDOSMId, int nodeId, int time_100us):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1801, 0x03, time_100us)
+  {};
+  virtual ~SDOTxPDO2SetInhibitTime(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO2SetEventTimer: public SDOWrite
+{
+public:
+  SDOTxPDO2SetEventTimer(int inSDOSMId, int outSDOSMId, int nodeId, int time_ms):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1801, 0x05, time_ms)
+  {};
+  virtual ~SDOTxPDO2SetEventTimer(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO2SetSyncStartValue: public SDOWrite
+{
+public:
+  SDOTxPDO2SetSyncStartValue(int inSDOSMId, int outSDOSMId, int nodeId, int value):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_1_BYTE, 0x1801, 0x06, value)
+  {};
+  virtual ~SDOTxPDO2SetSyncStartValue(){};
+};
+
 //////////////////////////////////////////////////////////////////////////////
 class SDOTxPDO2SetMapping: public SDOWrite
 {
@@ -712,6 +752,36 @@ public:
   virtual ~SDOTxPDO3SetTransmissionType(){};
 };
 
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO3SetInhibitTime: public SDOWrite
+{
+public:
+  SDOTxPDO3SetInhibitTime(int inSDOSMId, int outSDOSMId, int nodeId, int time_100us):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1802, 0x03, time_100us)
+  {};
+  virtual ~SDOTxPDO3SetInhibitTime(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO3SetEventTimer: public SDOWrite
+{
+public:
+  SDOTxPDO3SetEventTimer(int inSDOSMId, int outSDOSMId, int nodeId, int time_ms):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1802, 0x05, time_ms)
+  {};
+  virtual ~SDOTxPDO3SetEventTimer(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO3SetSyncStartValue: public SDOWrite
+{
+public:
+  SDOTxPDO3SetSyncStartValue(int inSDOSMId, int outSDOSMId, int nodeId, int value):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_1_BYTE, 0x1802, 0x06, value)
+  {};
+  virtual ~SDOTxPDO3SetSyncStartValue(){};
+};
+
 //////////////////////////////////////////////////////////////////////////////
 class SDOTxPDO3SetMapping: public SDOWrite
 {
@@ -763,6 +833,36 @@ public:
   virtual ~SDOTxPDO4SetTransmissionType(){};
 };
 
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO4SetInhibitTime: public SDOWrite
+{
+public:
+  SDOTxPDO4SetInhibitTime(int inSDOSMId, int outSDOSMId, int nodeId, int time_100us):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1803, 0x03, time_100us)
+  {};
+  virtual ~SDOTxPDO4SetInhibitTime(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO4SetEventTimer: public SDOWrite
+{
+public:
+  SDOTxPDO4SetEventTimer(int inSDOSMId, int outSDOSMId, int nodeId, int time_ms):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1803, 0x05, time_ms)
+  {};
+  virtual ~SDOTxPDO4SetEventTimer(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO4SetSyncStartValue: public SDOWrite
+{
+public:
+  SDOTxPDO4SetSyncStartValue(int inSDOSMId, int outSDOSMId, int nodeId, int value):
+    SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_1_BYTE, 0x1803, 0x06, value)
+  {};
+  virtual ~SDOTxPDO4SetSyncStartValue(){};
+};
+
 //////////////////////////////////////////////////////////////////////////////
 class SDOTxPDO4SetMapping: public SDOWrite
 {
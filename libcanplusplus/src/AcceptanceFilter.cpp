@@ -0,0 +1,210 @@
+/*!
+ * @file 	AcceptanceFilter.cpp
+ * @brief	Acceptance filters for the COB-IDs that are received on a bus
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include <set>
+#include "libcanplusplus/AcceptanceFilter.hpp"
+
+//! number of bits of a COB-ID
+static const int nBits = 11;
+
+//! Counts the set bits
+static int countBits(uint32_t x)
+{
+	int n = 0;
+	for (; x != 0; x &= x - 1) {
+		n++;
+	}
+	return n;
+}
+
+AcceptanceFilter::AcceptanceFilter()
+{
+
+}
+
+AcceptanceFilter::~AcceptanceFilter()
+{
+
+}
+
+void AcceptanceFilter::clear()
+{
+	COBIds_.reset();
+	filters_.clear();
+}
+
+void AcceptanceFilter::addCOBId(int COBId)
+{
+	if (COBId >= 0 && COBId < nCOBIds) {
+		COBIds_.set(COBId);
+	}
+}
+
+bool AcceptanceFilter::hasCOBId(int COBId) const
+{
+	return COBId >= 0 && COBId < nCOBIds && COBIds_.test(COBId);
+}
+
+int AcceptanceFilter::compute(int maxFilters)
+{
+	filters_.clear();
+
+	/* an implicant is stored as (don't care bits << 11) | COB-ID,
+	 * the COB-ID is zero at the don't care bits */
+	std::set<uint32_t> implicants;
+	for (int i=0; i<nCOBIds; i++) {
+		if (COBIds_.test(i)) {
+			implicants.insert(i);
+		}
+	}
+
+	/* merge implicants that differ in one bit until only prime implicants are left */
+	std::vector<uint32_t> primes;
+	while (!implicants.empty()) {
+		std::set<uint32_t> merged;
+		std::set<uint32_t> used;
+		for (std::set<uint32_t>::const_iterator it=implicants.begin(); it!=implicants.end(); ++it) {
+			const uint32_t dontCare = *it >> nBits;
+			const uint32_t id = *it & fullMask;
+			for (int iBit=0; iBit<nBits; iBit++) {
+				const uint32_t bit = 1 << iBit;
+				if ((dontCare & bit) || (id & bit)) {
+					continue;
+				}
+				if (implicants.count(*it | bit)) {
+					merged.insert(((dontCare | bit) << nBits) | id);
+					used.insert(*it);
+					used.insert(*it | bit);
+				}
+			}
+		}
+		for (std::set<uint32_t>::const_iterator it=implicants.begin(); it!=implicants.end(); ++it) {
+			if (!used.count(*it)) {
+				primes.push_back(*it);
+			}
+		}
+		implicants.swap(merged);
+	}
+
+	/* greedy cover: take the prime implicant with the most uncovered COB-IDs */
+	std::bitset<nCOBIds> uncovered = COBIds_;
+	while (uncovered.any()) {
+		int iBest = -1;
+		int nBest = 0;
+		for (unsigned int i=0; i<primes.size(); i++) {
+			const uint32_t dontCare = primes[i] >> nBits;
+			const uint32_t id = primes[i] & fullMask;
+			int n = 0;
+			uint32_t subset = dontCare;
+			do {
+				n += uncovered.test(id | subset);
+				subset = (subset - 1) & dontCare;
+			} while (subset != dontCare);
+			if (n > nBest) {
+				iBest = i;
+				nBest = n;
+			}
+		}
+
+		const uint32_t dontCare = primes[iBest] >> nBits;
+		const uint32_t id = primes[iBest] & fullMask;
+		uint32_t subset = dontCare;
+		do {
+			uncovered.reset(id | subset);
+			subset = (subset - 1) & dontCare;
+		} while (subset != dontCare);
+
+		Filter filter;
+		filter.id = id;
+		filter.mask = ~dontCare & fullMask;
+		filters_.push_back(filter);
+	}
+
+	/* merge the pair of filters that accepts the least number of COB-IDs */
+	while (maxFilters > 0 && (int)filters_.size() > maxFilters) {
+		unsigned int iBest = 0;
+		unsigned int jBest = 1;
+		int nBest = nBits + 1;
+		for (unsigned int i=0; i<filters_.size(); i++) {
+			for (unsigned int j=i+1; j<filters_.size(); j++) {
+				const uint32_t mask = filters_[i].mask & filters_[j].mask & ~(filters_[i].id ^ filters_[j].id);
+				const int n = nBits - countBits(mask);
+				if (n < nBest) {
+					iBest = i;
+					jBest = j;
+					nBest = n;
+				}
+			}
+		}
+
+		Filter filter;
+		filter.mask = filters_[iBest].mask & filters_[jBest].mask & ~(filters_[iBest].id ^ filters_[jBest].id);
+		filter.id = filters_[iBest].id & filter.mask;
+
+		/* remove the filters that are covered by the merged filter */
+		std::vector<Filter> filters;
+		filters.push_back(filter);
+		for (unsigned int i=0; i<filters_.size(); i++) {
+			const bool isCovered = ((filters_[i].mask & filter.mask) == filter.mask)
+									&& ((filters_[i].id ^ filter.id) & filter.mask) == 0;
+			if (!isCovered) {
+				filters.push_back(filters_[i]);
+			}
+		}
+		filters_.swap(filters);
+	}
+
+	return filters_.size();
+}
+
+bool AcceptanceFilter::accepts(int COBId) const
+{
+	for (unsigned int i=0; i<filters_.size(); i++) {
+		if (((COBId ^ filters_[i].id) & filters_[i].mask) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int AcceptanceFilter::getNumberOfFilters() const
+{
+	return filters_.size();
+}
+
+const AcceptanceFilter::Filter& AcceptanceFilter::getFilter(int index) const
+{
+	return filters_[index];
+}
+
+void AcceptanceFilter::getSJA1000DualFilter(unsigned char code[4], unsigned char mask[4]) const
+{
+	Filter filters[2];
+	for (int i=0; i<2; i++) {
+		if (filters_.empty()) {
+			/* only the NMT command is accepted, which is never sent by a node */
+			filters[i].id = 0;
+			filters[i].mask = fullMask;
+		} else {
+			filters[i] = filters_[i < (int)filters_.size() ? i : 0];
+		}
+	}
+
+	/* filter 1: ID.10-3, ID.2-0 and RTR, first data byte (don't care) */
+	code[0] = (filters[0].id >> 3) & 0xFF;
+	code[1] = (filters[0].id & 0x07) << 5;
+	mask[0] = (~filters[0].mask >> 3) & 0xFF;
+	mask[1] = ((~filters[0].mask & 0x07) << 5) | 0x1F;
+
+	/* filter 2: ID.10-3, ID.2-0 and RTR */
+	code[2] = (filters[1].id >> 3) & 0xFF;
+	code[3] = (filters[1].id & 0x07) << 5;
+	mask[2] = (~filters[1].mask >> 3) & 0xFF;
+	mask[3] = ((~filters[1].mask & 0x07) << 5) | 0x1F;
+}
@@ -0,0 +1,133 @@
+/*!
+ * @file 	AllocationGuard.cpp
+ * @brief	Detection of heap allocations in the real-time cycle
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <atomic>
+#include <new>
+#include "libcanplusplus/AllocationGuard.hpp"
+
+namespace {
+
+//! true if the thread must not allocate
+thread_local bool isThreadSealed = false;
+
+//! action on an allocation of the thread
+thread_local AllocationGuard::Actions threadAction = AllocationGuard::Actions::report;
+
+//! number of allocations of sealed threads
+std::atomic<unsigned int> nAllocations(0);
+
+//! Writes a message to stderr without allocating memory
+void writeMessage(const char* msg)
+{
+	size_t length = 0;
+	while (msg[length] != '\0') {
+		length++;
+	}
+	ssize_t rc = write(STDERR_FILENO, msg, length);
+	(void)rc;
+}
+
+}
+
+bool AllocationGuard::isEnabled()
+{
+#ifdef LIBCANPLUSPLUS_ALLOCATION_GUARD
+	return true;
+#else
+	return false;
+#endif
+}
+
+void AllocationGuard::seal(Actions action)
+{
+	threadAction = action;
+	isThreadSealed = true;
+}
+
+void AllocationGuard::unseal()
+{
+	isThreadSealed = false;
+}
+
+bool AllocationGuard::isSealed()
+{
+	return isThreadSealed;
+}
+
+unsigned int AllocationGuard::getNumberOfAllocations()
+{
+	return nAllocations.load(std::memory_order_relaxed);
+}
+
+void AllocationGuard::notifyAllocation(size_t size)
+{
+	if (!isThreadSealed) {
+		return;
+	}
+	const unsigned int n = nAllocations.fetch_add(1, std::memory_order_relaxed);
+	if (threadAction == Actions::abort) {
+		writeMessage("AllocationGuard: heap allocation in a sealed thread, aborting!\n");
+		abort();
+	}
+	if (n == 0) {
+		writeMessage("AllocationGuard: heap allocation in a sealed thread!\n");
+	}
+}
+
+#ifdef LIBCANPLUSPLUS_ALLOCATION_GUARD
+/* replacement of the global allocation functions */
+
+void* operator new(size_t size)
+{
+	AllocationGuard::notifyAllocation(size);
+	void* p = malloc(size > 0 ? size : 1);
+	if (p == NULL) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	AllocationGuard::notifyAllocation(size);
+	return malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return operator new(size, std::nothrow);
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	free(p);
+}
+#endif
@@ -0,0 +1,182 @@
+/*!
+ * @file 	BootManager.cpp
+ * @brief	Parallel boot-up of all nodes of a bus
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include "libcanplusplus/BootManager.hpp"
+#include "libcanplusplus/canopen_sdos.hpp"
+#include "libcanplusplus/Logger.hpp"
+
+BootManager::BootManager(Bus* bus, int inSDOSMId, int outSDOSMId)
+:bus_(bus),
+ inSDOSMId_(inSDOSMId),
+ outSDOSMId_(outSDOSMId),
+ state_(States::idle),
+ counter_(0),
+ bootupTimeout_(1000),
+ bootupDelay_(500)
+{
+
+}
+
+BootManager::~BootManager()
+{
+
+}
+
+void BootManager::setBootupTimeout(int nCycles)
+{
+	bootupTimeout_ = nCycles;
+}
+
+void BootManager::setBootupDelay(int nCycles)
+{
+	bootupDelay_ = nCycles;
+}
+
+void BootManager::setBootCompleteCallback(const Callback& callback)
+{
+	callback_ = callback;
+}
+
+void BootManager::start()
+{
+	DeviceManager* deviceManager = bus_->getDeviceManager();
+
+	nodes_.resize(deviceManager->getSize());
+	for (int i=0; i<deviceManager->getSize(); i++) {
+		Device* device = deviceManager->getDevice(i);
+		nodes_[i].state = NodeStates::waitingForBootup;
+		nodes_[i].nBootups = device->txPDONMT_->getNumberOfBootups();
+		nodes_[i].nTimeouts = 0;
+		nodes_[i].nAborts = 0;
+		if (device->txPDONMT_->getSMId() < 0) {
+			Logger::log(LogLevels::warn, "BootManager: The NMT state of node %d is not received, it is configured after %d cycles.",
+					device->getNodeId(), bootupDelay_);
+		}
+		device->sdos_.clear();
+		device->hasFailedSDO_ = false;
+		device->canState_ = Device::CANStates::initializing;
+	}
+
+	/* all nodes answer with their boot-up message */
+	bus_->getSDOManager()->addSDO(new canopen::SDONMTResetCommunication(inSDOSMId_, outSDOSMId_, 0));
+
+	counter_ = 0;
+	state_ = States::booting;
+}
+
+void BootManager::update()
+{
+	SDOManager* sdoManager = bus_->getSDOManager();
+	DeviceManager* deviceManager = bus_->getDeviceManager();
+
+	switch (state_) {
+	case States::booting:
+	{
+		/* wait until the reset was sent */
+		if (sdoManager->getNumberOfSDOs(0) > 0) {
+			break;
+		}
+		counter_++;
+
+		bool isDone = true;
+		bool isSuccess = true;
+		for (unsigned int i=0; i<nodes_.size(); i++) {
+			Device* device = deviceManager->getDevice(i);
+			Node& node = nodes_[i];
+
+			switch (node.state) {
+			case NodeStates::waitingForBootup:
+				if (device->txPDONMT_->getNumberOfBootups() != node.nBootups
+						|| (device->txPDONMT_->getSMId() < 0 && counter_ >= bootupDelay_)) {
+					/* the node is identified, configure it */
+					device->canState_ = Device::CANStates::preOperational;
+					node.nTimeouts = sdoManager->getNumberOfTimeouts(device->getNodeId());
+					node.nAborts = sdoManager->getNumberOfAborts(device->getNodeId());
+					device->configureDevice();
+					node.state = NodeStates::configuring;
+				} else if (counter_ > bootupTimeout_) {
+					Logger::log(LogLevels::error, "BootManager: Node %d did not boot!", device->getNodeId());
+					node.state = NodeStates::failed;
+				}
+				break;
+			case NodeStates::configuring:
+				if (sdoManager->getNumberOfSDOs(device->getNodeId()) == 0) {
+					/* a node that did not answer or rejected a configuration SDO is not started */
+					if (sdoManager->getNumberOfTimeouts(device->getNodeId()) != node.nTimeouts
+							|| sdoManager->getNumberOfAborts(device->getNodeId()) != node.nAborts) {
+						Logger::log(LogLevels::error, "BootManager: Node %d could not be configured!", device->getNodeId());
+						node.state = NodeStates::failed;
+					} else {
+						node.state = NodeStates::configured;
+					}
+				}
+				break;
+			default:
+				break;
+			}
+
+			if (node.state == NodeStates::waitingForBootup || node.state == NodeStates::configuring) {
+				isDone = false;
+			} else if (node.state == NodeStates::failed) {
+				isSuccess = false;
+			}
+		}
+
+		if (!isDone) {
+			break;
+		}
+		if (!isSuccess) {
+			finish(false);
+			break;
+		}
+
+		/* bring all nodes to operational at once */
+		sdoManager->addSDO(new canopen::SDONMTStartRemoteNode(inSDOSMId_, outSDOSMId_, 0));
+		state_ = States::starting;
+		break;
+	}
+	case States::starting:
+		if (sdoManager->getNumberOfSDOs(0) == 0) {
+			for (unsigned int i=0; i<nodes_.size(); i++) {
+				deviceManager->getDevice(i)->canState_ = Device::CANStates::operational;
+				nodes_[i].state = NodeStates::operational;
+			}
+			finish(true);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+BootManager::States BootManager::getState() const
+{
+	return state_;
+}
+
+bool BootManager::isBootComplete() const
+{
+	return state_ == States::complete;
+}
+
+BootManager::NodeStates BootManager::getNodeState(int iDevice) const
+{
+	if (iDevice < 0 || iDevice >= static_cast<int>(nodes_.size())) {
+		return NodeStates::failed;
+	}
+	return nodes_[iDevice].state;
+}
+
+void BootManager::finish(bool isSuccess)
+{
+	state_ = isSuccess ? States::complete : States::failed;
+	if (callback_) {
+		callback_(isSuccess);
+	}
+}
@@ -8,14 +8,42 @@
  *
  */
 
+#include <chrono>
+
 #include "libcanplusplus/Bus.hpp"
+#include "libcanplusplus/CANOpenMsg.hpp"
+#include "libcanplusplus/canopen_pdos.hpp"
+#include "libcanplusplus/Logger.hpp"
 
-Bus::Bus(int iBus):iBus_(iBus)
+Bus::Bus(int iBus)
+:isAutomaticSlots_(false),
+ syncCounterOverflow_(0),
+ iBus_(iBus),
+ nTxPDOs_(-1),
+ nTxFrames_(0),
+ nRxPDOs_(-1),
+ nRxFrames_(0)
 {
 	rxPDOManager_ = new PDOManager;
 	txPDOManager_ = new PDOManager;
 	SDOManager_ = new SDOManager(iBus);
 	deviceManager_ = new DeviceManager(this);
+	jointStateBuffer_ = new JointStateBuffer;
+	EMCYManager_ = new EMCYManager;
+	heartbeatMonitor_ = new HeartbeatMonitor;
+	transmitScheduler_ = new TransmitScheduler;
+	acceptanceFilter_ = new AcceptanceFilter;
+	receiveSlots_ = new SlotMap;
+	sendSlots_ = new SlotMap;
+	receiveDispatcher_ = new ReceiveDispatcher;
+
+	rxPDOManager_->setSlotMap(sendSlots_);
+	txPDOManager_->setSlotMap(receiveSlots_);
+	SDOManager_->setSlotMaps(receiveSlots_, sendSlots_);
+
+	EMCYManager_->setBusIndex(iBus);
+	heartbeatMonitor_->setBusIndex(iBus);
+	transmitScheduler_->setBusIndex(iBus);
 }
 
 Bus::~Bus()
@@ -24,6 +52,14 @@ Bus::~Bus()
 	delete txPDOManager_;
 	delete SDOManager_;
 	delete deviceManager_;
+	delete jointStateBuffer_;
+	delete EMCYManager_;
+	delete heartbeatMonitor_;
+	delete transmitScheduler_;
+	delete acceptanceFilter_;
+	delete receiveSlots_;
+	delete sendSlots_;
+	delete receiveDispatcher_;
 }
 PDOManager* Bus::getRxPDOManager()
 {
@@ -45,7 +81,204 @@ DeviceManager* Bus::getDeviceManager()
 	return deviceManager_;
 }
 
+JointStateBuffer* Bus::getJointStateBuffer()
+{
+	return jointStateBuffer_;
+}
+
+EMCYManager* Bus::getEMCYManager()
+{
+	return EMCYManager_;
+}
+
+HeartbeatMonitor* Bus::getHeartbeatMonitor()
+{
+	return heartbeatMonitor_;
+}
+
+TransmitScheduler* Bus::getTransmitScheduler()
+{
+	return transmitScheduler_;
+}
+
+AcceptanceFilter* Bus::getAcceptanceFilter()
+{
+	return acceptanceFilter_;
+}
+
+SlotMap* Bus::getReceiveSlots()
+{
+	return receiveSlots_;
+}
+
+SlotMap* Bus::getSendSlots()
+{
+	return sendSlots_;
+}
+
+ReceiveDispatcher* Bus::getReceiveDispatcher()
+{
+	return receiveDispatcher_;
+}
+
+void Bus::setAutomaticSlots(bool isAutomatic)
+{
+	isAutomaticSlots_ = isAutomatic;
+}
+
+bool Bus::hasAutomaticSlots()
+{
+	return isAutomaticSlots_;
+}
+
+bool Bus::setSyncCounterOverflow(int overflow)
+{
+	if (syncCounterOverflow_ > 0 && overflow != syncCounterOverflow_) {
+		Logger::log(LogLevels::error, "Bus %d: The SYNC counter overflows at %d, cannot change it to %d!",
+				iBus_, syncCounterOverflow_, overflow);
+		return false;
+	}
+	syncCounterOverflow_ = overflow;
+	canopen::RxPDOSync* sync = dynamic_cast<canopen::RxPDOSync*>(rxPDOManager_->getPDOWithCOBId(canopen::RxPDOSyncId));
+	if (sync != NULL && sync->getCounterOverflow() != overflow) {
+		sync->setCounterOverflow(overflow);
+	}
+	return true;
+}
+
+int Bus::getSyncCounterOverflow() const
+{
+	return syncCounterOverflow_;
+}
+
+int Bus::updateAcceptanceFilter(int maxFilters)
+{
+	acceptanceFilter_->clear();
+	addReceivedCOBIds(acceptanceFilter_);
+	return acceptanceFilter_->compute(maxFilters);
+}
+
+void Bus::addReceivedCOBIds(AcceptanceFilter* filter)
+{
+	/* TxPDOs and heartbeats */
+	for (int i=0; i<txPDOManager_->getSize(); i++) {
+		filter->addCOBId(txPDOManager_->getPDO(i)->getCOBId());
+	}
+	/* SDO responses */
+	for (int i=0; i<deviceManager_->getSize(); i++) {
+		filter->addCOBId(canopen::TxSDOId + deviceManager_->getDevice(i)->getNodeId());
+	}
+	/* PDOs that are decoded in the receive thread */
+	receiveDispatcher_->addCOBIds(filter);
+	/* emergency objects of the node IDs 1-127 */
+	for (int nodeId=1; nodeId<128; nodeId++) {
+		if (EMCYManager_->isRegistered(nodeId)) {
+			filter->addCOBId(canopen::TxEMCYId + nodeId);
+		}
+	}
+}
+
 int Bus::iBus()
 {
 	return iBus_;
 }
+
+void Bus::ingest(Span<const CANMsg> frames)
+{
+	ingestPDOs(frames);
+	ingestSDOs(frames);
+}
+
+void Bus::ingestPDOs(Span<const CANMsg> frames)
+{
+	/* TxPDOs, an empty frame only resets the updated flag of its PDO */
+	if (txPDOManager_->getSize() != nTxPDOs_ || frames.size() != nTxFrames_) {
+		updatePDOSlots(txPDOManager_, txPDOSlots_, frames.size());
+		nTxPDOs_ = txPDOManager_->getSize();
+		nTxFrames_ = frames.size();
+	}
+	/* one time for the receive timeouts and the heartbeats of the cycle */
+	const int64_t time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	for (size_t i=0; i<txPDOSlots_.size(); i++) {
+		txPDOSlots_[i].pdo->setCANMsg(&frames[txPDOSlots_[i].smId], time_us);
+	}
+
+	/* heartbeat deadlines, after the heartbeats of this cycle restarted them */
+	heartbeatMonitor_->tick(time_us);
+}
+
+void Bus::ingestSDOs(Span<const CANMsg> frames)
+{
+	/* responses to the SDOs of all nodes that were sent */
+	const int nSDOs = SDOManager_->getReceiveSDOs(sdos_, SDOManager::maxNodes);
+	/* an SDO that the scheduler held back may not be on the bus yet, its timeout is not counted */
+	const bool isHeld = transmitScheduler_->getNumberOfHeldSDOFrames() > 0;
+	for (int i=0; i<nSDOs; i++) {
+		const int smId = sdos_[i]->getInputMsg()->getSMId();
+		if (smId >= 0 && (size_t)smId < frames.size()
+				&& (frames[smId].flag || !isHeld)) {
+			SDOManager_->receiveResponse(sdos_[i], &frames[smId]);
+		}
+	}
+}
+
+void Bus::emit(Span<CANMsg> frames)
+{
+	emitPDOs(frames);
+	emitSDOs(frames);
+}
+
+void Bus::emitPDOs(Span<CANMsg> frames)
+{
+	/* only the frames of the last emit() are flagged */
+	for (int slot=sendSlots_->getNextDirtySlot(0); slot>=0 && (size_t)slot<frames.size(); slot=sendSlots_->getNextDirtySlot(slot+1)) {
+		frames[slot].flag = 0;
+	}
+	sendSlots_->clearDirty();
+
+	/* RxPDOs */
+	if (rxPDOManager_->isSending()) {
+		if (rxPDOManager_->getSize() != nRxPDOs_ || frames.size() != nRxFrames_) {
+			updatePDOSlots(rxPDOManager_, rxPDOSlots_, frames.size());
+			nRxPDOs_ = rxPDOManager_->getSize();
+			nRxFrames_ = frames.size();
+		}
+		for (size_t i=0; i<rxPDOSlots_.size(); i++) {
+			const int smId = rxPDOSlots_[i].smId;
+			rxPDOSlots_[i].pdo->getCANMsg(&frames[smId]);
+			if (frames[smId].flag) {
+				sendSlots_->setDirty(smId);
+			}
+		}
+	}
+}
+
+void Bus::emitSDOs(Span<CANMsg> frames)
+{
+	/* first SDO of each node */
+	const int nSDOs = SDOManager_->getSendSDOs(sdos_, SDOManager::maxNodes);
+	for (int i=0; i<nSDOs; i++) {
+		const int smId = sdos_[i]->getOutputMsg()->getSMId();
+		if (smId >= 0 && (size_t)smId < frames.size()) {
+			sdos_[i]->sendMsg(&frames[smId]);
+			if (frames[smId].flag) {
+				sendSlots_->setDirty(smId);
+			}
+		}
+	}
+}
+
+void Bus::updatePDOSlots(PDOManager* pdoManager, std::vector<PDOSlot>& slots, size_t nFrames)
+{
+	slots.clear();
+	slots.reserve(pdoManager->getSize());
+	for (int i=0; i<pdoManager->getSize(); i++) {
+		PDOSlot slot;
+		slot.pdo = pdoManager->getPDO(i);
+		slot.smId = slot.pdo->getSMId();
+		if (slot.smId >= 0 && (size_t)slot.smId < nFrames) {
+			slots.push_back(slot);
+		}
+	}
+}
@@ -10,9 +10,7 @@
 
 #include "libcanplusplus/BusManager.hpp"
 
-#include <stdexcept>
-#include <boost/lexical_cast.hpp>
-#include <iostream>
+#include "libcanplusplus/Logger.hpp"
 
 BusManager::BusManager()
 {
@@ -36,16 +34,9 @@ int BusManager::getSize()
 
 Bus*  BusManager::getBus(unsigned int index)
 {
-	try {
-		if (index >= buses_.size()) {
-			std::string error = "BusManager: Could not get bus with index "
-								+ boost::lexical_cast<std::string>(index) + "!";
-			throw std::out_of_range(error);
-		}
-		return &(buses_[index]);
-
-	} catch (std::exception& e) {
-		std::cout << e.what() << std::endl;
+	if (index >= buses_.size()) {
+		Logger::log(LogLevels::error, "BusManager: Could not get bus with index %u!", index);
+		return NULL;
 	}
-	return NULL;
+	return &(buses_[index]);
 }
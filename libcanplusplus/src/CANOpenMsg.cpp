@@ -10,14 +10,40 @@
 
 #include <assert.h>
 #include "libcanplusplus/CANOpenMsg.hpp"
+#include "libcanplusplus/Trace.hpp"
 
 CANOpenMsg::CANOpenMsg(int COBId, int SMId)
+:CANOpenMsg(COBId, SMId, classicValue_, classicLength_, stackSize)
+{
+
+}
+
+CANOpenMsg::CANOpenMsg(int COBId, int SMId, int* value, int* length, int stackSize)
 :COBId_(COBId),
  SMId_(SMId),
  flag_(0),
- rtr_(0)
+ value_(value),
+ length_(length),
+ rtr_(0),
+ fdf_(false),
+ brs_(true),
+ stackSize_(stackSize),
+ transmissionPolicy_(TransmissionPolicies::always),
+ refreshPeriod_(0),
+ nSkippedCycles_(0),
+ hasSentPayload_(false),
+ sentLength_(0),
+ rateDivisor_(1),
+ ratePhase_(0),
+ nCalls_(0),
+ receiveTimeout_ms_(0),
+ isUpdated_(false),
+ receiveTime_us_(-1),
+ updateTime_us_(0),
+ age_cycles_(-1),
+ sequence_(0)
 {
-	for (int k=0;k<8; k++) {
+	for (int k=0;k<stackSize_; k++) {
 	  value_[k] = 0;
 		length_[k] = 0;
 	}
@@ -30,25 +56,97 @@ CANOpenMsg::~CANOpenMsg()
 }
 
 
+void* CANOpenMsg::operator new(size_t size)
+{
+	return MemoryPool::allocateBlock(getPool(), size);
+}
+
+void CANOpenMsg::operator delete(void* p)
+{
+	MemoryPool::deallocateBlock(p);
+}
+
+void CANOpenMsg::reservePool(unsigned int nMsgs)
+{
+	getPool().reserve(nMsgs);
+}
+
+MemoryPool& CANOpenMsg::getPool()
+{
+	/* derived PDOs with a few more members fit into a block, the pool is never destroyed
+	 * since messages of global objects are released at exit */
+	static MemoryPool* pool = new MemoryPool(sizeof(CANOpenMsg) + 128);
+	return *pool;
+}
+
 void CANOpenMsg::getCANMsg(CANMsg *transmitMessage)
 {
 	int k = 0;
-	transmitMessage->length = 0;
-	for(int l=0; l<8; l++) {
-		transmitMessage->length = transmitMessage->length + length_[l];
-		assert(transmitMessage->length<=8);
+	for(int l=0; l<stackSize_; l++) {
+		assert(k+length_[l]<=CANMsg::maxLength);
 		for(int j=0; j<length_[l]; j++) {
-			assert(k<8);
 			transmitMessage->value[k] = ((value_[l]>>(8*j)) & 0x000000ff);
 			k++;
 		}
 	}
+
+	if (fdf_ || k > CANMsg::maxClassicLength) {
+		/* pad to the next length a CAN FD frame can have */
+		const int length = CANMsg::getPaddedLength(k);
+		for (; k<length; k++) {
+			transmitMessage->value[k] = 0;
+		}
+		transmitMessage->fdf = 1;
+		transmitMessage->brs = brs_;
+	} else {
+		transmitMessage->fdf = 0;
+		transmitMessage->brs = 0;
+	}
+	transmitMessage->length = k;
 	transmitMessage->COBId = COBId_;
 	transmitMessage->flag = flag_;
 	transmitMessage->rtr = rtr_;
+
+	const bool isDue = (nCalls_ % rateDivisor_ == ratePhase_);
+	nCalls_++;
+	if (!isDue) {
+		transmitMessage->flag = 0;
+		return;
+	}
+
+	if (flag_ && !isTransmissionRequired(transmitMessage)) {
+		transmitMessage->flag = 0;
+	}
 }
 
-void CANOpenMsg::setCANMsg(CANMsg *receiveMessage)
+bool CANOpenMsg::isTransmissionRequired(const CANMsg* transmitMessage)
+{
+	if (transmissionPolicy_ == TransmissionPolicies::always || rtr_) {
+		return true;
+	}
+
+	bool isChanged = !hasSentPayload_ || transmitMessage->length != sentLength_;
+	for (int i=0; !isChanged && i<transmitMessage->length; i++) {
+		isChanged = (transmitMessage->value[i] != sentValue_[i]);
+	}
+
+	nSkippedCycles_++;
+	const bool isRefreshRequired = (transmissionPolicy_ == TransmissionPolicies::onChangeOrRefresh
+									&& nSkippedCycles_ >= refreshPeriod_);
+	if (!isChanged && !isRefreshRequired) {
+		return false;
+	}
+
+	sentLength_ = transmitMessage->length;
+	for (int i=0; i<transmitMessage->length; i++) {
+		sentValue_[i] = transmitMessage->value[i];
+	}
+	hasSentPayload_ = true;
+	nSkippedCycles_ = 0;
+	return true;
+}
+
+void CANOpenMsg::setCANMsg(const CANMsg *receiveMessage, int64_t time_us)
 {
 //  ROS_INFO("CANOpenMsg:setCANMsg COBID: 0x%02X length: %d Data: %02X %02X %02X %02X %02X %02X %02X %02X",
 //           receiveMessage->COBId,
@@ -57,16 +155,36 @@ void CANOpenMsg::setCANMsg(CANMsg *receiveMessage)
 //           receiveMessage->value[4], receiveMessage->value[5], receiveMessage->value[6], receiveMessage->value[7]
 //            );
 
-	length_[0] = receiveMessage->length;
-	for(int i=0; i<receiveMessage->length; i++)
+	updateTime_us_ = time_us;
+	if (!receiveMessage->flag
+			|| (receiveMessage->sequence != 0 && receiveMessage->sequence == sequence_)) {
+		/* no new message, keep the values */
+		isUpdated_ = false;
+		if (age_cycles_ >= 0) {
+			age_cycles_++;
+		}
+		return;
+	}
+	isUpdated_ = true;
+	receiveTime_us_ = time_us;
+	age_cycles_ = 0;
+	sequence_ = receiveMessage->sequence;
+
+	/* a classic message keeps the first 8 bytes of a CAN FD frame */
+	const int length = (receiveMessage->length < stackSize_) ? receiveMessage->length : stackSize_;
+	length_[0] = length;
+	for(int i=0; i<length; i++)
 	{
 		value_[i] = receiveMessage->value[i];
 	}
 	//COBId_ = receiveMessage->COBId; // leads to problems
 	flag_ = 1;
 	rtr_ = receiveMessage->rtr;
+	fdf_ = receiveMessage->fdf;
+	brs_ = receiveMessage->brs;
 
 	// Hook to process the message
+	LIBCANPLUSPLUS_TRACE3(pdo_decode, COBId_, receiveMessage->length, receiveMessage->sequence);
 	processMsg();
 }
 
@@ -105,6 +223,11 @@ int* CANOpenMsg::getLength()
 	return length_;
 }
 
+int CANOpenMsg::getStackSize() const
+{
+	return stackSize_;
+}
+
 void CANOpenMsg::setFlag(int flag)
 {
 	flag_ = flag;
@@ -120,17 +243,138 @@ void CANOpenMsg::setCOBId(int COBId)
 	COBId_ = COBId;
 }
 
+void CANOpenMsg::setSMId(int SMId)
+{
+	SMId_ = SMId;
+}
+
 
-void CANOpenMsg::setValue(int* value)
+void CANOpenMsg::setValue(int* value, int size)
 {
-	for (int k=0; k<8; k++) {
+	assert(size<=stackSize_);
+	for (int k=0; k<size; k++) {
 	  value_[k] = value[k];
 	}
 }
 
-void CANOpenMsg::setLength(int* length)
+void CANOpenMsg::setLength(int* length, int size)
 {
-	for (int k=0; k<8; k++) {
+	assert(size<=stackSize_);
+	for (int k=0; k<size; k++) {
 		length_[k] = length[k];
 	}
 }
+
+void CANOpenMsg::setFD(bool fdf, bool brs)
+{
+	fdf_ = fdf;
+	brs_ = brs;
+}
+
+bool CANOpenMsg::isFD()
+{
+	return fdf_;
+}
+
+void CANOpenMsg::setTransmissionPolicy(TransmissionPolicies policy, unsigned int refreshPeriod)
+{
+	transmissionPolicy_ = policy;
+	refreshPeriod_ = refreshPeriod;
+	forceTransmission();
+}
+
+CANOpenMsg::TransmissionPolicies CANOpenMsg::getTransmissionPolicy()
+{
+	return transmissionPolicy_;
+}
+
+void CANOpenMsg::forceTransmission()
+{
+	hasSentPayload_ = false;
+	nSkippedCycles_ = 0;
+}
+
+void CANOpenMsg::setRateDivisor(unsigned int divisor, unsigned int phase)
+{
+	rateDivisor_ = divisor > 0 ? divisor : 1;
+	ratePhase_ = phase % rateDivisor_;
+}
+
+unsigned int CANOpenMsg::getRateDivisor() const
+{
+	return rateDivisor_;
+}
+
+unsigned int CANOpenMsg::getRatePhase() const
+{
+	return ratePhase_;
+}
+
+void CANOpenMsg::setReceiveTimeout(unsigned int timeout_ms)
+{
+	receiveTimeout_ms_ = timeout_ms;
+}
+
+bool CANOpenMsg::isUpdated() const
+{
+	return isUpdated_;
+}
+
+bool CANOpenMsg::isStale() const
+{
+	if (receiveTimeout_ms_ == 0) {
+		return false;
+	}
+	return receiveTime_us_ < 0 || updateTime_us_ - receiveTime_us_ > static_cast<int64_t>(receiveTimeout_ms_)*1000;
+}
+
+int64_t CANOpenMsg::getAge_ms() const
+{
+	if (receiveTime_us_ < 0) {
+		return -1;
+	}
+	return (updateTime_us_ - receiveTime_us_)/1000;
+}
+
+int64_t CANOpenMsg::getAge_cycles() const
+{
+	return age_cycles_;
+}
+
+unsigned int CANOpenMsg::getSequence() const
+{
+	return sequence_;
+}
+
+CANOpenFDMsg::CANOpenFDMsg(int COBId, int SMId)
+:CANOpenMsg(COBId, SMId, fdValue_, fdLength_, stackSize)
+{
+
+}
+
+CANOpenFDMsg::~CANOpenFDMsg()
+{
+
+}
+
+void* CANOpenFDMsg::operator new(size_t size)
+{
+	return MemoryPool::allocateBlock(getPool(), size);
+}
+
+void CANOpenFDMsg::operator delete(void* p)
+{
+	MemoryPool::deallocateBlock(p);
+}
+
+void CANOpenFDMsg::reservePool(unsigned int nMsgs)
+{
+	getPool().reserve(nMsgs);
+}
+
+MemoryPool& CANOpenFDMsg::getPool()
+{
+	/* see CANOpenMsg::getPool() */
+	static MemoryPool* pool = new MemoryPool(sizeof(CANOpenFDMsg) + 128);
+	return *pool;
+}
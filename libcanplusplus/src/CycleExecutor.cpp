@@ -0,0 +1,217 @@
+/*!
+ * @file 	CycleExecutor.cpp
+ * @brief	Periodic cycle of named phases with timing statistics
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include "libcanplusplus/CycleExecutor.hpp"
+#include "libcanplusplus/Logger.hpp"
+#include "libcanplusplus/Metrics.hpp"
+#include "libcanplusplus/Trace.hpp"
+
+#include <time.h>
+
+namespace {
+
+int64_t now_ns()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (int64_t)now.tv_sec*1000000000 + now.tv_nsec;
+}
+
+}
+
+CycleExecutor::CycleExecutor(unsigned int period_us)
+:timer_(period_us),
+ policy_(OverrunPolicy::skip),
+ maxCompressedCycles_(1),
+ nCompressedCycles_(0),
+ isLate_(false),
+ faultHandler_(NULL),
+ faultHandlerUserData_(NULL),
+ isFaulted_(false),
+ iBus_(-1),
+ nOverruns_(0),
+ nCycles_(0)
+{
+	for (int i=0; i<nPhases; i++) {
+		phases_[i].function = NULL;
+		phases_[i].userData = NULL;
+	}
+}
+
+CycleExecutor::~CycleExecutor()
+{
+
+}
+
+const char* CycleExecutor::getPhaseName(Phase phase)
+{
+	switch (phase) {
+	case Phase::rxDrain:
+		return "rx drain";
+	case Phase::decode:
+		return "decode";
+	case Phase::control:
+		return "control";
+	case Phase::encode:
+		return "encode";
+	case Phase::sdoService:
+		return "SDO service";
+	case Phase::tx:
+		return "tx";
+	}
+	return "unknown";
+}
+
+void CycleExecutor::setPhase(Phase phase, PhaseFunction function, void* userData)
+{
+	phases_[(int)phase].function = function;
+	phases_[(int)phase].userData = userData;
+}
+
+void CycleExecutor::setOverrunPolicy(OverrunPolicy policy)
+{
+	policy_ = policy;
+}
+
+void CycleExecutor::setMaxCompressedCycles(unsigned int maxCycles)
+{
+	maxCompressedCycles_ = maxCycles;
+}
+
+void CycleExecutor::setFaultHandler(FaultHandler handler, void* userData)
+{
+	faultHandler_ = handler;
+	faultHandlerUserData_ = userData;
+}
+
+void CycleExecutor::setBusIndex(int iBus)
+{
+	iBus_ = iBus;
+}
+
+void CycleExecutor::run(const std::atomic<bool>& isRunning)
+{
+	while (isRunning.load(std::memory_order_acquire) && !isFaulted()) {
+		runCycle();
+	}
+}
+
+bool CycleExecutor::runCycle()
+{
+	if (isFaulted()) {
+		return false;
+	}
+	waitForNextPeriod();
+
+	const struct timespec& cycleStart = timer_.getCycleStartTime();
+	const int64_t deadline_ns = (int64_t)cycleStart.tv_sec*1000000000 + cycleStart.tv_nsec;
+	const int64_t start_ns = now_ns();
+	jitterStatistics_.add(start_ns - deadline_ns);
+	LIBCANPLUSPLUS_TRACE3(cycle_start, iBus_, nCycles_.load(std::memory_order_relaxed), start_ns - deadline_ns);
+	Metrics::increment(Metrics::getBus(iBus_).cycles);
+
+	int64_t phaseStart_ns = start_ns;
+	for (int i=0; i<nPhases; i++) {
+		if (phases_[i].function == NULL) {
+			continue;
+		}
+		phases_[i].function(phases_[i].userData);
+		const int64_t phaseEnd_ns = now_ns();
+		phaseStatistics_[i].add(phaseEnd_ns - phaseStart_ns);
+		LIBCANPLUSPLUS_TRACE3(phase_end, iBus_, i, phaseEnd_ns - phaseStart_ns);
+		phaseStart_ns = phaseEnd_ns;
+	}
+	cycleStatistics_.add(phaseStart_ns - start_ns);
+	LIBCANPLUSPLUS_TRACE3(cycle_end, iBus_, nCycles_.load(std::memory_order_relaxed), phaseStart_ns - start_ns);
+	nCycles_.fetch_add(1, std::memory_order_relaxed);
+
+	/* the cycle must end before the next period starts */
+	const int64_t lateness_ns = phaseStart_ns - (deadline_ns + (int64_t)timer_.getPeriod_us()*1000);
+	isLate_ = (lateness_ns > 0);
+	if (!isLate_) {
+		return true;
+	}
+	nOverruns_.fetch_add(1, std::memory_order_relaxed);
+	Metrics::increment(Metrics::getBus(iBus_).cycleOverruns);
+	if (policy_ == OverrunPolicy::fault) {
+		isFaulted_.store(true, std::memory_order_release);
+		Logger::log(LogLevels::error, "CycleExecutor: Cycle overran by %d us, the executor is faulted!",
+				(int)(lateness_ns/1000));
+		if (faultHandler_ != NULL) {
+			faultHandler_(lateness_ns, faultHandlerUserData_);
+		}
+	}
+	return false;
+}
+
+void CycleExecutor::waitForNextPeriod()
+{
+	if (policy_ == OverrunPolicy::compress && isLate_ && nCompressedCycles_ < maxCompressedCycles_) {
+		/* the late cycle is followed immediately by the cycle of the missed period */
+		nCompressedCycles_++;
+		timer_.waitForNextDeadline();
+		return;
+	}
+	if (!isLate_) {
+		nCompressedCycles_ = 0;
+	}
+	timer_.waitForNextCycle();
+}
+
+bool CycleExecutor::isFaulted() const
+{
+	return isFaulted_.load(std::memory_order_acquire);
+}
+
+void CycleExecutor::resetFault()
+{
+	isLate_ = false;
+	nCompressedCycles_ = 0;
+	timer_.start();
+	isFaulted_.store(false, std::memory_order_release);
+}
+
+const TimingStatistics& CycleExecutor::getPhaseStatistics(Phase phase) const
+{
+	return phaseStatistics_[(int)phase];
+}
+
+const TimingStatistics& CycleExecutor::getCycleStatistics() const
+{
+	return cycleStatistics_;
+}
+
+const TimingStatistics& CycleExecutor::getJitterStatistics() const
+{
+	return jitterStatistics_;
+}
+
+unsigned int CycleExecutor::getNumberOfOverruns() const
+{
+	return nOverruns_.load(std::memory_order_relaxed);
+}
+
+unsigned int CycleExecutor::getNumberOfCycles() const
+{
+	return nCycles_.load(std::memory_order_relaxed);
+}
+
+void CycleExecutor::resetStatistics()
+{
+	for (int i=0; i<nPhases; i++) {
+		phaseStatistics_[i].reset();
+	}
+	cycleStatistics_.reset();
+	jitterStatistics_.reset();
+}
+
+PeriodicTimer* CycleExecutor::getTimer()
+{
+	return &timer_;
+}
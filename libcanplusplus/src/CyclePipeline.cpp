@@ -0,0 +1,297 @@
+/*!
+ * @file 	CyclePipeline.cpp
+ * @brief	Cycle that senses, computes and actuates within one period
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include "libcanplusplus/CyclePipeline.hpp"
+#include "libcanplusplus/CANOpenMsg.hpp"
+
+CyclePipeline::CyclePipeline(Bus* bus, unsigned int period_us)
+:bus_(bus),
+ executor_(period_us),
+ send_(NULL),
+ receive_(NULL),
+ transportUserData_(NULL),
+ control_(NULL),
+ controlUserData_(NULL),
+ receiveHook_(NULL),
+ transmitHook_(NULL),
+ hookUserData_(NULL),
+ isSync_(true),
+ syncCounter_(0),
+ receiveDeadline_us_(period_us/2),
+ isComplete_(false),
+ nIncompleteCycles_(0)
+{
+	sync_.flag = 1;
+	sync_.COBId = canopen::RxPDOSyncId;
+	sync_.length = 0;
+	for (int i=0; i<nWords; i++) {
+		expected_[i] = 0;
+		arrived_[i] = 0;
+	}
+	bus_->getTransmitScheduler()->setCycleTime(period_us);
+
+	executor_.setBusIndex(bus_->iBus());
+	executor_.setPhase(CycleExecutor::Phase::rxDrain, rxDrainPhase, this);
+	executor_.setPhase(CycleExecutor::Phase::decode, decodePhase, this);
+	executor_.setPhase(CycleExecutor::Phase::control, controlPhase, this);
+	executor_.setPhase(CycleExecutor::Phase::encode, encodePhase, this);
+	executor_.setPhase(CycleExecutor::Phase::sdoService, sdoServicePhase, this);
+	executor_.setPhase(CycleExecutor::Phase::tx, txPhase, this);
+}
+
+CyclePipeline::~CyclePipeline()
+{
+
+}
+
+void CyclePipeline::setTransport(SendFunction send, ReceiveFunction receive, void* userData)
+{
+	send_ = send;
+	receive_ = receive;
+	transportUserData_ = userData;
+}
+
+void CyclePipeline::setControl(ControlCallback control, void* userData)
+{
+	control_ = control;
+	controlUserData_ = userData;
+}
+
+void CyclePipeline::setHooks(ReceiveHook receive, TransmitHook transmit, void* userData)
+{
+	receiveHook_ = receive;
+	transmitHook_ = transmit;
+	hookUserData_ = userData;
+}
+
+void CyclePipeline::setSync(bool isEnabled)
+{
+	isSync_ = isEnabled;
+}
+
+void CyclePipeline::setReceiveDeadline(unsigned int deadline_us)
+{
+	receiveDeadline_us_ = deadline_us;
+}
+
+bool CyclePipeline::expectCOBId(int COBId)
+{
+	const int slot = bus_->getReceiveSlots()->getSlot(COBId);
+	if (slot < 0) {
+		return false;
+	}
+	expected_[slot/64] |= (uint64_t)1 << (slot%64);
+	return true;
+}
+
+bool CyclePipeline::expectPDO(CANOpenMsg* pdo)
+{
+	return expectCOBId(pdo->getCOBId());
+}
+
+void CyclePipeline::run(const std::atomic<bool>& isRunning)
+{
+	while (isRunning.load(std::memory_order_acquire) && !executor_.isFaulted()) {
+		runCycle();
+	}
+}
+
+bool CyclePipeline::runCycle()
+{
+	isComplete_ = false;
+	if (!executor_.runCycle() && executor_.isFaulted()) {
+		return false;
+	}
+	if (!isComplete_) {
+		nIncompleteCycles_.fetch_add(1, std::memory_order_relaxed);
+	}
+	return isComplete_;
+}
+
+void CyclePipeline::rxDrainPhase(void* pipeline)
+{
+	CyclePipeline* self = (CyclePipeline*) pipeline;
+	if (self->isSync_ && self->send_ != NULL) {
+		const int overflow = self->bus_->getSyncCounterOverflow();
+		if (overflow > 0) {
+			self->syncCounter_ = self->syncCounter_ % overflow + 1;
+			self->sync_.value[0] = (unsigned char) self->syncCounter_;
+			self->sync_.length = 1;
+		}
+		self->send_(self->sync_, self->transportUserData_);
+	}
+	self->isComplete_ = self->receiveFrames();
+}
+
+void CyclePipeline::decodePhase(void* pipeline)
+{
+	CyclePipeline* self = (CyclePipeline*) pipeline;
+	self->bus_->ingestPDOs(Span<const CANMsg>(self->received_, self->bus_->getReceiveSlots()->getSize()));
+}
+
+void CyclePipeline::controlPhase(void* pipeline)
+{
+	CyclePipeline* self = (CyclePipeline*) pipeline;
+	if (self->control_ != NULL) {
+		self->control_(self->controlUserData_);
+	}
+}
+
+void CyclePipeline::encodePhase(void* pipeline)
+{
+	CyclePipeline* self = (CyclePipeline*) pipeline;
+	self->bus_->emitPDOs(Span<CANMsg>(self->sent_, self->bus_->getSendSlots()->getSize()));
+}
+
+void CyclePipeline::sdoServicePhase(void* pipeline)
+{
+	CyclePipeline* self = (CyclePipeline*) pipeline;
+	self->bus_->ingestSDOs(Span<const CANMsg>(self->received_, self->bus_->getReceiveSlots()->getSize()));
+	self->bus_->emitSDOs(Span<CANMsg>(self->sent_, self->bus_->getSendSlots()->getSize()));
+}
+
+void CyclePipeline::txPhase(void* pipeline)
+{
+	((CyclePipeline*) pipeline)->sendFrames();
+}
+
+bool CyclePipeline::receiveFrames()
+{
+	for (int i=0; i<nWords; i++) {
+		arrived_[i] = 0;
+	}
+	/* the frames of the last period were consumed, e.g. an SDO response is passed once */
+	SlotMap* slots = bus_->getReceiveSlots();
+	for (int slot=slots->getNextDirtySlot(0); slot>=0; slot=slots->getNextDirtySlot(slot+1)) {
+		received_[slot].flag = 0;
+	}
+	slots->clearDirty();
+	if (receive_ == NULL) {
+		return false;
+	}
+
+	PeriodicTimer* timer = executor_.getTimer();
+	CANMsg frame;
+	while (true) {
+		bool isComplete = true;
+		for (int i=0; i<nWords; i++) {
+			if ((expected_[i] & ~arrived_[i]) != 0) {
+				isComplete = false;
+				break;
+			}
+		}
+
+		const int64_t elapsed_us = timer->getElapsedTime_us();
+		if (elapsed_us >= (int64_t)timer->getPeriod_us()) {
+			return isComplete;
+		}
+		int64_t timeout_us = (int64_t)receiveDeadline_us_ - elapsed_us;
+		if (isComplete || timeout_us < 0) {
+			/* the queued frames are stored without waiting */
+			timeout_us = 0;
+		}
+		const int result = receive_(&frame, timeout_us, transportUserData_);
+		if (result <= 0) {
+			return isComplete;
+		}
+		storeFrame(frame);
+	}
+}
+
+void CyclePipeline::storeFrame(const CANMsg& frame)
+{
+	bus_->getReceiveDispatcher()->dispatch(frame);
+	if (receiveHook_ != NULL) {
+		receiveHook_(frame, hookUserData_);
+	}
+
+	SlotMap* slots = bus_->getReceiveSlots();
+	const int slot = slots->getSlot(frame.COBId);
+	if (slot < 0) {
+		/* emergency objects are decoded by the EMCY manager of the bus */
+		bus_->getEMCYManager()->receiveMsg(&frame);
+		return;
+	}
+	received_[slot] = frame;
+	received_[slot].flag = 1;
+	received_[slot].sequence = slots->nextSequence(slot);
+	arrived_[slot/64] |= (uint64_t)1 << (slot%64);
+	slots->setDirty(slot);
+}
+
+void CyclePipeline::sendFrames()
+{
+	TransmitScheduler* scheduler = bus_->getTransmitScheduler();
+	SlotMap* slots = bus_->getSendSlots();
+
+	/* the RxPDOs that were not sent in the last period are dropped, the SDOs are kept */
+	scheduler->beginCycle();
+	for (int slot=slots->getNextDirtySlot(0); slot>=0; slot=slots->getNextDirtySlot(slot+1)) {
+		scheduler->addFrame(sent_[slot]);
+	}
+	if (transmitHook_ != NULL) {
+		transmitHook_(scheduler, hookUserData_);
+	}
+	if (send_ == NULL) {
+		return;
+	}
+
+	PeriodicTimer* timer = executor_.getTimer();
+	const unsigned int period_us = timer->getPeriod_us();
+	CANMsg frame;
+	while (scheduler->hasFrames()) {
+		const int64_t elapsed_us = timer->getElapsedTime_us();
+		if (elapsed_us >= (int64_t)period_us) {
+			/* the next period starts */
+			break;
+		}
+		if (scheduler->getFrame((unsigned int)elapsed_us, &frame)) {
+			if (send_(frame, transportUserData_) == 0) {
+				/* the transmit buffer is full, the frame is sent in the next period */
+				scheduler->requeueFrame();
+				break;
+			}
+		} else {
+			if (scheduler->getNextReleaseTime() >= period_us) {
+				break;
+			}
+			timer->sleepUntil(scheduler->getNextReleaseTime());
+		}
+	}
+}
+
+Bus* CyclePipeline::getBus()
+{
+	return bus_;
+}
+
+CycleExecutor* CyclePipeline::getExecutor()
+{
+	return &executor_;
+}
+
+PeriodicTimer* CyclePipeline::getTimer()
+{
+	return executor_.getTimer();
+}
+
+unsigned int CyclePipeline::getNumberOfCycles() const
+{
+	return executor_.getNumberOfCycles();
+}
+
+unsigned int CyclePipeline::getNumberOfIncompleteCycles() const
+{
+	return nIncompleteCycles_.load(std::memory_order_relaxed);
+}
+
+int64_t CyclePipeline::getMaxCycleTime_us() const
+{
+	return executor_.getCycleStatistics().getMax_ns()/1000;
+}
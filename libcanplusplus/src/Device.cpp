@@ -9,19 +9,20 @@
  */
 
 #include <stdio.h>
-#include <chrono>
 #include "libcanplusplus/Device.hpp"
 #include "libcanplusplus/canopen_sdos.hpp"
+#include "libcanplusplus/Logger.hpp"
 
 Device::Device(int nodeId, const std::string& name)
 :bus_(nullptr),
  nodeId_(nodeId),
  name_(name),
+ hasFailedSDO_(false),
  canState_(CANStates::initializing),
  producerHeartBeatTime_(0),
- txPDONMT_(new canopen::TxPDONMT(nodeId_))
+ txPDONMT_(new canopen::TxPDONMT(nodeId_, SlotMap::noSlot))
 {
-
+	sdos_.reserve(maxPendingSDOs);
 }
 
 Device::Device(int nodeId)
@@ -37,17 +38,58 @@ Device::~Device()
 void Device::setBus(Bus* bus)
 {
 	bus_ = bus;
+	if (bus_->hasAutomaticSlots()) {
+		/* own slot for the heartbeats and the SDO slots of the node */
+		if (txPDONMT_->getSMId() == SlotMap::noSlot) {
+			txPDONMT_->setSMId(SlotMap::autoSlot);
+		}
+		bus_->getReceiveSlots()->allocate(canopen::TxSDOId + nodeId_);
+		bus_->getSendSlots()->allocate(canopen::RxSDOId + nodeId_);
+	}
 	bus_->getTxPDOManager()->addPDO(txPDONMT_);
+	txPDONMT_->setHeartbeatMonitor(bus_->getHeartbeatMonitor());
+	if (producerHeartBeatTime_ != 0) {
+		bus_->getHeartbeatMonitor()->addNode(nodeId_, getConsumerHeartBeatTime());
+	}
+	bus_->getEMCYManager()->registerNode(nodeId_, getEMCYVendor());
 }
 
+void Device::setNMTSMId(int SMId)
+{
+	txPDONMT_->setSMId(SMId);
+}
 
 void Device::sendSDO(SDOMsg* sdoMsg) {
   SDOMsgPtr sdo(sdoMsg);
   SDOManager* SDOManager = bus_->getSDOManager();
+  /* release the finished SDOs, the list would grow otherwise,
+   * a timeout is kept for checkSDOResponses() */
+  for (std::vector<SDOMsgPtr>::iterator it = sdos_.begin(); it != sdos_.end();) {
+    if ((*it)->hasTimeOut()) {
+      hasFailedSDO_ = true;
+      it = sdos_.erase(it);
+    } else if ((*it)->getIsSent() && (*it)->getIsReceived()) {
+      it = sdos_.erase(it);
+    } else {
+      ++it;
+    }
+  }
   sdos_.push_back(sdo);
   SDOManager->addSDO(sdo);
 }
 
+bool Device::configureDevice() {
+	return initDevice();
+}
+
+int Device::getNodeId() const {
+	return nodeId_;
+}
+
+canopen::EMCYVendor Device::getEMCYVendor() const {
+	return canopen::EMCYVendor::generic;
+}
+
 const std::string& Device::getName() const {
   return name_;
 }
@@ -64,12 +106,40 @@ bool Device::initHeartbeat(const unsigned int heartBeatTime) {
 
 	producerHeartBeatTime_ = heartBeatTime;
 
+	if (bus_ != nullptr) {
+		if (producerHeartBeatTime_ != 0) {
+			bus_->getHeartbeatMonitor()->addNode(nodeId_, getConsumerHeartBeatTime());
+		} else {
+			bus_->getHeartbeatMonitor()->removeNode(nodeId_);
+		}
+	}
 	return true;
 }
 
+unsigned int Device::getConsumerHeartBeatTime() const {
+	/* half a heartbeat time more, a heartbeat that arrives or is decoded one cycle late is not missed */
+	return producerHeartBeatTime_ + (producerHeartBeatTime_ + 1)/2;
+}
+
+bool Device::setSyncCounterOverflow(int overflow, int rateDivisor, int syncStartValue) {
+	if (overflow < 2 || overflow > 240) {
+		Logger::log(LogLevels::error, "Node %d: The SYNC counter overflow %d is not within 2-240!", nodeId_, overflow);
+		return false;
+	}
+	if (syncStartValue < 1 || syncStartValue > overflow) {
+		Logger::log(LogLevels::error, "Node %d: The SYNC start value %d is not within 1-%d!", nodeId_, syncStartValue, overflow);
+		return false;
+	}
+	if (rateDivisor < 1 || overflow % rateDivisor != 0) {
+		Logger::log(LogLevels::error, "Node %d: The SYNC counter overflow %d is not a multiple of the rate divisor %d!", nodeId_, overflow, rateDivisor);
+		return false;
+	}
+	return bus_->setSyncCounterOverflow(overflow);
+}
+
 bool Device::checkHeartbeat() {
 
-	if(canState_ == CANStates::initializing && txPDONMT_->isBootup()) {
+	if((canState_ == CANStates::initializing || canState_ == CANStates::missing) && txPDONMT_->isBootup()) {
 		canState_ = CANStates::preOperational;
 		initDevice();
 	}else if(txPDONMT_->isPreOperational()) {
@@ -87,27 +157,35 @@ bool Device::checkHeartbeat() {
 	}
 
 	// Check if device is initialized.
-	if (canState_ != CANStates::operational) {
+	if (canState_ == CANStates::initializing) {
 		// Device is not initialized. It is fine.
 		return true;
 	}
 
-	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - txPDONMT_->getTime()).count() <= static_cast<int64_t>(producerHeartBeatTime_);
+	// The deadlines are supervised by the heartbeat monitor of the bus.
+	if (bus_->getHeartbeatMonitor()->isMissing(nodeId_)) {
+		canState_ = CANStates::missing;
+		return false;
+	}
+	return true;
 }
 
 
 void Device::sendNMTEnterPreOperational() {
 	sdos_.clear();
+	hasFailedSDO_ = false;
 	sendSDO(new canopen::SDONMTEnterPreOperational(0, 0, nodeId_));
 }
 
 void Device::sendNMTStartRemoteNode() {
 	sdos_.clear();
+	hasFailedSDO_ = false;
 	sendSDO(new canopen::SDONMTStartRemoteNode(0, 0, nodeId_));
 }
 
 void Device::setNMTRestartNode() {
 	sdos_.clear();
+	hasFailedSDO_ = false;
 	sendSDO(new canopen::SDONMTResetNode(0, 0, nodeId_));
 	canState_ = CANStates::initializing;
 }
@@ -118,7 +196,7 @@ bool Device::checkSDOResponses(bool& success) {
   // Check if SDOS are processed
   bool done = true;
   // If one of the SDOs could not be sent, this flag will be false:
-  success = true;
+  success = !hasFailedSDO_;
 
   for (auto& sdo : sdos_) {
     // Check if SDO was received or has a timeout
@@ -131,6 +209,7 @@ bool Device::checkSDOResponses(bool& success) {
   }
   if (done) {
     sdos_.clear();
+    hasFailedSDO_ = false;
   }
   return done;
 }
@@ -9,10 +9,7 @@
  */
 #include "libcanplusplus/DeviceManager.hpp"
 
-#include <stdexcept>
-#include <boost/lexical_cast.hpp>
-#include <iostream>
-#include <stdio.h>
+#include "libcanplusplus/Logger.hpp"
 
 DeviceManager::DeviceManager(Bus* bus):bus_(bus)
 {
@@ -40,17 +37,10 @@ int DeviceManager::getSize()
 
 Device* DeviceManager::getDevice(unsigned int index)
 {
-	try {
-		if (index >= devices_.size()) {
-			std::string error = "DeviceManager: Could not get device with index "
-								+ boost::lexical_cast<std::string>(index) + "!";
-			throw std::out_of_range(error);
-		}
-		return &(devices_[index]);
-
-	} catch (std::exception& e) {
-		std::cout << e.what() << std::endl;
+	if (index >= devices_.size()) {
+		Logger::log(LogLevels::error, "DeviceManager: Could not get device with index %u!", index);
+		return NULL;
 	}
-	return NULL;
+	return &(devices_[index]);
 }
 
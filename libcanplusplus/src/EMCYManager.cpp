@@ -0,0 +1,323 @@
+/*!
+ * @file 	EMCYManager.cpp
+ * @brief	Reception and decoding of emergency objects
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include <chrono>
+#include "libcanplusplus/EMCYManager.hpp"
+#include "libcanplusplus/Metrics.hpp"
+
+namespace canopen {
+
+namespace {
+
+//! COB-ID of the emergency object of node 0
+constexpr int EMCYId = 0x80;
+
+//! emergency error codes of CiA 301, CiA 402, EPOS2 and ELMO
+constexpr EMCYCode emcyCodes[] = {
+	/* CiA 301 / CiA 402 */
+	{0x0000, EMCYVendor::generic, "No error / error reset"},
+	{0x1000, EMCYVendor::generic, "Generic error"},
+	{0x2000, EMCYVendor::generic, "Current error"},
+	{0x2100, EMCYVendor::generic, "Current, device input side"},
+	{0x2200, EMCYVendor::generic, "Current inside the device"},
+	{0x2300, EMCYVendor::generic, "Current, device output side"},
+	{0x2310, EMCYVendor::generic, "Continuous over current"},
+	{0x2320, EMCYVendor::generic, "Short circuit / earth leakage"},
+	{0x3000, EMCYVendor::generic, "Voltage error"},
+	{0x3100, EMCYVendor::generic, "Mains voltage"},
+	{0x3200, EMCYVendor::generic, "Voltage inside the device"},
+	{0x3210, EMCYVendor::generic, "DC link over voltage"},
+	{0x3220, EMCYVendor::generic, "DC link under voltage"},
+	{0x3300, EMCYVendor::generic, "Output voltage"},
+	{0x4000, EMCYVendor::generic, "Temperature error"},
+	{0x4100, EMCYVendor::generic, "Ambient temperature"},
+	{0x4200, EMCYVendor::generic, "Device temperature"},
+	{0x4210, EMCYVendor::generic, "Excess temperature device"},
+	{0x4300, EMCYVendor::generic, "Drive temperature"},
+	{0x5000, EMCYVendor::generic, "Device hardware error"},
+	{0x5100, EMCYVendor::generic, "Supply voltage"},
+	{0x6000, EMCYVendor::generic, "Device software error"},
+	{0x6100, EMCYVendor::generic, "Internal software error"},
+	{0x6200, EMCYVendor::generic, "User software error"},
+	{0x6300, EMCYVendor::generic, "Data set error"},
+	{0x7000, EMCYVendor::generic, "Additional modules error"},
+	{0x7300, EMCYVendor::generic, "Sensor error"},
+	{0x8000, EMCYVendor::generic, "Monitoring error"},
+	{0x8100, EMCYVendor::generic, "Communication error"},
+	{0x8110, EMCYVendor::generic, "CAN overrun (objects lost)"},
+	{0x8120, EMCYVendor::generic, "CAN in error passive mode"},
+	{0x8130, EMCYVendor::generic, "Life guard or heartbeat error"},
+	{0x8140, EMCYVendor::generic, "Recovered from bus off"},
+	{0x8150, EMCYVendor::generic, "CAN-ID collision"},
+	{0x8200, EMCYVendor::generic, "Protocol error"},
+	{0x8210, EMCYVendor::generic, "PDO not processed due to length error"},
+	{0x8220, EMCYVendor::generic, "PDO length exceeded"},
+	{0x8230, EMCYVendor::generic, "DAM MPDO not processed, destination object not available"},
+	{0x8240, EMCYVendor::generic, "Unexpected SYNC data length"},
+	{0x8250, EMCYVendor::generic, "RPDO timeout"},
+	{0x8400, EMCYVendor::generic, "Velocity speed controller error"},
+	{0x8500, EMCYVendor::generic, "Position controller error"},
+	{0x8600, EMCYVendor::generic, "Positioning controller error"},
+	{0x8611, EMCYVendor::generic, "Following error"},
+	{0x9000, EMCYVendor::generic, "External error"},
+	{0xF000, EMCYVendor::generic, "Additional functions error"},
+	{0xFF00, EMCYVendor::generic, "Device specific error"},
+
+	/* maxon EPOS2 */
+	{0x1000, EMCYVendor::maxon, "Generic error"},
+	{0x2310, EMCYVendor::maxon, "Over current error"},
+	{0x3210, EMCYVendor::maxon, "Over voltage error"},
+	{0x3220, EMCYVendor::maxon, "Under voltage error"},
+	{0x4210, EMCYVendor::maxon, "Over temperature error"},
+	{0x5113, EMCYVendor::maxon, "Supply voltage (+5V) too low"},
+	{0x5114, EMCYVendor::maxon, "Supply voltage output stage too low"},
+	{0x6100, EMCYVendor::maxon, "Internal software error"},
+	{0x6320, EMCYVendor::maxon, "Software parameter error"},
+	{0x7320, EMCYVendor::maxon, "Position sensor error"},
+	{0x8110, EMCYVendor::maxon, "CAN overrun error (objects lost)"},
+	{0x8111, EMCYVendor::maxon, "CAN overrun error"},
+	{0x8120, EMCYVendor::maxon, "CAN passive mode error"},
+	{0x8130, EMCYVendor::maxon, "CAN life guard error"},
+	{0x8150, EMCYVendor::maxon, "CAN transmit COB-ID collision"},
+	{0x81FD, EMCYVendor::maxon, "CAN bus off"},
+	{0x81FE, EMCYVendor::maxon, "CAN Rx queue overrun"},
+	{0x81FF, EMCYVendor::maxon, "CAN Tx queue overrun"},
+	{0x8210, EMCYVendor::maxon, "CAN PDO length error"},
+	{0x8611, EMCYVendor::maxon, "Following error"},
+	{0xFF01, EMCYVendor::maxon, "Hall sensor error"},
+	{0xFF02, EMCYVendor::maxon, "Index processing error"},
+	{0xFF03, EMCYVendor::maxon, "Encoder resolution error"},
+	{0xFF04, EMCYVendor::maxon, "Hall sensor not found error"},
+	{0xFF06, EMCYVendor::maxon, "Negative limit switch error"},
+	{0xFF07, EMCYVendor::maxon, "Positive limit switch error"},
+	{0xFF08, EMCYVendor::maxon, "Hall angle detection error"},
+	{0xFF09, EMCYVendor::maxon, "Software position limit error"},
+	{0xFF0A, EMCYVendor::maxon, "Position sensor breach"},
+	{0xFF0B, EMCYVendor::maxon, "System overloaded"},
+	{0xFF0C, EMCYVendor::maxon, "Interpolated position mode error"},
+	{0xFF0D, EMCYVendor::maxon, "Auto tuning identification error"},
+	{0xFF10, EMCYVendor::maxon, "Gear scaling factor error"},
+	{0xFF11, EMCYVendor::maxon, "Controller gain error"},
+	{0xFF12, EMCYVendor::maxon, "Main sensor direction error"},
+	{0xFF13, EMCYVendor::maxon, "Auxiliary sensor direction error"},
+
+	/* ELMO */
+	{0x2340, EMCYVendor::elmo, "Short circuit: motor or its wiring may be defective"},
+	{0x3120, EMCYVendor::elmo, "Under voltage: power supply is shut down or it has too high an output impedance"},
+	{0x3310, EMCYVendor::elmo, "Over voltage: power supply voltage is too high"},
+	{0x4310, EMCYVendor::elmo, "Temperature: drive overheating"},
+	{0x5280, EMCYVendor::elmo, "ECAM table problem"},
+	{0x5281, EMCYVendor::elmo, "Timing error"},
+	{0x5441, EMCYVendor::elmo, "Disabled by limit switch"},
+	{0x5442, EMCYVendor::elmo, "Additional abort required"},
+	{0x6180, EMCYVendor::elmo, "Fatal CPU error: stack overflow"},
+	{0x6181, EMCYVendor::elmo, "CPU exception: fatal exception"},
+	{0x6200, EMCYVendor::elmo, "User program aborted by an error"},
+	{0x6300, EMCYVendor::elmo, "Object mapped to an RPDO returned an error during interpretation"},
+	{0x7300, EMCYVendor::elmo, "Resolver or analog encoder feedback failed"},
+	{0x7380, EMCYVendor::elmo, "Feedback loss: no match between encoder and Hall location"},
+	{0x8110, EMCYVendor::elmo, "CAN message lost (corrupted or overrun)"},
+	{0x8130, EMCYVendor::elmo, "Heartbeat event"},
+	{0x8140, EMCYVendor::elmo, "Recovered from bus off"},
+	{0x8200, EMCYVendor::elmo, "Attempt to access an unconfigured RPDO"},
+	{0x8210, EMCYVendor::elmo, "PDO not processed due to length error"},
+	{0x8220, EMCYVendor::elmo, "PDO length exceeded"},
+	{0x8311, EMCYVendor::elmo, "Peak current has been exceeded"},
+	{0x8380, EMCYVendor::elmo, "Cannot start motor"},
+	{0x8381, EMCYVendor::elmo, "Cannot tune current offsets"},
+	{0x8480, EMCYVendor::elmo, "Speed tracking error"},
+	{0x8481, EMCYVendor::elmo, "Speed limit exceeded"},
+	{0x8611, EMCYVendor::elmo, "Position tracking error"},
+	{0x8680, EMCYVendor::elmo, "Position limit exceeded"},
+	{0xFF00, EMCYVendor::elmo, "Motion manager: bad data in PDO"},
+	{0xFF01, EMCYVendor::elmo, "Request by user program emit function"},
+	{0xFF02, EMCYVendor::elmo, "DS402 IP underflow"}
+};
+
+//! number of entries of the code table
+constexpr std::size_t nEMCYCodes = sizeof(emcyCodes)/sizeof(emcyCodes[0]);
+
+/*! Searches the code table
+ * @return description or NULL if there is no entry
+ */
+const char* findEMCYCode(uint16_t code, EMCYVendor vendor)
+{
+	for (std::size_t i=0; i<nEMCYCodes; i++) {
+		if (emcyCodes[i].code == code && emcyCodes[i].vendor == vendor) {
+			return emcyCodes[i].description;
+		}
+	}
+	return NULL;
+}
+
+} // namespace
+
+const char* getEMCYDescription(uint16_t code, EMCYVendor vendor)
+{
+	/* exact code, then the error classes 0xXXX0, 0xXX00 and 0xX000 */
+	const uint16_t masks[] = {0xFFFF, 0xFFF0, 0xFF00, 0xF000};
+	for (int i=0; i<4; i++) {
+		const uint16_t masked = code & masks[i];
+		if (i > 0 && masked == (code & masks[i-1])) {
+			continue;
+		}
+		const char* description = NULL;
+		if (vendor != EMCYVendor::generic) {
+			description = findEMCYCode(masked, vendor);
+		}
+		if (description == NULL) {
+			description = findEMCYCode(masked, EMCYVendor::generic);
+		}
+		if (description != NULL) {
+			return description;
+		}
+	}
+	return "Unknown error";
+}
+
+} // namespace canopen
+
+
+EMCYManager::EMCYManager()
+:faultHandler_(NULL),
+ faultHandlerUserData_(NULL),
+ nDroppedEvents_(0),
+ iBus_(-1)
+{
+	for (int i=0; i<maxNodes; i++) {
+		nodes_[i].isRegistered = false;
+		nodes_[i].vendor = canopen::EMCYVendor::generic;
+		nodes_[i].activeCode = 0;
+	}
+}
+
+EMCYManager::~EMCYManager()
+{
+
+}
+
+void EMCYManager::registerNode(int nodeId, canopen::EMCYVendor vendor)
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return;
+	}
+	nodes_[nodeId].vendor = vendor;
+	nodes_[nodeId].activeCode = 0;
+	nodes_[nodeId].isRegistered.store(true, std::memory_order_release);
+}
+
+void EMCYManager::unregisterNode(int nodeId)
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return;
+	}
+	nodes_[nodeId].isRegistered.store(false, std::memory_order_release);
+}
+
+bool EMCYManager::isRegistered(int nodeId) const
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return false;
+	}
+	return nodes_[nodeId].isRegistered.load(std::memory_order_acquire);
+}
+
+void EMCYManager::setFaultHandler(FaultHandler handler, void* userData)
+{
+	faultHandlerUserData_.store(userData, std::memory_order_relaxed);
+	faultHandler_.store(handler, std::memory_order_release);
+}
+
+void EMCYManager::addCallback(const Callback& callback, int nodeId)
+{
+	NodeCallback nodeCallback;
+	nodeCallback.nodeId = nodeId;
+	nodeCallback.callback = callback;
+	callbacks_.push_back(nodeCallback);
+}
+
+bool EMCYManager::receiveMsg(const CANMsg* msg)
+{
+	const int nodeId = msg->COBId - canopen::EMCYId;
+	if (nodeId <= 0 || nodeId >= maxNodes || msg->rtr) {
+		return false;
+	}
+	Node& node = nodes_[nodeId];
+	if (!node.isRegistered.load(std::memory_order_acquire)) {
+		return false;
+	}
+	Metrics::increment(Metrics::getNode(iBus_, nodeId).emcyCount);
+
+	EMCYEvent event;
+	event.nodeId = static_cast<uint8_t>(nodeId);
+	event.code = static_cast<uint16_t>(msg->value[0] | (msg->value[1] << 8));
+	event.errorRegister = msg->value[2];
+	for (int i=0; i<5; i++) {
+		event.data[i] = msg->value[3+i];
+	}
+	event.description = canopen::getEMCYDescription(event.code, node.vendor);
+	event.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+	node.activeCode.store(event.code, std::memory_order_relaxed);
+
+	if (!event.isErrorReset()) {
+		FaultHandler handler = faultHandler_.load(std::memory_order_acquire);
+		if (handler != NULL) {
+			handler(event, faultHandlerUserData_.load(std::memory_order_relaxed));
+		}
+	}
+
+	if (!queue_.push(event)) {
+		nDroppedEvents_.fetch_add(1, std::memory_order_relaxed);
+	}
+	return true;
+}
+
+bool EMCYManager::popEvent(EMCYEvent& event)
+{
+	return queue_.pop(event);
+}
+
+int EMCYManager::dispatch()
+{
+	int nEvents = 0;
+	EMCYEvent event;
+	while (queue_.pop(event)) {
+		for (std::size_t i=0; i<callbacks_.size(); i++) {
+			if (callbacks_[i].nodeId == 0 || callbacks_[i].nodeId == event.nodeId) {
+				callbacks_[i].callback(event);
+			}
+		}
+		nEvents++;
+	}
+	return nEvents;
+}
+
+bool EMCYManager::hasActiveError(int nodeId) const
+{
+	return getActiveErrorCode(nodeId) != 0;
+}
+
+uint16_t EMCYManager::getActiveErrorCode(int nodeId) const
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return 0;
+	}
+	return nodes_[nodeId].activeCode.load(std::memory_order_relaxed);
+}
+
+unsigned int EMCYManager::getNumberOfDroppedEvents() const
+{
+	return nDroppedEvents_.load(std::memory_order_relaxed);
+}
+
+void EMCYManager::setBusIndex(int iBus)
+{
+	iBus_ = iBus;
+}
@@ -0,0 +1,239 @@
+/*!
+ * @file 	HeartbeatMonitor.cpp
+ * @brief	Heartbeat consumer of a bus based on a hierarchical timer wheel
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include <chrono>
+#include "libcanplusplus/HeartbeatMonitor.hpp"
+#include "libcanplusplus/Metrics.hpp"
+
+HeartbeatMonitor::HeartbeatMonitor(unsigned int tickPeriod_us)
+:tickPeriod_us_(tickPeriod_us > 0 ? tickPeriod_us : 1),
+ currentTick_(0),
+ startTime_us_(0),
+ isStarted_(false),
+ iBus_(-1)
+{
+	for (int i=0; i<maxNodes; i++) {
+		nodes_[i].timeout = 0;
+		nodes_[i].deadline = 0;
+		nodes_[i].slot = none;
+		nodes_[i].prev = none;
+		nodes_[i].next = none;
+		nodes_[i].isMissing = false;
+	}
+	for (int i=0; i<nSlots; i++) {
+		slots_[i] = none;
+	}
+}
+
+HeartbeatMonitor::~HeartbeatMonitor()
+{
+
+}
+
+void HeartbeatMonitor::addNode(int nodeId, unsigned int consumerTime_ms)
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return;
+	}
+	unschedule(nodeId);
+	nodes_[nodeId].isMissing = false;
+	/* round up, a node must not be missing before its consumer time has passed */
+	nodes_[nodeId].timeout = static_cast<uint32_t>((static_cast<int64_t>(consumerTime_ms)*1000 + tickPeriod_us_ - 1)/tickPeriod_us_);
+}
+
+void HeartbeatMonitor::removeNode(int nodeId)
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return;
+	}
+	unschedule(nodeId);
+	nodes_[nodeId].timeout = 0;
+	nodes_[nodeId].isMissing = false;
+}
+
+void HeartbeatMonitor::setCallback(const Callback& callback)
+{
+	callback_ = callback;
+}
+
+void HeartbeatMonitor::heartbeatReceived(int nodeId)
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return;
+	}
+	Node& node = nodes_[nodeId];
+	if (node.timeout == 0) {
+		return;
+	}
+	unschedule(nodeId);
+	node.deadline = currentTick_ + node.timeout;
+	schedule(nodeId);
+
+	if (node.isMissing) {
+		node.isMissing = false;
+		if (callback_) {
+			callback_(nodeId, false);
+		}
+	}
+}
+
+void HeartbeatMonitor::bootupReceived(int nodeId)
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return;
+	}
+	Node& node = nodes_[nodeId];
+	unschedule(nodeId);
+	if (node.isMissing) {
+		node.isMissing = false;
+		if (callback_) {
+			callback_(nodeId, false);
+		}
+	}
+}
+
+void HeartbeatMonitor::tick()
+{
+	tick(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void HeartbeatMonitor::tick(int64_t time_us)
+{
+	if (!isStarted_) {
+		startTime_us_ = time_us - static_cast<int64_t>(currentTick_)*tickPeriod_us_;
+		isStarted_ = true;
+		return;
+	}
+	if (time_us < startTime_us_) {
+		return;
+	}
+	const uint64_t targetTick = static_cast<uint64_t>((time_us - startTime_us_)/tickPeriod_us_);
+
+	/* all deadlines are within one revolution of the second level */
+	const uint64_t horizon = static_cast<uint64_t>(level0Size)*level1Size;
+	if (targetTick > currentTick_ + horizon) {
+		const uint64_t skippedTicks = targetTick - currentTick_ - horizon;
+		for (uint64_t i=0; i<horizon; i++) {
+			advance();
+		}
+		currentTick_ += skippedTicks;
+	}
+
+	while (currentTick_ < targetTick) {
+		advance();
+	}
+}
+
+bool HeartbeatMonitor::isMissing(int nodeId) const
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return false;
+	}
+	return nodes_[nodeId].isMissing;
+}
+
+bool HeartbeatMonitor::isSupervised(int nodeId) const
+{
+	if (nodeId <= 0 || nodeId >= maxNodes) {
+		return false;
+	}
+	return nodes_[nodeId].timeout != 0 && (nodes_[nodeId].slot != none || nodes_[nodeId].isMissing);
+}
+
+void HeartbeatMonitor::setBusIndex(int iBus)
+{
+	iBus_ = iBus;
+}
+
+void HeartbeatMonitor::advance()
+{
+	currentTick_++;
+	const int slot0 = static_cast<int>(currentTick_ & (level0Size - 1));
+	if (slot0 == 0) {
+		cascade(static_cast<int>((currentTick_ >> level0Bits) & (level1Size - 1)));
+	}
+	expire(slot0);
+}
+
+void HeartbeatMonitor::schedule(int nodeId)
+{
+	Node& node = nodes_[nodeId];
+	const uint64_t horizon = static_cast<uint64_t>(level0Size)*level1Size;
+
+	int slot;
+	if (node.deadline <= currentTick_) {
+		/* expires with the next tick */
+		slot = static_cast<int>((currentTick_ + 1) & (level0Size - 1));
+	} else if (node.deadline - currentTick_ < static_cast<uint64_t>(level0Size)) {
+		slot = static_cast<int>(node.deadline & (level0Size - 1));
+	} else if (node.deadline - currentTick_ < horizon) {
+		slot = level0Size + static_cast<int>((node.deadline >> level0Bits) & (level1Size - 1));
+	} else {
+		/* beyond the horizon, the node is rescheduled when the slot is cascaded */
+		slot = level0Size + static_cast<int>(((currentTick_ + horizon - 1) >> level0Bits) & (level1Size - 1));
+	}
+
+	node.slot = slot;
+	node.prev = none;
+	node.next = slots_[slot];
+	if (node.next != none) {
+		nodes_[node.next].prev = nodeId;
+	}
+	slots_[slot] = nodeId;
+}
+
+void HeartbeatMonitor::unschedule(int nodeId)
+{
+	Node& node = nodes_[nodeId];
+	if (node.slot == none) {
+		return;
+	}
+	if (node.prev != none) {
+		nodes_[node.prev].next = node.next;
+	} else {
+		slots_[node.slot] = node.next;
+	}
+	if (node.next != none) {
+		nodes_[node.next].prev = node.prev;
+	}
+	node.slot = none;
+	node.prev = none;
+	node.next = none;
+}
+
+void HeartbeatMonitor::cascade(int slot)
+{
+	int nodeId = slots_[level0Size + slot];
+	while (nodeId != none) {
+		const int next = nodes_[nodeId].next;
+		unschedule(nodeId);
+		schedule(nodeId);
+		nodeId = next;
+	}
+}
+
+void HeartbeatMonitor::expire(int slot)
+{
+	int nodeId = slots_[slot];
+	while (nodeId != none) {
+		const int next = nodes_[nodeId].next;
+		Node& node = nodes_[nodeId];
+		unschedule(nodeId);
+		if (node.deadline > currentTick_) {
+			schedule(nodeId);
+		} else if (!node.isMissing) {
+			node.isMissing = true;
+			Metrics::increment(Metrics::getNode(iBus_, nodeId).heartbeatMisses);
+			if (callback_) {
+				callback_(nodeId, true);
+			}
+		}
+		nodeId = next;
+	}
+}
@@ -0,0 +1,117 @@
+/*!
+ * @file 	JointStateBuffer.cpp
+ * @brief	Structure-of-arrays buffer of the joint states of a bus
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include "libcanplusplus/JointStateBuffer.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//! number of joints that are converted in one step
+static const int vectorWidth = 4;
+
+JointStateBuffer::JointStateBuffer()
+:nJoints_(0),
+ nPadded_(0)
+{
+	for (int i=0; i<maxJoints; i++) {
+		rawPosition_[i] = 0;
+		rawVelocity_[i] = 0;
+		rawCurrent_[i] = 0;
+		positionScale_[i] = 0.0;
+		velocityScale_[i] = 0.0;
+		currentScale_[i] = 0.0;
+		position_[i] = 0.0;
+		velocity_[i] = 0.0;
+		current_[i] = 0.0;
+	}
+}
+
+JointStateBuffer::~JointStateBuffer()
+{
+
+}
+
+int JointStateBuffer::addJoint(double positionScale, double velocityScale, double currentScale)
+{
+	if (nJoints_ >= maxJoints) {
+		return -1;
+	}
+	const int joint = nJoints_++;
+	nPadded_ = (nJoints_ + vectorWidth - 1) / vectorWidth * vectorWidth;
+	setScale(joint, positionScale, velocityScale, currentScale);
+	return joint;
+}
+
+void JointStateBuffer::setScale(int joint, double positionScale, double velocityScale, double currentScale)
+{
+	positionScale_[joint] = positionScale;
+	velocityScale_[joint] = velocityScale;
+	currentScale_[joint] = currentScale;
+}
+
+int JointStateBuffer::getSize() const
+{
+	return nJoints_;
+}
+
+//! Converts n raw values (n is a multiple of vectorWidth)
+static inline void convert(const int32_t* raw, const double* scale, double* out, int n)
+{
+#if defined(__SSE2__)
+	for (int i=0; i<n; i+=vectorWidth) {
+		const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw + i));
+		const __m128d lo = _mm_cvtepi32_pd(r);
+		const __m128d hi = _mm_cvtepi32_pd(_mm_shuffle_epi32(r, _MM_SHUFFLE(1, 0, 3, 2)));
+		_mm_storeu_pd(out + i, _mm_mul_pd(lo, _mm_loadu_pd(scale + i)));
+		_mm_storeu_pd(out + i + 2, _mm_mul_pd(hi, _mm_loadu_pd(scale + i + 2)));
+	}
+#else
+	for (int i=0; i<n; i++) {
+		out[i] = static_cast<double>(raw[i]) * scale[i];
+	}
+#endif
+}
+
+void JointStateBuffer::update()
+{
+	convert(rawPosition_, positionScale_, position_, nPadded_);
+	convert(rawVelocity_, velocityScale_, velocity_, nPadded_);
+	convert(rawCurrent_, currentScale_, current_, nPadded_);
+}
+
+const double* JointStateBuffer::getPositions() const
+{
+	return position_;
+}
+
+const double* JointStateBuffer::getVelocities() const
+{
+	return velocity_;
+}
+
+const double* JointStateBuffer::getCurrents() const
+{
+	return current_;
+}
+
+const int32_t* JointStateBuffer::getRawPositions() const
+{
+	return rawPosition_;
+}
+
+const int32_t* JointStateBuffer::getRawVelocities() const
+{
+	return rawVelocity_;
+}
+
+const int32_t* JointStateBuffer::getRawCurrents() const
+{
+	return rawCurrent_;
+}
@@ -0,0 +1,399 @@
+/*!
+ * @file 	Logger.cpp
+ * @brief	Asynchronous logging of the diagnostics of the library
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include "libcanplusplus/Logger.hpp"
+#include "libcanplusplus/MPSCQueue.hpp"
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+/*******************************************************
+ * LogRecord
+ *******************************************************/
+
+void LogRecord::reset(LogLevels level, const char* format)
+{
+	level_ = level;
+	format_ = format;
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	time_ns_ = (int64_t)now.tv_sec*1000000000LL + now.tv_nsec;
+	nArguments_ = 0;
+	textLength_ = 0;
+}
+
+void LogRecord::addInteger(int64_t value, bool isSigned, int size)
+{
+	if (nArguments_ >= maxArguments) {
+		return;
+	}
+	Argument& argument = arguments_[nArguments_++];
+	argument.integer = value;
+	argument.type = isSigned ? Types::integer : Types::unsignedInteger;
+	argument.size = size;
+}
+
+void LogRecord::addDouble(double value)
+{
+	if (nArguments_ >= maxArguments) {
+		return;
+	}
+	Argument& argument = arguments_[nArguments_++];
+	argument.floatingPoint = value;
+	argument.type = Types::floatingPoint;
+	argument.size = sizeof(double);
+}
+
+void LogRecord::addString(const char* value)
+{
+	if (nArguments_ >= maxArguments) {
+		return;
+	}
+	Argument& argument = arguments_[nArguments_++];
+	argument.type = Types::string;
+	argument.size = 0;
+	argument.textOffset = textLength_;
+	if (value == NULL) {
+		value = "(null)";
+	}
+	/* the string is truncated if the storage is exhausted */
+	while (*value != '\0' && textLength_ < textSize - 1) {
+		text_[textLength_++] = *value++;
+	}
+	if (textLength_ < textSize) {
+		text_[textLength_++] = '\0';
+	}
+}
+
+void LogRecord::addPointer(const void* value)
+{
+	if (nArguments_ >= maxArguments) {
+		return;
+	}
+	Argument& argument = arguments_[nArguments_++];
+	argument.pointer = value;
+	argument.type = Types::pointer;
+	argument.size = sizeof(void*);
+}
+
+//! Advances the length of a message by the characters snprintf() wrote
+static void advance(size_t& length, int written, size_t size)
+{
+	length += written;
+	if (length >= size) {
+		/* truncated, keep the terminating zero */
+		length = size - 1;
+	}
+}
+
+int LogRecord::format(char* buffer, size_t size) const
+{
+	size_t length = 0;
+	int iArgument = 0;
+	const char* c = format_;
+
+	while (*c != '\0' && length < size - 1) {
+		if (*c != '%') {
+			buffer[length++] = *c++;
+			continue;
+		}
+		if (c[1] == '%') {
+			buffer[length++] = '%';
+			c += 2;
+			continue;
+		}
+
+		/* conversion specification without length modifier: %[flags][width][.precision] */
+		char specification[32];
+		int n = 0;
+		specification[n++] = *c++;
+		while (*c != '\0' && strchr("-+ #0123456789.", *c) != NULL && n < 24) {
+			specification[n++] = *c++;
+		}
+		while (*c != '\0' && strchr("hlLqjzt", *c) != NULL) {
+			c++;
+		}
+		const char conversion = *c;
+		if (conversion == '\0') {
+			break;
+		}
+		c++;
+
+		if (iArgument >= nArguments_) {
+			const int written = snprintf(buffer + length, size - length, "<?>");
+			advance(length, written, size);
+			continue;
+		}
+		const Argument& argument = arguments_[iArgument++];
+
+		int written = 0;
+		switch (conversion) {
+		case 'd':
+		case 'i':
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X': {
+			uint64_t value = (uint64_t)argument.integer;
+			if (strchr("uoxX", conversion) != NULL && argument.size < 8) {
+				/* an unsigned conversion shows the bits of the original type */
+				value &= (1ULL << (8*argument.size)) - 1;
+			}
+			specification[n++] = 'l';
+			specification[n++] = 'l';
+			specification[n++] = conversion;
+			specification[n] = '\0';
+			if (conversion == 'd' || conversion == 'i') {
+				written = snprintf(buffer + length, size - length, specification, (long long)argument.integer);
+			} else {
+				written = snprintf(buffer + length, size - length, specification, (unsigned long long)value);
+			}
+			break;
+		}
+		case 'c':
+			specification[n++] = conversion;
+			specification[n] = '\0';
+			written = snprintf(buffer + length, size - length, specification, (int)argument.integer);
+			break;
+		case 'f':
+		case 'F':
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			specification[n++] = conversion;
+			specification[n] = '\0';
+			written = snprintf(buffer + length, size - length, specification,
+					argument.type == Types::floatingPoint ? argument.floatingPoint : (double)argument.integer);
+			break;
+		case 's':
+			specification[n++] = conversion;
+			specification[n] = '\0';
+			written = snprintf(buffer + length, size - length, specification,
+					argument.type == Types::string ? text_ + argument.textOffset : "<?>");
+			break;
+		case 'p':
+			specification[n++] = conversion;
+			specification[n] = '\0';
+			written = snprintf(buffer + length, size - length, specification, argument.pointer);
+			break;
+		default:
+			written = snprintf(buffer + length, size - length, "<?>");
+			break;
+		}
+		if (written > 0) {
+			advance(length, written, size);
+		}
+	}
+	buffer[length] = '\0';
+	return length;
+}
+
+
+/*******************************************************
+ * Sinks
+ *******************************************************/
+
+//! names of the levels
+static const char* levelNames[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+StderrLogSink::StderrLogSink()
+:isTerminal_(isatty(STDERR_FILENO))
+{
+
+}
+
+StderrLogSink::~StderrLogSink()
+{
+
+}
+
+void StderrLogSink::write(LogLevels level, int64_t time_ns, const char* message)
+{
+	if (isTerminal_ && level >= LogLevels::warn) {
+		fprintf(stderr, "%s[%s] %s\e[0m\n", level == LogLevels::error ? "\e[0;31m" : "\e[0;33m",
+				levelNames[(int)level], message);
+	} else {
+		fprintf(stderr, "[%s] %s\n", levelNames[(int)level], message);
+	}
+}
+
+FileLogSink::FileLogSink(const char* path)
+:file_(fopen(path, "a"))
+{
+	if (file_ == NULL) {
+		fprintf(stderr, "FileLogSink: Could not open %s!\n", path);
+	}
+}
+
+FileLogSink::~FileLogSink()
+{
+	if (file_ != NULL) {
+		fclose(file_);
+	}
+}
+
+bool FileLogSink::isOpen() const
+{
+	return file_ != NULL;
+}
+
+void FileLogSink::write(LogLevels level, int64_t time_ns, const char* message)
+{
+	if (file_ == NULL) {
+		return;
+	}
+	fprintf(file_, "[%s] [%lld.%09lld] %s\n", levelNames[(int)level],
+			(long long)(time_ns/1000000000LL), (long long)(time_ns%1000000000LL), message);
+	fflush(file_);
+}
+
+
+/*******************************************************
+ * Logger
+ *******************************************************/
+
+namespace {
+
+//! default sink
+StderrLogSink stderrSink;
+
+//! records that were not yet written
+MPSCQueue<LogRecord, Logger::queueSize> queue;
+
+//! current sink
+std::atomic<LogSink*> sink(&stderrSink);
+
+//! minimum severity
+std::atomic<int> level((int)LogLevels::info);
+
+//! number of dropped records
+std::atomic<unsigned int> nDroppedRecords(0);
+
+//! true while the background thread is running
+std::atomic<bool> isThreadRunning(false);
+
+//! serializes the consumers of the queue (background thread and flush())
+std::mutex consumerMutex;
+
+//! Writes a record to the sink
+void writeRecord(const LogRecord& record)
+{
+	char message[Logger::maxMessageLength];
+	record.format(message, sizeof(message));
+	sink.load()->write(record.getLevel(), record.getTime_ns(), message);
+}
+
+//! Background thread that empties the queue
+class LoggerThread {
+public:
+	~LoggerThread() {
+		/* the queued messages are written at exit */
+		stop();
+	}
+
+	void start(unsigned int period_ms) {
+		if (thread_.joinable()) {
+			return;
+		}
+		isStopping_ = false;
+		period_ms_ = period_ms;
+		isThreadRunning = true;
+		thread_ = std::thread(&LoggerThread::run, this);
+	}
+
+	void stop() {
+		if (!thread_.joinable()) {
+			return;
+		}
+		isStopping_ = true;
+		thread_.join();
+		isThreadRunning = false;
+		Logger::flush();
+	}
+
+private:
+	void run() {
+		while (!isStopping_) {
+			Logger::flush();
+			std::this_thread::sleep_for(std::chrono::milliseconds(period_ms_));
+		}
+	}
+
+	std::thread thread_;
+	std::atomic<bool> isStopping_;
+	unsigned int period_ms_;
+};
+
+//! destroyed before the queue, which is defined above
+LoggerThread loggerThread;
+
+}
+
+void Logger::setSink(LogSink* newSink)
+{
+	sink = (newSink == NULL) ? &stderrSink : newSink;
+}
+
+void Logger::setLevel(LogLevels newLevel)
+{
+	level = (int)newLevel;
+}
+
+LogLevels Logger::getLevel()
+{
+	return (LogLevels)level.load(std::memory_order_relaxed);
+}
+
+void Logger::start(unsigned int period_ms)
+{
+	loggerThread.start(period_ms);
+}
+
+void Logger::stop()
+{
+	loggerThread.stop();
+}
+
+bool Logger::isRunning()
+{
+	return isThreadRunning;
+}
+
+void Logger::flush()
+{
+	std::lock_guard<std::mutex> lock(consumerMutex);
+	LogRecord record;
+	while (queue.pop(record)) {
+		writeRecord(record);
+	}
+}
+
+unsigned int Logger::getNumberOfDroppedRecords()
+{
+	return nDroppedRecords;
+}
+
+void Logger::submit(const LogRecord& record)
+{
+	if (!isThreadRunning) {
+		writeRecord(record);
+		return;
+	}
+	if (!queue.push(record)) {
+		nDroppedRecords++;
+	}
+}
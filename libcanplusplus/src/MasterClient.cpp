@@ -0,0 +1,237 @@
+/*!
+ * @file 	MasterClient.cpp
+ * @brief	Client side of the shared memory interface of the master
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include "libcanplusplus/MasterClient.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+//! number of attempts to read a consistent snapshot
+const int maxReadAttempts = 1000;
+
+}
+
+MasterClient::MasterClient()
+:segment_(NULL),
+ client_(NULL),
+ generation_(0),
+ lastId_(0)
+{
+
+}
+
+MasterClient::~MasterClient()
+{
+	detach();
+}
+
+bool MasterClient::attach(const char* name, const char* clientName, int priority)
+{
+	if (segment_ != NULL) {
+		detach();
+	}
+
+	const int fd = shm_open(name, O_RDWR, 0);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat status;
+	if (fstat(fd, &status) != 0 || (size_t)status.st_size < sizeof(MasterSegment)) {
+		::close(fd);
+		return false;
+	}
+	void* memory = mmap(NULL, sizeof(MasterSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (memory == MAP_FAILED) {
+		return false;
+	}
+	MasterSegment* segment = (MasterSegment*) memory;
+	if (segment->magic.load(std::memory_order_acquire) != MasterSegment::magicNumber
+			|| segment->version != MasterSegment::layoutVersion
+			|| segment->size != sizeof(MasterSegment)) {
+		munmap(memory, sizeof(MasterSegment));
+		return false;
+	}
+
+	for (int i=0; i<MasterSegment::maxClients; i++) {
+		MasterClientSegment& client = segment->clients[i];
+		int32_t pid = 0;
+		if (!client.pid.compare_exchange_strong(pid, getpid(), std::memory_order_acq_rel)) {
+			continue;
+		}
+		client.priority.store(priority, std::memory_order_relaxed);
+		strncpy(client.name, clientName, MasterClientSegment::maxNameLength - 1);
+		client.name[MasterClientSegment::maxNameLength - 1] = '\0';
+		generation_ = client.generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+		/* the results of the former client of the slot are discarded */
+		MasterSDOResult result;
+		for (int iBus=0; iBus<MasterSegment::maxBuses; iBus++) {
+			while (client.buses[iBus].sdoResults.pop(result)) {
+			}
+			client.buses[iBus].nRejectedSetpoints.store(0, std::memory_order_relaxed);
+		}
+		segment_ = segment;
+		client_ = &client;
+		return true;
+	}
+	munmap(memory, sizeof(MasterSegment));
+	return false;
+}
+
+void MasterClient::detach()
+{
+	if (segment_ == NULL) {
+		return;
+	}
+	/* the setpoints of the client are not sent anymore */
+	client_->generation.fetch_add(1, std::memory_order_acq_rel);
+	client_->pid.store(0, std::memory_order_release);
+	munmap(segment_, sizeof(MasterSegment));
+	segment_ = NULL;
+	client_ = NULL;
+}
+
+bool MasterClient::isAttached() const
+{
+	return segment_ != NULL
+			&& segment_->magic.load(std::memory_order_acquire) == MasterSegment::magicNumber
+			&& client_->pid.load(std::memory_order_relaxed) == getpid()
+			&& (kill(segment_->pid, 0) == 0 || errno == EPERM);
+}
+
+bool MasterClient::isBusActive(int iBus) const
+{
+	return segment_ != NULL && iBus >= 0 && iBus < MasterSegment::maxBuses
+			&& segment_->buses[iBus].isActive.load(std::memory_order_acquire) != 0;
+}
+
+unsigned int MasterClient::getPeriod_us(int iBus) const
+{
+	if (!isBusActive(iBus)) {
+		return 0;
+	}
+	return segment_->buses[iBus].period_us;
+}
+
+bool MasterClient::readFrames(int iBus, const int* COBIds, int nFrames, CANMsg* frames, uint32_t* cycle) const
+{
+	if (!isBusActive(iBus)) {
+		return false;
+	}
+	const MasterBusSegment& bus = segment_->buses[iBus];
+	for (int attempt=0; attempt<maxReadAttempts; attempt++) {
+		/* seqlock: the frames are consistent if the sequence was even and did not change */
+		const uint32_t sequence = bus.sequence.load(std::memory_order_acquire);
+		if (sequence & 1) {
+			continue;
+		}
+		for (int i=0; i<nFrames; i++) {
+			if (COBIds[i] >= 0 && COBIds[i] < MasterBusSegment::nCOBIds) {
+				frames[i] = bus.frames[COBIds[i]];
+			} else {
+				frames[i].flag = 0;
+			}
+		}
+		const uint32_t snapshotCycle = bus.cycle.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (bus.sequence.load(std::memory_order_relaxed) == sequence) {
+			if (cycle != NULL) {
+				*cycle = snapshotCycle;
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+bool MasterClient::readFrame(int iBus, int COBId, CANMsg* frame) const
+{
+	return readFrames(iBus, &COBId, 1, frame);
+}
+
+bool MasterClient::submitSetpoint(int iBus, const CANMsg& frame)
+{
+	if (segment_ == NULL || iBus < 0 || iBus >= MasterSegment::maxBuses) {
+		return false;
+	}
+	MasterSetpoint setpoint;
+	setpoint.generation = generation_;
+	setpoint.frame = frame;
+	return client_->buses[iBus].setpoints.push(setpoint);
+}
+
+unsigned int MasterClient::getNumberOfRejectedSetpoints(int iBus) const
+{
+	if (segment_ == NULL || iBus < 0 || iBus >= MasterSegment::maxBuses) {
+		return 0;
+	}
+	return client_->buses[iBus].nRejectedSetpoints.load(std::memory_order_relaxed);
+}
+
+uint32_t MasterClient::queueSDORead(int iBus, int nodeId, int index, int subIndex)
+{
+	MasterSDORequest request;
+	request.nodeId = nodeId;
+	request.isWrite = 0;
+	request.length = 0;
+	request.index = index;
+	request.subIndex = subIndex;
+	request.value = 0;
+	return queueSDO(iBus, request);
+}
+
+uint32_t MasterClient::queueSDOWrite(int iBus, int nodeId, int index, int subIndex, int length, int32_t value)
+{
+	MasterSDORequest request;
+	request.nodeId = nodeId;
+	request.isWrite = 1;
+	request.length = length;
+	request.index = index;
+	request.subIndex = subIndex;
+	request.value = value;
+	return queueSDO(iBus, request);
+}
+
+uint32_t MasterClient::queueSDO(int iBus, MasterSDORequest& request)
+{
+	if (segment_ == NULL || iBus < 0 || iBus >= MasterSegment::maxBuses) {
+		return 0;
+	}
+	/* the identifier 0 tells that a request was not queued */
+	if (++lastId_ == 0) {
+		lastId_ = 1;
+	}
+	request.generation = generation_;
+	request.id = lastId_;
+	if (!client_->buses[iBus].sdoRequests.push(request)) {
+		return 0;
+	}
+	return request.id;
+}
+
+bool MasterClient::getSDOResult(int iBus, MasterSDOResult* result)
+{
+	if (segment_ == NULL || iBus < 0 || iBus >= MasterSegment::maxBuses) {
+		return false;
+	}
+	while (client_->buses[iBus].sdoResults.pop(*result)) {
+		if (result->generation == generation_) {
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,447 @@
+/*!
+ * @file 	MasterServer.cpp
+ * @brief	Daemon side of the shared memory interface of the master
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include "libcanplusplus/MasterServer.hpp"
+#include "libcanplusplus/Logger.hpp"
+#include "libcanplusplus/SDOReadMsg.hpp"
+#include "libcanplusplus/SDOWriteMsg.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <new>
+
+const char* const MasterServer::defaultName = "/libcanplusplus_master";
+
+MasterServer::MasterServer()
+:segment_(NULL),
+ lease_(100),
+ maxSDOsPerCycle_(4)
+{
+	for (int i=0; i<MasterSegment::maxBuses; i++) {
+		buses_[i] = NULL;
+	}
+}
+
+MasterServer::~MasterServer()
+{
+	close();
+}
+
+bool MasterServer::open(const char* name)
+{
+	if (segment_ != NULL) {
+		close();
+	}
+
+	/* the clients write their rings, hence the group may write the segment */
+	const int fd = shm_open(name, O_CREAT | O_RDWR, 0660);
+	if (fd < 0) {
+		Logger::log(LogLevels::error, "MasterServer: Could not create shared memory %s!", name);
+		return false;
+	}
+	if (ftruncate(fd, 0) != 0 || ftruncate(fd, sizeof(MasterSegment)) != 0) {
+		Logger::log(LogLevels::error, "MasterServer: Could not resize shared memory %s!", name);
+		::close(fd);
+		shm_unlink(name);
+		return false;
+	}
+	void* memory = mmap(NULL, sizeof(MasterSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (memory == MAP_FAILED) {
+		Logger::log(LogLevels::error, "MasterServer: Could not map shared memory %s!", name);
+		shm_unlink(name);
+		return false;
+	}
+
+	/* the rings are constructed in place, the magic number is written last */
+	segment_ = new (memory) MasterSegment();
+	segment_->version = MasterSegment::layoutVersion;
+	segment_->size = sizeof(MasterSegment);
+	segment_->nBuses = MasterSegment::maxBuses;
+	segment_->nClients = MasterSegment::maxClients;
+	segment_->pid = getpid();
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	segment_->startTime_ns = (int64_t)now.tv_sec*1000000000LL + now.tv_nsec;
+	segment_->magic.store(MasterSegment::magicNumber, std::memory_order_release);
+	name_ = name;
+	return true;
+}
+
+void MasterServer::close()
+{
+	for (int i=0; i<MasterSegment::maxBuses; i++) {
+		delete buses_[i];
+		buses_[i] = NULL;
+	}
+	if (segment_ == NULL) {
+		return;
+	}
+	segment_->magic.store(0, std::memory_order_release);
+	segment_->~MasterSegment();
+	munmap(segment_, sizeof(MasterSegment));
+	shm_unlink(name_.c_str());
+	segment_ = NULL;
+}
+
+bool MasterServer::addPipeline(CyclePipeline* pipeline)
+{
+	if (segment_ == NULL) {
+		Logger::log(LogLevels::error, "MasterServer: Could not add a pipeline, the segment is not open!");
+		return false;
+	}
+	Bus* bus = pipeline->getBus();
+	const int index = bus->iBus();
+	if (index < 0 || index >= MasterSegment::maxBuses || buses_[index] != NULL) {
+		Logger::log(LogLevels::error, "MasterServer: Could not add the pipeline of bus %d!", index);
+		return false;
+	}
+
+	BusState* state = new BusState();
+	state->server = this;
+	state->pipeline = pipeline;
+	state->index = index;
+	state->cycle = 0;
+	state->nReceived = 0;
+	for (int i=0; i<MasterBusSegment::nCOBIds; i++) {
+		state->setpointIndex[i] = -1;
+	}
+	for (int i=0; i<maxSetpoints; i++) {
+		state->setpoints[i].COBId = -1;
+	}
+	for (int i=0; i<MasterSegment::maxClients; i++) {
+		state->nPendingSDOs[i] = 0;
+	}
+	state->nAllPendingSDOs = 0;
+	state->nextClient = 0;
+	buses_[index] = state;
+
+	/* the SDOs of the clients are taken from the pools, each SDO has two messages */
+	SDOMsg::reservePool(maxPendingSDOs);
+	CANOpenMsg::reservePool(2*maxPendingSDOs);
+	bus->getSDOManager()->reserve(maxPendingSDOs);
+
+	MasterBusSegment& busSegment = segment_->buses[index];
+	busSegment.period_us = pipeline->getTimer()->getPeriod_us();
+	busSegment.isActive.store(1, std::memory_order_release);
+
+	pipeline->setControl(service, state);
+	pipeline->setHooks(receiveFrame, transmitFrames, state);
+	return true;
+}
+
+void MasterServer::setLease(unsigned int nCycles)
+{
+	lease_ = nCycles;
+}
+
+void MasterServer::setMaxSDOsPerCycle(unsigned int maxSDOs)
+{
+	maxSDOsPerCycle_ = maxSDOs;
+}
+
+int MasterServer::reapClients()
+{
+	if (segment_ == NULL) {
+		return 0;
+	}
+	int nReaped = 0;
+	for (int i=0; i<MasterSegment::maxClients; i++) {
+		MasterClientSegment& client = segment_->clients[i];
+		int32_t pid = client.pid.load(std::memory_order_acquire);
+		if (pid == 0 || kill(pid, 0) == 0 || errno != ESRCH) {
+			continue;
+		}
+		/* the setpoints and SDOs of the former generation are discarded by the cycles */
+		client.generation.fetch_add(1, std::memory_order_acq_rel);
+		if (client.pid.compare_exchange_strong(pid, 0, std::memory_order_acq_rel)) {
+			Logger::log(LogLevels::warn, "MasterServer: Client %d (%s) terminated without detaching.",
+					(int)pid, client.name);
+			nReaped++;
+		}
+	}
+	return nReaped;
+}
+
+int MasterServer::getNumberOfClients() const
+{
+	if (segment_ == NULL) {
+		return 0;
+	}
+	int nClients = 0;
+	for (int i=0; i<MasterSegment::maxClients; i++) {
+		if (segment_->clients[i].pid.load(std::memory_order_relaxed) != 0) {
+			nClients++;
+		}
+	}
+	return nClients;
+}
+
+MasterSegment* MasterServer::getSegment()
+{
+	return segment_;
+}
+
+void MasterServer::service(void* busState)
+{
+	BusState& bus = *(BusState*) busState;
+	MasterServer* server = bus.server;
+	bus.cycle++;
+	server->publishFrames(bus);
+	server->takeSetpoints(bus);
+	server->completeSDOs(bus);
+	server->takeSDORequests(bus);
+}
+
+void MasterServer::receiveFrame(const CANMsg& frame, void* busState)
+{
+	BusState& bus = *(BusState*) busState;
+	if (frame.COBId < 0 || frame.COBId >= MasterBusSegment::nCOBIds) {
+		return;
+	}
+	CANMsg& received = bus.received[frame.COBId];
+	if (received.flag == 0) {
+		bus.receivedCOBIds[bus.nReceived++] = (int16_t)frame.COBId;
+	}
+	received = frame;
+	received.flag = 1;
+}
+
+void MasterServer::transmitFrames(TransmitScheduler* scheduler, void* busState)
+{
+	BusState& bus = *(BusState*) busState;
+	for (int i=0; i<maxSetpoints; i++) {
+		if (bus.setpoints[i].COBId >= 0) {
+			scheduler->addFrame(bus.setpoints[i].frame);
+		}
+	}
+}
+
+void MasterServer::publishFrames(BusState& bus)
+{
+	MasterBusSegment& busSegment = segment_->buses[bus.index];
+
+	/* seqlock: the sequence is odd while the frames are written */
+	const uint32_t sequence = busSegment.sequence.load(std::memory_order_relaxed);
+	busSegment.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	for (int i=0; i<bus.nReceived; i++) {
+		CANMsg& received = bus.received[bus.receivedCOBIds[i]];
+		CANMsg& published = busSegment.frames[bus.receivedCOBIds[i]];
+		published = received;
+		published.sequence = bus.cycle;
+		received.flag = 0;
+	}
+	busSegment.cycle.store(bus.cycle, std::memory_order_relaxed);
+	busSegment.sequence.store(sequence + 2, std::memory_order_release);
+	bus.nReceived = 0;
+}
+
+void MasterServer::takeSetpoints(BusState& bus)
+{
+	for (int i=0; i<MasterSegment::maxClients; i++) {
+		MasterClientSegment& client = segment_->clients[i];
+		if (client.pid.load(std::memory_order_acquire) == 0) {
+			continue;
+		}
+		MasterClientBus& rings = client.buses[bus.index];
+		MasterSetpoint setpoint;
+		while (rings.setpoints.pop(setpoint)) {
+			/* the generation is read after the setpoint, such that a new client is not missed */
+			if (setpoint.generation != client.generation.load(std::memory_order_acquire)) {
+				continue;
+			}
+			if (!applySetpoint(bus, i, setpoint)) {
+				rings.nRejectedSetpoints.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/* the COB-IDs whose owner detached or whose lease expired are free again */
+	for (int i=0; i<maxSetpoints; i++) {
+		Setpoint& setpoint = bus.setpoints[i];
+		if (setpoint.COBId >= 0 && !isOwned(bus, setpoint)) {
+			bus.setpointIndex[setpoint.COBId] = -1;
+			setpoint.COBId = -1;
+		}
+	}
+}
+
+bool MasterServer::applySetpoint(BusState& bus, int client, const MasterSetpoint& setpoint)
+{
+	const int COBId = setpoint.frame.COBId;
+	if (COBId < 0 || COBId >= MasterBusSegment::nCOBIds) {
+		return false;
+	}
+
+	int index = bus.setpointIndex[COBId];
+	if (index >= 0) {
+		const Setpoint& owned = bus.setpoints[index];
+		if ((owned.client != client || owned.generation != setpoint.generation) && isOwned(bus, owned)
+				&& segment_->clients[client].priority.load(std::memory_order_relaxed)
+				<= segment_->clients[owned.client].priority.load(std::memory_order_relaxed)) {
+			return false;
+		}
+	} else {
+		for (int i=0; i<maxSetpoints; i++) {
+			if (bus.setpoints[i].COBId < 0) {
+				index = i;
+				break;
+			}
+		}
+		if (index < 0) {
+			return false;
+		}
+		bus.setpointIndex[COBId] = (int16_t)index;
+	}
+
+	Setpoint& entry = bus.setpoints[index];
+	entry.COBId = COBId;
+	entry.client = client;
+	entry.generation = setpoint.generation;
+	entry.cycle = bus.cycle;
+	entry.frame = setpoint.frame;
+	entry.frame.flag = 1;
+	return true;
+}
+
+bool MasterServer::isOwned(const BusState& bus, const Setpoint& setpoint) const
+{
+	const MasterClientSegment& owner = segment_->clients[setpoint.client];
+	return owner.pid.load(std::memory_order_relaxed) != 0
+			&& owner.generation.load(std::memory_order_relaxed) == setpoint.generation
+			&& bus.cycle - setpoint.cycle <= lease_;
+}
+
+void MasterServer::completeSDOs(BusState& bus)
+{
+	for (int i=0; i<maxPendingSDOs; i++) {
+		PendingSDO& pending = bus.sdos[i];
+		SDOMsg* sdo = pending.sdo.get();
+		if (sdo == NULL) {
+			continue;
+		}
+
+		bool isReturned;
+		if (sdo->getIsReceived()) {
+			if (sdo->isAborted()) {
+				isReturned = returnResult(bus, pending.client, pending.request,
+						MasterSDOStatus::aborted, sdo->getAbortCode(), 0);
+			} else {
+				isReturned = returnResult(bus, pending.client, pending.request,
+						MasterSDOStatus::completed, 0, pending.request.isWrite ? 0 : sdo->readint32());
+			}
+		} else if (sdo->hasTimeOut()) {
+			isReturned = returnResult(bus, pending.client, pending.request, MasterSDOStatus::timeout, 0, 0);
+		} else {
+			continue;
+		}
+		if (!isReturned) {
+			/* the ring of the results is full, the result is returned in the next cycle */
+			continue;
+		}
+		pending.sdo.reset();
+		bus.nPendingSDOs[pending.client]--;
+		bus.nAllPendingSDOs--;
+	}
+}
+
+void MasterServer::takeSDORequests(BusState& bus)
+{
+	/* one request per client and round, the first client changes every cycle */
+	unsigned int nTaken = 0;
+	bool isTaken = true;
+	while (isTaken) {
+		isTaken = false;
+		for (int k=0; k<MasterSegment::maxClients; k++) {
+			if (nTaken >= maxSDOsPerCycle_ || bus.nAllPendingSDOs >= maxPendingSDOs) {
+				break;
+			}
+			const int i = (bus.nextClient + k)%MasterSegment::maxClients;
+			MasterClientSegment& client = segment_->clients[i];
+			if (client.pid.load(std::memory_order_acquire) == 0
+					|| bus.nPendingSDOs[i] >= maxPendingSDOsPerClient) {
+				continue;
+			}
+			MasterSDORequest request;
+			if (!client.buses[bus.index].sdoRequests.pop(request)) {
+				continue;
+			}
+			isTaken = true;
+			if (request.generation != client.generation.load(std::memory_order_acquire)) {
+				continue;
+			}
+			queueSDO(bus, i, request);
+			nTaken++;
+		}
+	}
+	bus.nextClient = (bus.nextClient + 1)%MasterSegment::maxClients;
+}
+
+void MasterServer::queueSDO(BusState& bus, int client, const MasterSDORequest& request)
+{
+	if (request.nodeId < 1 || request.nodeId > 127
+			|| request.index < 0 || request.index > 0xFFFF
+			|| request.subIndex < 0 || request.subIndex > 0xFF
+			|| (request.isWrite && request.length != 1 && request.length != 2 && request.length != 4)) {
+		returnResult(bus, client, request, MasterSDOStatus::rejected, 0, 0);
+		return;
+	}
+
+	int index = -1;
+	for (int i=0; i<maxPendingSDOs; i++) {
+		if (bus.sdos[i].sdo.get() == NULL) {
+			index = i;
+			break;
+		}
+	}
+	if (index < 0) {
+		returnResult(bus, client, request, MasterSDOStatus::rejected, 0, 0);
+		return;
+	}
+
+	PendingSDO& pending = bus.sdos[index];
+	if (request.isWrite) {
+		/* command specifier of an expedited download of 1, 2 or 4 bytes */
+		const char command = (request.length == 1) ? 0x2F : ((request.length == 2) ? 0x2B : 0x23);
+		pending.sdo = SDOMsgPtr(new SDOWriteMsg(SlotMap::autoSlot, SlotMap::autoSlot, request.nodeId,
+				command, request.index, request.subIndex, request.value));
+	} else {
+		pending.sdo = SDOMsgPtr(new SDOReadMsg(SlotMap::autoSlot, SlotMap::autoSlot, request.nodeId,
+				request.index, request.subIndex));
+	}
+	pending.client = client;
+	pending.request = request;
+	bus.nPendingSDOs[client]++;
+	bus.nAllPendingSDOs++;
+	bus.pipeline->getBus()->getSDOManager()->addSDO(pending.sdo);
+}
+
+bool MasterServer::returnResult(BusState& bus, int client, const MasterSDORequest& request,
+		MasterSDOStatus status, uint32_t abortCode, int32_t value)
+{
+	MasterClientSegment& clientSegment = segment_->clients[client];
+	if (clientSegment.pid.load(std::memory_order_acquire) == 0
+			|| clientSegment.generation.load(std::memory_order_acquire) != request.generation) {
+		/* the client detached, the result is discarded */
+		return true;
+	}
+	MasterSDOResult result;
+	result.generation = request.generation;
+	result.id = request.id;
+	result.status = status;
+	result.abortCode = abortCode;
+	result.value = value;
+	return clientSegment.buses[bus.index].sdoResults.push(result);
+}
@@ -0,0 +1,134 @@
+/*!
+ * @file 	MemoryPool.cpp
+ * @brief	Pool of memory blocks with a fixed size
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include <new>
+#include "libcanplusplus/MemoryPool.hpp"
+
+//! minimum number of blocks of a chunk
+static const size_t minBlocksPerChunk = 16;
+
+MemoryPool::MemoryPool(size_t blockSize)
+:blockSize_((blockSize + headerSize - 1)/headerSize*headerSize),
+ stride_(blockSize_ + headerSize),
+ freeBlocks_(NULL),
+ chunks_(NULL),
+ nBlocks_(0),
+ nUsedBlocks_(0)
+{
+	isLocked_.clear();
+}
+
+MemoryPool::~MemoryPool()
+{
+	while (chunks_ != NULL) {
+		void* next = *static_cast<void**>(chunks_);
+		::operator delete(chunks_);
+		chunks_ = next;
+	}
+}
+
+void MemoryPool::reserve(size_t nBlocks)
+{
+	lock();
+	if (nBlocks > nBlocks_) {
+		addChunk(nBlocks - nBlocks_);
+	}
+	unlock();
+}
+
+size_t MemoryPool::getBlockSize() const
+{
+	return blockSize_;
+}
+
+size_t MemoryPool::getNumberOfBlocks() const
+{
+	return nBlocks_;
+}
+
+size_t MemoryPool::getNumberOfUsedBlocks() const
+{
+	return nUsedBlocks_;
+}
+
+void* MemoryPool::allocateBlock(MemoryPool& pool, size_t size)
+{
+	char* block;
+	if (size > pool.blockSize_) {
+		block = static_cast<char*>(::operator new(size + headerSize));
+		*reinterpret_cast<MemoryPool**>(block) = NULL;
+	} else {
+		block = static_cast<char*>(pool.takeBlock());
+		*reinterpret_cast<MemoryPool**>(block) = &pool;
+	}
+	return block + headerSize;
+}
+
+void MemoryPool::deallocateBlock(void* p)
+{
+	if (p == NULL) {
+		return;
+	}
+	char* block = static_cast<char*>(p) - headerSize;
+	MemoryPool* pool = *reinterpret_cast<MemoryPool**>(block);
+	if (pool == NULL) {
+		::operator delete(block);
+	} else {
+		pool->putBlock(block);
+	}
+}
+
+void* MemoryPool::takeBlock()
+{
+	lock();
+	if (freeBlocks_ == NULL) {
+		/* the pool is exhausted, double its size */
+		addChunk(nBlocks_ > minBlocksPerChunk ? nBlocks_ : minBlocksPerChunk);
+	}
+	void* block = freeBlocks_;
+	freeBlocks_ = *static_cast<void**>(block);
+	nUsedBlocks_++;
+	unlock();
+	return block;
+}
+
+void MemoryPool::putBlock(void* block)
+{
+	lock();
+	*static_cast<void**>(block) = freeBlocks_;
+	freeBlocks_ = block;
+	nUsedBlocks_--;
+	unlock();
+}
+
+void MemoryPool::addChunk(size_t nBlocks)
+{
+	/* the first header of the chunk links the chunks */
+	char* chunk = static_cast<char*>(::operator new(headerSize + nBlocks*stride_));
+	*reinterpret_cast<void**>(chunk) = chunks_;
+	chunks_ = chunk;
+
+	for (size_t i=0; i<nBlocks; i++) {
+		void* block = chunk + headerSize + i*stride_;
+		*static_cast<void**>(block) = freeBlocks_;
+		freeBlocks_ = block;
+	}
+	nBlocks_ += nBlocks;
+}
+
+void MemoryPool::lock()
+{
+	while (isLocked_.test_and_set(std::memory_order_acquire)) {
+	}
+}
+
+void MemoryPool::unlock()
+{
+	isLocked_.clear(std::memory_order_release);
+}
@@ -0,0 +1,230 @@
+/*!
+ * @file 	Metrics.cpp
+ * @brief	Counters of the buses and nodes in a shared memory segment
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include "libcanplusplus/Metrics.hpp"
+#include "libcanplusplus/Logger.hpp"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <string>
+
+const char* const Metrics::defaultName = "/libcanplusplus_metrics";
+
+namespace {
+
+//! abort codes that are counted separately (CiA 301), the last entry counts the others
+const uint32_t abortCodes[NodeMetrics::nAbortCodes] = {
+		0x05030000,	// toggle bit not alternated
+		0x05040000,	// SDO protocol timed out
+		0x05040001,	// command specifier not valid or unknown
+		0x06010000,	// unsupported access to an object
+		0x06010001,	// attempt to read a write only object
+		0x06010002,	// attempt to write a read only object
+		0x06020000,	// object does not exist in the object dictionary
+		0x06040041,	// object cannot be mapped to the PDO
+		0x06040042,	// number and length of the objects exceed the PDO length
+		0x06070010,	// data type does not match
+		0x06090011,	// sub-index does not exist
+		0x06090030,	// value range of parameter exceeded
+		0x08000000,	// general error
+		0x08000020,	// data cannot be transferred or stored
+		0x08000022,	// data cannot be transferred because of the present device state
+		0x00000000	// other codes
+};
+
+//! counters as long as there is no shared memory segment
+MetricsSegment localSegment;
+
+//! counters of the buses or nodes that are out of range
+BusMetrics dummyBus;
+NodeMetrics dummyNode;
+
+//! segment that is written, NULL until the first counter is accessed
+std::atomic<MetricsSegment*> segment(NULL);
+
+//! shared memory segment, NULL if not open
+MetricsSegment* sharedSegment = NULL;
+
+//! name of the shared memory segment
+std::string sharedName;
+
+//! Writes the header of a segment
+void initializeHeader(MetricsSegment& header)
+{
+	header.magic = MetricsSegment::magicNumber;
+	header.version = MetricsSegment::layoutVersion;
+	header.size = sizeof(MetricsSegment);
+	header.nBuses = MetricsSegment::maxBuses;
+	header.nNodes = MetricsSegment::maxNodes;
+	header.nAbortCodes = NodeMetrics::nAbortCodes;
+	header.pid = getpid();
+	header.reserved = 0;
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	header.startTime_ns = (int64_t)now.tv_sec*1000000000LL + now.tv_nsec;
+	memcpy(header.abortCodes, abortCodes, sizeof(abortCodes));
+}
+
+//! Adds the counters of a segment to those of another segment and resets them
+void moveCounters(MetricsSegment& from, MetricsSegment& to)
+{
+	/* the buses and nodes consist of counters only, hence they are counted as arrays */
+	const size_t nBusCounters = MetricsSegment::maxBuses*sizeof(BusMetrics)/sizeof(MetricsCounter);
+	MetricsCounter* fromBuses = (MetricsCounter*) from.buses;
+	MetricsCounter* toBuses = (MetricsCounter*) to.buses;
+	for (size_t i=0; i<nBusCounters; i++) {
+		toBuses[i].fetch_add(fromBuses[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+	const size_t nNodeCounters = MetricsSegment::maxBuses*MetricsSegment::maxNodes*sizeof(NodeMetrics)/sizeof(MetricsCounter);
+	MetricsCounter* fromNodes = (MetricsCounter*) from.nodes;
+	MetricsCounter* toNodes = (MetricsCounter*) to.nodes;
+	for (size_t i=0; i<nNodeCounters; i++) {
+		toNodes[i].fetch_add(fromNodes[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+}
+
+}
+
+bool Metrics::open(const char* name)
+{
+	if (sharedSegment != NULL) {
+		close();
+	}
+
+	const int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+	if (fd < 0) {
+		Logger::log(LogLevels::error, "Metrics: Could not create shared memory %s!", name);
+		return false;
+	}
+	if (ftruncate(fd, 0) != 0 || ftruncate(fd, sizeof(MetricsSegment)) != 0) {
+		Logger::log(LogLevels::error, "Metrics: Could not resize shared memory %s!", name);
+		::close(fd);
+		shm_unlink(name);
+		return false;
+	}
+	void* memory = mmap(NULL, sizeof(MetricsSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (memory == MAP_FAILED) {
+		Logger::log(LogLevels::error, "Metrics: Could not map shared memory %s!", name);
+		shm_unlink(name);
+		return false;
+	}
+
+	/* ftruncate() zeroed the counters, the counts of the process are kept */
+	sharedSegment = (MetricsSegment*) memory;
+	initializeHeader(*sharedSegment);
+	sharedName = name;
+	MetricsSegment& local = getSegment();
+	moveCounters(local, *sharedSegment);
+	segment.store(sharedSegment, std::memory_order_release);
+	/* increments that used the local segment while it was switched */
+	moveCounters(local, *sharedSegment);
+	return true;
+}
+
+void Metrics::close()
+{
+	if (sharedSegment == NULL) {
+		return;
+	}
+	segment.store(&localSegment, std::memory_order_release);
+	moveCounters(*sharedSegment, localSegment);
+	munmap(sharedSegment, sizeof(MetricsSegment));
+	shm_unlink(sharedName.c_str());
+	sharedSegment = NULL;
+}
+
+bool Metrics::isShared()
+{
+	return sharedSegment != NULL;
+}
+
+const MetricsSegment* Metrics::attach(const char* name)
+{
+	const int fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0) {
+		return NULL;
+	}
+	struct stat status;
+	if (fstat(fd, &status) != 0 || (size_t)status.st_size < sizeof(MetricsSegment)) {
+		::close(fd);
+		return NULL;
+	}
+	void* memory = mmap(NULL, sizeof(MetricsSegment), PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (memory == MAP_FAILED) {
+		return NULL;
+	}
+	const MetricsSegment* attached = (const MetricsSegment*) memory;
+	if (attached->magic != MetricsSegment::magicNumber
+			|| attached->version != MetricsSegment::layoutVersion
+			|| attached->size != sizeof(MetricsSegment)) {
+		munmap(memory, sizeof(MetricsSegment));
+		return NULL;
+	}
+	return attached;
+}
+
+void Metrics::detach(const MetricsSegment* attached)
+{
+	if (attached != NULL) {
+		munmap((void*)attached, sizeof(MetricsSegment));
+	}
+}
+
+MetricsSegment& Metrics::getSegment()
+{
+	MetricsSegment* current = segment.load(std::memory_order_acquire);
+	if (current == NULL) {
+		initializeHeader(localSegment);
+		if (!segment.compare_exchange_strong(current, &localSegment, std::memory_order_acq_rel)) {
+			/* another thread opened the segment meanwhile */
+			return *current;
+		}
+		current = &localSegment;
+	}
+	return *current;
+}
+
+BusMetrics& Metrics::getBus(int iBus)
+{
+	if (iBus < 0 || iBus >= MetricsSegment::maxBuses) {
+		return dummyBus;
+	}
+	return getSegment().buses[iBus];
+}
+
+NodeMetrics& Metrics::getNode(int iBus, int nodeId)
+{
+	if (iBus < 0 || iBus >= MetricsSegment::maxBuses || nodeId < 0 || nodeId >= MetricsSegment::maxNodes) {
+		return dummyNode;
+	}
+	return getSegment().nodes[iBus][nodeId];
+}
+
+void Metrics::countSDOAbort(int iBus, int nodeId, uint32_t code)
+{
+	NodeMetrics& node = getNode(iBus, nodeId);
+	increment(node.sdoAborts);
+	increment(node.sdoAbortsByCode[getAbortCodeIndex(code)]);
+}
+
+int Metrics::getAbortCodeIndex(uint32_t code)
+{
+	for (int i=0; i<NodeMetrics::nAbortCodes-1; i++) {
+		if (abortCodes[i] == code) {
+			return i;
+		}
+	}
+	return NodeMetrics::nAbortCodes-1;
+}
@@ -10,11 +10,20 @@
 
 #include "libcanplusplus/PDOManager.hpp"
 
-#include <stdexcept>
-#include <boost/lexical_cast.hpp>
-#include <iostream>
+#include "libcanplusplus/Logger.hpp"
 
-PDOManager::PDOManager():isSending_(false)
+//! Greatest common divisor
+static unsigned int gcd(unsigned int a, unsigned int b)
+{
+	while (b != 0) {
+		const unsigned int r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+PDOManager::PDOManager():isSending_(false), slots_(NULL)
 {
 
 }
@@ -25,9 +34,21 @@ PDOManager::~PDOManager()
 
 void PDOManager::addPDO(CANOpenMsg* pdo)
 {
+	if (slots_ != NULL) {
+		if (pdo->getSMId() == SlotMap::autoSlot) {
+			pdo->setSMId(slots_->allocate(pdo->getCOBId()));
+		} else if (pdo->getSMId() >= 0) {
+			slots_->assign(pdo->getCOBId(), pdo->getSMId());
+		}
+	}
 	pdos_.push_back(pdo);
 }
 
+void PDOManager::setSlotMap(SlotMap* slots)
+{
+	slots_ = slots;
+}
+
 int PDOManager::getSize()
 {
 	return pdos_.size();
@@ -42,26 +63,72 @@ CANOpenMsg* PDOManager::getPDOWithCOBId(unsigned int id) {
     return NULL;
 }
 
-CANOpenMsg* PDOManager::getPDO(unsigned int index)
+void PDOManager::reserve(unsigned int nPDOs)
 {
-	try {
-		if (index >= pdos_.size()) {
-			std::string error = "PDOManager: Could not get PDO with index "
-								+ boost::lexical_cast<std::string>(index) + "!";
-			throw std::out_of_range(error);
-		}
-		return &(pdos_[index]);
+	pdos_.reserve(nPDOs);
+}
 
-	} catch (std::exception& e) {
-		std::cout << e.what() << std::endl;
+CANOpenMsg* PDOManager::getPDO(unsigned int index)
+{
+	if (index >= pdos_.size()) {
+		Logger::log(LogLevels::error, "PDOManager: Could not get PDO with index %u!", index);
+		return NULL;
 	}
-	return NULL;
+	return &(pdos_[index]);
 }
 
 void PDOManager::setSending(bool isSending)
 {
+	if (isSending && !isSending_) {
+		/* the nodes may have missed the last commands */
+		for (unsigned int i=0; i<pdos_.size(); i++) {
+			pdos_[i].forceTransmission();
+		}
+	}
 	isSending_ = isSending;
 }
+
+void PDOManager::setTransmissionPolicy(CANOpenMsg::TransmissionPolicies policy, unsigned int refreshPeriod)
+{
+	for (unsigned int i=0; i<pdos_.size(); i++) {
+		if (pdos_[i].getCOBId() != canopen::RxPDOSyncId) {
+			pdos_[i].setTransmissionPolicy(policy, refreshPeriod);
+		}
+	}
+}
+unsigned int PDOManager::setRateDivisor(CANOpenMsg* pdo, unsigned int divisor)
+{
+	if (divisor <= 1) {
+		pdo->setRateDivisor(1, 0);
+		return 0;
+	}
+
+	/* PDO j with divisor d_j and phase p_j is sent together with phase p in a
+	 * fraction g/d_j of the cycles of phase p if p = p_j mod g with g = gcd(divisor, d_j) */
+	unsigned int bestPhase = 0;
+	double bestLoad = 0.0;
+	for (unsigned int phase=0; phase<divisor; phase++) {
+		double load = 0.0;
+		for (unsigned int i=0; i<pdos_.size(); i++) {
+			const CANOpenMsg& other = pdos_[i];
+			if (&other == pdo || other.getRateDivisor() <= 1) {
+				continue;
+			}
+			const unsigned int g = gcd(divisor, other.getRateDivisor());
+			if (phase % g == other.getRatePhase() % g) {
+				load += (double)g/(double)other.getRateDivisor();
+			}
+		}
+		if (phase == 0 || load < bestLoad) {
+			bestPhase = phase;
+			bestLoad = load;
+		}
+	}
+
+	pdo->setRateDivisor(divisor, bestPhase);
+	return bestPhase;
+}
+
 bool PDOManager::isSending()
 {
 	return isSending_;
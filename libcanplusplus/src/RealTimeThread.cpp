@@ -0,0 +1,296 @@
+/*!
+ * @file 	RealTimeThread.cpp
+ * @brief	Creation of real-time threads and periodic timing of their cycles
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include "libcanplusplus/RealTimeThread.hpp"
+#include "libcanplusplus/Logger.hpp"
+
+#include <alloca.h>
+#include <errno.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/*******************************************************
+ * RealTimeThread
+ *******************************************************/
+
+namespace {
+
+//! arguments of the start routine of a thread
+struct StartArguments {
+	void* (*routine)(void*);
+	void* arg;
+	size_t prefaultStackSize;
+};
+
+//! Touches the stack of the calling thread, such that its pages are mapped
+void __attribute__((noinline)) prefaultStack(size_t size)
+{
+	volatile char* stack = (volatile char*) alloca(size);
+	const size_t pageSize = sysconf(_SC_PAGESIZE);
+	for (size_t i=0; i<size; i+=pageSize) {
+		stack[i] = 0;
+	}
+}
+
+//! Start routine that prefaults the stack before it invokes the routine of the thread
+void* startThread(void* arg)
+{
+	StartArguments arguments = *(StartArguments*) arg;
+	delete (StartArguments*) arg;
+	if (arguments.prefaultStackSize > 0) {
+		prefaultStack(arguments.prefaultStackSize);
+	}
+	return arguments.routine(arguments.arg);
+}
+
+//! Checks if the CPU set is empty
+bool isEmpty(const cpu_set_t& cpus)
+{
+	return CPU_COUNT(&cpus) == 0;
+}
+
+}
+
+RealTimeThread::Parameters::Parameters()
+:policy(SCHED_FIFO),
+ priority(80),
+ stackSize(512*1024),
+ prefaultStackSize(64*1024)
+{
+	CPU_ZERO(&cpus);
+}
+
+bool RealTimeThread::lockMemory(size_t prefaultHeapSize)
+{
+	if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+		Logger::log(LogLevels::warn, "RealTimeThread: Could not lock the memory (%s)!", strerror(errno));
+		return false;
+	}
+
+	/* freed memory stays in the heap, large blocks are not mapped separately */
+	mallopt(M_TRIM_THRESHOLD, -1);
+	mallopt(M_MMAP_MAX, 0);
+
+	if (prefaultHeapSize > 0) {
+		char* heap = (char*) malloc(prefaultHeapSize);
+		if (heap != NULL) {
+			const size_t pageSize = sysconf(_SC_PAGESIZE);
+			for (size_t i=0; i<prefaultHeapSize; i+=pageSize) {
+				((volatile char*)heap)[i] = 0;
+			}
+			free(heap);
+		}
+	}
+	return true;
+}
+
+int RealTimeThread::create(pthread_t* thread, void* (*routine)(void*), void* arg, const Parameters& parameters)
+{
+	StartArguments* arguments = new StartArguments;
+	arguments->routine = routine;
+	arguments->arg = arg;
+	arguments->prefaultStackSize = parameters.prefaultStackSize;
+	if (parameters.stackSize > 0 && arguments->prefaultStackSize > parameters.stackSize/2) {
+		arguments->prefaultStackSize = parameters.stackSize/2;
+	}
+
+	pthread_attr_t attributes;
+	pthread_attr_init(&attributes);
+	if (parameters.stackSize > 0) {
+		pthread_attr_setstacksize(&attributes, parameters.stackSize);
+	}
+	if (!isEmpty(parameters.cpus)) {
+		pthread_attr_setaffinity_np(&attributes, sizeof(parameters.cpus), &parameters.cpus);
+	}
+	struct sched_param schedulingParameters;
+	memset(&schedulingParameters, 0, sizeof(schedulingParameters));
+	schedulingParameters.sched_priority = parameters.priority;
+	pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+	pthread_attr_setschedpolicy(&attributes, parameters.policy);
+	pthread_attr_setschedparam(&attributes, &schedulingParameters);
+
+	int result = pthread_create(thread, &attributes, startThread, arguments);
+	if (result == EPERM) {
+		/* not permitted, the thread runs with the policy of the process */
+		Logger::log(LogLevels::warn, "RealTimeThread: Not permitted to use policy %d with priority %d, the default policy is used!",
+				parameters.policy, parameters.priority);
+		pthread_attr_setinheritsched(&attributes, PTHREAD_INHERIT_SCHED);
+		result = pthread_create(thread, &attributes, startThread, arguments);
+	}
+	pthread_attr_destroy(&attributes);
+
+	if (result != 0) {
+		Logger::log(LogLevels::error, "RealTimeThread: Could not create the thread (%s)!", strerror(result));
+		delete arguments;
+	}
+	return result;
+}
+
+bool RealTimeThread::configureCurrentThread(const Parameters& parameters)
+{
+	bool isSuccessful = true;
+	if (!isEmpty(parameters.cpus)
+			&& pthread_setaffinity_np(pthread_self(), sizeof(parameters.cpus), &parameters.cpus) != 0) {
+		Logger::log(LogLevels::warn, "RealTimeThread: Could not set the CPU affinity!");
+		isSuccessful = false;
+	}
+	struct sched_param schedulingParameters;
+	memset(&schedulingParameters, 0, sizeof(schedulingParameters));
+	schedulingParameters.sched_priority = parameters.priority;
+	const int result = pthread_setschedparam(pthread_self(), parameters.policy, &schedulingParameters);
+	if (result != 0) {
+		Logger::log(LogLevels::warn, "RealTimeThread: Could not set policy %d with priority %d (%s)!",
+				parameters.policy, parameters.priority, strerror(result));
+		isSuccessful = false;
+	}
+	if (parameters.prefaultStackSize > 0) {
+		prefaultStack(parameters.prefaultStackSize);
+	}
+	return isSuccessful;
+}
+
+
+/*******************************************************
+ * PeriodicTimer
+ *******************************************************/
+
+namespace {
+
+const int64_t nanosecondsPerSecond = 1000000000LL;
+
+int64_t toNanoseconds(const struct timespec& time)
+{
+	return (int64_t)time.tv_sec*nanosecondsPerSecond + time.tv_nsec;
+}
+
+struct timespec toTimespec(int64_t time_ns)
+{
+	struct timespec time;
+	time.tv_sec = time_ns/nanosecondsPerSecond;
+	time.tv_nsec = time_ns%nanosecondsPerSecond;
+	return time;
+}
+
+int64_t now_ns()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return toNanoseconds(now);
+}
+
+//! Sleeps until an absolute time of CLOCK_MONOTONIC, resumes after signals
+void sleepUntilTime(int64_t time_ns)
+{
+	const struct timespec time = toTimespec(time_ns);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, NULL) == EINTR) {
+	}
+}
+
+}
+
+PeriodicTimer::PeriodicTimer(unsigned int period_us)
+:period_ns_((int64_t)(period_us > 0 ? period_us : 1)*1000),
+ nMissedDeadlines_(0),
+ maxLateness_ns_(0)
+{
+	start();
+}
+
+PeriodicTimer::~PeriodicTimer()
+{
+
+}
+
+void PeriodicTimer::start()
+{
+	clock_gettime(CLOCK_MONOTONIC, &cycleStart_);
+}
+
+bool PeriodicTimer::waitForNextCycle()
+{
+	int64_t deadline_ns = toNanoseconds(cycleStart_) + period_ns_;
+	const int64_t current_ns = now_ns();
+
+	bool isOnTime = true;
+	if (current_ns > deadline_ns) {
+		/* the deadlines that have passed are skipped */
+		const int64_t nMissed = (current_ns - deadline_ns)/period_ns_ + 1;
+		const int64_t lateness_ns = current_ns - deadline_ns;
+		if (lateness_ns > maxLateness_ns_) {
+			maxLateness_ns_ = lateness_ns;
+		}
+		nMissedDeadlines_ += nMissed;
+		deadline_ns += nMissed*period_ns_;
+		isOnTime = false;
+		Logger::log(LogLevels::debug, "PeriodicTimer: Missed %d deadlines, %d us late",
+				(int)nMissed, (int)(lateness_ns/1000));
+	}
+
+	sleepUntilTime(deadline_ns);
+	cycleStart_ = toTimespec(deadline_ns);
+
+	/* wake-up latency */
+	const int64_t latency_ns = now_ns() - deadline_ns;
+	if (latency_ns > maxLateness_ns_) {
+		maxLateness_ns_ = latency_ns;
+	}
+	return isOnTime;
+}
+
+bool PeriodicTimer::waitForNextDeadline()
+{
+	const int64_t deadline_ns = toNanoseconds(cycleStart_) + period_ns_;
+	const int64_t lateness_ns = now_ns() - deadline_ns;
+
+	bool isOnTime = true;
+	if (lateness_ns > 0) {
+		if (lateness_ns > maxLateness_ns_) {
+			maxLateness_ns_ = lateness_ns;
+		}
+		nMissedDeadlines_++;
+		isOnTime = false;
+	} else {
+		sleepUntilTime(deadline_ns);
+	}
+	cycleStart_ = toTimespec(deadline_ns);
+	return isOnTime;
+}
+
+void PeriodicTimer::sleepUntil(unsigned int offset_us)
+{
+	sleepUntilTime(toNanoseconds(cycleStart_) + (int64_t)offset_us*1000);
+}
+
+int64_t PeriodicTimer::getElapsedTime_us() const
+{
+	return (now_ns() - toNanoseconds(cycleStart_))/1000;
+}
+
+const struct timespec& PeriodicTimer::getCycleStartTime() const
+{
+	return cycleStart_;
+}
+
+unsigned int PeriodicTimer::getPeriod_us() const
+{
+	return (unsigned int)(period_ns_/1000);
+}
+
+unsigned int PeriodicTimer::getNumberOfMissedDeadlines() const
+{
+	return nMissedDeadlines_;
+}
+
+int64_t PeriodicTimer::getMaxLateness_us() const
+{
+	return maxLateness_ns_/1000;
+}
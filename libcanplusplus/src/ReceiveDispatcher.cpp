@@ -0,0 +1,173 @@
+/*!
+ * @file 	ReceiveDispatcher.cpp
+ * @brief	Handlers that are invoked when a frame is received
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include "libcanplusplus/ReceiveDispatcher.hpp"
+#include "libcanplusplus/CANOpenMsg.hpp"
+#include "libcanplusplus/Logger.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace {
+
+int64_t getTime_ns()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+ReceiveDispatcher::ReceiveDispatcher()
+:nHandlers_(0),
+ dispatchEpoch_(0),
+ budget_ns_(0),
+ nDispatches_(0),
+ nOverruns_(0),
+ maxDuration_ns_(0)
+{
+	for (int i=0; i<nCOBIds; i++) {
+		entries_[i].store(-1, std::memory_order_relaxed);
+	}
+	for (int i=0; i<maxHandlers; i++) {
+		handlers_[i].COBId = -1;
+		handlers_[i].pdo = NULL;
+		handlers_[i].handler.store(NULL, std::memory_order_relaxed);
+		handlers_[i].userData = NULL;
+	}
+}
+
+ReceiveDispatcher::~ReceiveDispatcher()
+{
+
+}
+
+bool ReceiveDispatcher::addHandler(CANOpenMsg* pdo, Handler handler, void* userData)
+{
+	const int COBId = pdo->getCOBId();
+	if (COBId < 0 || COBId >= nCOBIds || handler == NULL) {
+		Logger::log(LogLevels::error, "ReceiveDispatcher: Could not add a handler for COB-ID 0x%X!", COBId);
+		return false;
+	}
+	int iEntry = entries_[COBId].load(std::memory_order_relaxed);
+	if (iEntry >= 0 && handlers_[iEntry].handler.load(std::memory_order_relaxed) != NULL) {
+		Logger::log(LogLevels::warn, "ReceiveDispatcher: COB-ID 0x%03X already has a handler!", COBId);
+		return false;
+	}
+	if (iEntry < 0) {
+		if (nHandlers_ >= maxHandlers) {
+			Logger::log(LogLevels::error, "ReceiveDispatcher: Could not add a handler for COB-ID 0x%03X, all %d handlers are used!",
+					COBId, maxHandlers);
+			return false;
+		}
+		iEntry = nHandlers_++;
+	}
+	Entry& entry = handlers_[iEntry];
+	entry.COBId = COBId;
+	entry.pdo = pdo;
+	entry.userData = userData;
+	entry.handler.store(handler, std::memory_order_release);
+	entries_[COBId].store(iEntry, std::memory_order_release);
+	return true;
+}
+
+void ReceiveDispatcher::removeHandler(int COBId)
+{
+	if (COBId < 0 || COBId >= nCOBIds) {
+		return;
+	}
+	const int iEntry = entries_[COBId].load(std::memory_order_acquire);
+	if (iEntry < 0) {
+		return;
+	}
+	/* sequentially consistent with dispatch(): either it sees no handler or the epoch is odd here */
+	handlers_[iEntry].handler.store(NULL);
+
+	/* wait for the dispatch that may still use the PDO and the user data of the entry */
+	const unsigned int epoch = dispatchEpoch_.load();
+	if (epoch % 2 != 0) {
+		while (dispatchEpoch_.load() == epoch) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool ReceiveDispatcher::hasHandler(int COBId) const
+{
+	if (COBId < 0 || COBId >= nCOBIds) {
+		return false;
+	}
+	const int iEntry = entries_[COBId].load(std::memory_order_acquire);
+	return iEntry >= 0 && handlers_[iEntry].handler.load(std::memory_order_acquire) != NULL;
+}
+
+bool ReceiveDispatcher::dispatch(const CANMsg& frame)
+{
+	if (frame.COBId < 0 || frame.COBId >= nCOBIds || !frame.flag) {
+		return false;
+	}
+	const int iEntry = entries_[frame.COBId].load(std::memory_order_acquire);
+	if (iEntry < 0) {
+		return false;
+	}
+	Entry& entry = handlers_[iEntry];
+
+	/* the entry is in use until the epoch is incremented again, see removeHandler() */
+	dispatchEpoch_.fetch_add(1);
+	Handler handler = entry.handler.load();
+	if (handler == NULL) {
+		dispatchEpoch_.fetch_add(1, std::memory_order_release);
+		return false;
+	}
+
+	const int64_t start_ns = getTime_ns();
+	entry.pdo->setCANMsg(&frame, start_ns/1000);
+	handler(entry.pdo, entry.userData);
+	const int64_t duration_ns = getTime_ns() - start_ns;
+	dispatchEpoch_.fetch_add(1, std::memory_order_release);
+
+	nDispatches_.fetch_add(1, std::memory_order_relaxed);
+	const int64_t budget_ns = budget_ns_.load(std::memory_order_relaxed);
+	if (budget_ns > 0 && duration_ns > budget_ns) {
+		nOverruns_.fetch_add(1, std::memory_order_relaxed);
+	}
+	if (duration_ns > maxDuration_ns_.load(std::memory_order_relaxed)) {
+		/* only the receive thread writes the maximum */
+		maxDuration_ns_.store(duration_ns, std::memory_order_relaxed);
+	}
+	return true;
+}
+
+void ReceiveDispatcher::setBudget(int64_t budget_ns)
+{
+	budget_ns_.store(budget_ns, std::memory_order_relaxed);
+}
+
+unsigned int ReceiveDispatcher::getNumberOfDispatches() const
+{
+	return nDispatches_.load(std::memory_order_relaxed);
+}
+
+unsigned int ReceiveDispatcher::getNumberOfOverruns() const
+{
+	return nOverruns_.load(std::memory_order_relaxed);
+}
+
+int64_t ReceiveDispatcher::getMaxDuration_ns() const
+{
+	return maxDuration_ns_.load(std::memory_order_relaxed);
+}
+
+void ReceiveDispatcher::addCOBIds(AcceptanceFilter* filter) const
+{
+	for (int i=0; i<nHandlers_; i++) {
+		if (handlers_[i].handler.load(std::memory_order_acquire) != NULL) {
+			filter->addCOBId(handlers_[i].COBId);
+		}
+	}
+}
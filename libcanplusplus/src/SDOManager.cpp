@@ -11,14 +11,20 @@
 
 #include "libcanplusplus/SDOManager.hpp"
 
-#include <stdexcept>
-#include <boost/lexical_cast.hpp>
-#include <iostream>
-#include <stdio.h>
+#include "libcanplusplus/Logger.hpp"
+#include "libcanplusplus/Metrics.hpp"
+#include "libcanplusplus/Trace.hpp"
 
-SDOManager::SDOManager(int iBus):iBus_(iBus)
+SDOManager::SDOManager(int iBus)
+:iBus_(iBus),
+ receiveSlots_(NULL),
+ sendSlots_(NULL)
 {
 	emptySDO_ = new SDOMsg(-1, -1, 0);
+	for (int i=0; i<maxNodes; i++) {
+		nTimeouts_[i] = 0;
+		nAborts_[i] = 0;
+	}
 }
 
 SDOManager::~SDOManager()
@@ -27,16 +33,29 @@ SDOManager::~SDOManager()
 	sdos_.clear();
 }
 
+void SDOManager::reserve(unsigned int nSDOs)
+{
+	/* the released list nodes stay in the pool */
+	SDOList sdos;
+	for (unsigned int i=0; i<nSDOs; i++) {
+		sdos.push_back(SDOMsgPtr());
+	}
+}
+
 void SDOManager::addSDO(SDOMsg* sdo)
 {
+	assignSlots(sdo);
 	sdo->setIsQueuing(true);
 	sdos_.push_back(SDOMsgPtr(sdo));
+	Metrics::increment(Metrics::getNode(iBus_, sdo->getNodeId()).sdoRequests);
 }
 
 void SDOManager::addSDO(SDOMsgPtr sdo)
 {
+	assignSlots(sdo.get());
 	sdo->setIsQueuing(true);
 	sdos_.push_back(sdo);
+	Metrics::increment(Metrics::getNode(iBus_, sdo->getNodeId()).sdoRequests);
 }
 
 int SDOManager::getSize()
@@ -46,41 +65,24 @@ int SDOManager::getSize()
 
 SDOMsg* SDOManager::getSDO(unsigned int index)
 {
-	std::list<SDOMsgPtr>::iterator iterSDOList;
-	unsigned int counter = 0;
-	try {
-		if (index >= sdos_.size()) {
-			std::string error = "SDOManager: Could not get SDO with index "
-								+ boost::lexical_cast<std::string>(index) + "!";
-			throw std::out_of_range(error);
-		}
-
-		for (iterSDOList = sdos_.begin(); iterSDOList != sdos_.end(); iterSDOList++) {
-		  if (counter == index) {
-			  return iterSDOList->get();
-		  }
-		  counter++;
-		}
-
-	} catch (std::exception& e) {
-		std::cout << e.what() << std::endl;
+	if (index >= sdos_.size()) {
+		Logger::log(LogLevels::error, "SDOManager: Could not get SDO with index %u!", index);
+		return NULL;
+	}
+	SDOList::iterator iterSDOList = sdos_.begin();
+	for (unsigned int counter=0; counter<index; counter++) {
+		iterSDOList++;
 	}
-	return NULL;
+	return iterSDOList->get();
 }
 
 SDOMsg* SDOManager::getFirstSDO()
 {
-	try {
-		if (getSize() == 0) {
-			std::string error = "SDOManager: Could not get first SDO!";
-			throw std::out_of_range(error);
-		}
-		return sdos_.front().get();
-
-	} catch (std::exception& e) {
-		std::cout << e.what() << std::endl;
+	if (getSize() == 0) {
+		Logger::log(LogLevels::error, "SDOManager: Could not get first SDO!");
+		return NULL;
 	}
-	return NULL;
+	return sdos_.front().get();
 }
 
 SDOMsg* SDOManager::getSendSDO()
@@ -91,6 +93,7 @@ SDOMsg* SDOManager::getSendSDO()
 	SDOMsg* firstSDO = getFirstSDO();
 	if (firstSDO->getIsSent() && firstSDO->getIsReceived()) {
 		/* the first SDO message was setn and received */
+		countAbort(firstSDO);
 		sdos_.pop_front();
 	}
 	if (getSize() == 0) {
@@ -107,15 +110,7 @@ SDOMsg* SDOManager::getReceiveSDO()
 		return emptySDO_;
 	}
 	if (getFirstSDO()->hasTimeOut()) {
-		printf("\e[0;31m\n* * * * * * * * * * * * *\n");
-		printf("* SDO problem: no answer received!\n");
-		printf("* Bus: %d; COB_ID: %X; index: %02X%02X; subindex: %X\n",
-				iBus_,
-				getFirstSDO()->getOutputMsg()->getCOBId(),
-				getFirstSDO()->getOutputMsg()->getValue()[2],
-				getFirstSDO()->getOutputMsg()->getValue()[1],
-				getFirstSDO()->getOutputMsg()->getValue()[3]);
-		printf("* * * * * * * * * * * * *\n\e[0m");
+		reportTimeout(getFirstSDO());
 		sdos_.pop_front();
 	}
 	if (getSize() == 0) {
@@ -127,3 +122,176 @@ SDOMsg* SDOManager::getReceiveSDO()
 bool SDOManager::isEmpty() {
     return getSendSDO() == emptySDO_;
 }
+
+int SDOManager::getSendSDOs(SDOMsg** sdos, int maxSDOs)
+{
+	/* remove the SDOs that were sent and received */
+	SDOList::iterator iterSDOList = sdos_.begin();
+	while (iterSDOList != sdos_.end()) {
+		if ((*iterSDOList)->getIsSent() && (*iterSDOList)->getIsReceived()) {
+			countAbort(iterSDOList->get());
+			iterSDOList = sdos_.erase(iterSDOList);
+		} else {
+			iterSDOList++;
+		}
+	}
+	return getFirstSDOs(sdos, maxSDOs);
+}
+
+int SDOManager::getReceiveSDOs(SDOMsg** sdos, int maxSDOs)
+{
+	/* remove the SDOs that have a timeout */
+	SDOList::iterator iterSDOList = sdos_.begin();
+	while (iterSDOList != sdos_.end()) {
+		if ((*iterSDOList)->hasTimeOut()) {
+			reportTimeout(iterSDOList->get());
+			iterSDOList = sdos_.erase(iterSDOList);
+		} else {
+			iterSDOList++;
+		}
+	}
+
+	/* only the SDOs that were sent wait for a response */
+	int nSDOs = getFirstSDOs(sdos, maxSDOs);
+	int nSent = 0;
+	for (int i=0; i<nSDOs; i++) {
+		if (sdos[i]->getIsSent()) {
+			sdos[nSent++] = sdos[i];
+		}
+	}
+	return nSent;
+}
+
+int SDOManager::getFirstSDOs(SDOMsg** sdos, int maxSDOs)
+{
+	bool isNodeBusy[maxNodes] = {false};
+	int nSDOs = 0;
+
+	SDOList::iterator iterSDOList;
+	for (iterSDOList = sdos_.begin(); iterSDOList != sdos_.end() && nSDOs < maxSDOs; iterSDOList++) {
+		SDOMsg* sdo = iterSDOList->get();
+		const int nodeId = sdo->getNodeId();
+
+		if (nodeId <= 0 || nodeId >= maxNodes) {
+			/* a broadcast waits for all previous SDOs and blocks all following SDOs */
+			if (iterSDOList == sdos_.begin()) {
+				sdos[nSDOs++] = sdo;
+			}
+			break;
+		}
+		if (isNodeBusy[nodeId]) {
+			continue;
+		}
+		isNodeBusy[nodeId] = true;
+
+		/* nodes that share the shared memory index are processed one after the other */
+		bool isSMIdBusy = false;
+		for (int i=0; i<nSDOs; i++) {
+			if (sdos[i]->getOutputMsg()->getSMId() == sdo->getOutputMsg()->getSMId()
+					|| sdos[i]->getInputMsg()->getSMId() == sdo->getInputMsg()->getSMId()) {
+				isSMIdBusy = true;
+				break;
+			}
+		}
+		if (!isSMIdBusy) {
+			sdos[nSDOs++] = sdo;
+		}
+	}
+	return nSDOs;
+}
+
+int SDOManager::getNumberOfSDOs(int nodeId)
+{
+	int nSDOs = 0;
+	SDOList::iterator iterSDOList;
+	for (iterSDOList = sdos_.begin(); iterSDOList != sdos_.end(); iterSDOList++) {
+		if ((*iterSDOList)->getNodeId() == nodeId
+				&& !((*iterSDOList)->getIsSent() && (*iterSDOList)->getIsReceived())) {
+			nSDOs++;
+		}
+	}
+	return nSDOs;
+}
+
+unsigned int SDOManager::getNumberOfTimeouts(int nodeId)
+{
+	if (nodeId < 0 || nodeId >= maxNodes) {
+		return 0;
+	}
+	return nTimeouts_[nodeId];
+}
+
+unsigned int SDOManager::getNumberOfAborts(int nodeId)
+{
+	if (nodeId < 0 || nodeId >= maxNodes) {
+		return 0;
+	}
+	return nAborts_[nodeId];
+}
+
+void SDOManager::receiveResponse(SDOMsg* sdo, const CANMsg* msg)
+{
+	const bool wasReceived = sdo->getIsReceived();
+	sdo->receiveMsg(msg);
+
+	/* counted when the response arrives, the SDO is only removed in the next emit */
+	const int nodeId = sdo->getNodeId();
+	if (!wasReceived && sdo->getIsReceived() && sdo->isAborted()
+			&& nodeId >= 0 && nodeId < maxNodes) {
+		nAborts_[nodeId]++;
+	}
+}
+
+void SDOManager::reportTimeout(SDOMsg* sdo)
+{
+	Logger::log(LogLevels::error, "SDO problem: no answer received! Bus: %d; COB_ID: %X; index: %02X%02X; subindex: %X",
+			iBus_,
+			sdo->getOutputMsg()->getCOBId(),
+			sdo->getOutputMsg()->getValue()[2],
+			sdo->getOutputMsg()->getValue()[1],
+			sdo->getOutputMsg()->getValue()[3]);
+
+	const int nodeId = sdo->getNodeId();
+	LIBCANPLUSPLUS_TRACE3(sdo_timeout, iBus_, nodeId, sdo->getOutputMsg()->getCOBId());
+	if (nodeId >= 0 && nodeId < maxNodes) {
+		nTimeouts_[nodeId]++;
+	}
+	Metrics::increment(Metrics::getNode(iBus_, nodeId).sdoTimeouts);
+}
+
+void SDOManager::countAbort(SDOMsg* sdo)
+{
+	if (sdo->isAborted()) {
+		LIBCANPLUSPLUS_TRACE3(sdo_abort, iBus_, sdo->getNodeId(), sdo->getAbortCode());
+		Metrics::countSDOAbort(iBus_, sdo->getNodeId(), sdo->getAbortCode());
+	}
+}
+
+void SDOManager::setSlotMaps(SlotMap* receiveSlots, SlotMap* sendSlots)
+{
+	receiveSlots_ = receiveSlots;
+	sendSlots_ = sendSlots;
+}
+
+void SDOManager::assignSlots(SDOMsg* sdo)
+{
+	/* the slots are those of the SDO COB-IDs of the node, the NMT commands have the COB-ID 0 */
+	CANOpenMsg* inputMsg = sdo->getInputMsg();
+	if (receiveSlots_ != NULL) {
+		const int COBId = canopen::TxSDOId + sdo->getNodeId();
+		if (inputMsg->getSMId() == SlotMap::autoSlot) {
+			inputMsg->setSMId(receiveSlots_->allocate(COBId));
+		} else {
+			receiveSlots_->assign(COBId, inputMsg->getSMId());
+		}
+	}
+	CANOpenMsg* outputMsg = sdo->getOutputMsg();
+	if (sendSlots_ != NULL) {
+		const int COBId = canopen::RxSDOId + sdo->getNodeId();
+		if (outputMsg->getSMId() == SlotMap::autoSlot) {
+			outputMsg->setSMId(sendSlots_->allocate(COBId));
+		} else {
+			sendSlots_->assign(COBId, outputMsg->getSMId());
+		}
+	}
+}
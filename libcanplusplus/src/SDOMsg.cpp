@@ -8,6 +8,7 @@
  *
  */
 #include "libcanplusplus/SDOMsg.hpp"
+#include "libcanplusplus/Trace.hpp"
 #include <stdio.h>
 
 SDOMsg::SDOMsg(int inSDOSMID, int outSDOSMID, int nodeId, int index, int subIndex)
@@ -19,7 +20,8 @@ SDOMsg::SDOMsg(int inSDOSMID, int outSDOSMID, int nodeId, int index, int subInde
  isSent_(false),
  isReceived_(false),
  isWaiting_(false),
- isQueuing_(false)
+ isQueuing_(false),
+ refCount_(0)
 {
 	inputMsg_ = new CANOpenMsg(0x580 + nodeId_, inSDOSMID);
 	outputMsg_ = new CANOpenMsg(0x600 + nodeId_, outSDOSMID);
@@ -33,6 +35,28 @@ SDOMsg::~SDOMsg()
 
 }
 
+void* SDOMsg::operator new(size_t size)
+{
+	return MemoryPool::allocateBlock(getPool(), size);
+}
+
+void SDOMsg::operator delete(void* p)
+{
+	MemoryPool::deallocateBlock(p);
+}
+
+void SDOMsg::reservePool(unsigned int nSDOs)
+{
+	getPool().reserve(nSDOs);
+}
+
+MemoryPool& SDOMsg::getPool()
+{
+	/* derived SDOs with a few more members fit into a block */
+	static MemoryPool* pool = new MemoryPool(sizeof(SDOMsg) + 64);
+	return *pool;
+}
+
 CANOpenMsg* SDOMsg::getOutputMsg()
 {
 	return outputMsg_;
@@ -91,19 +115,26 @@ void SDOMsg::sendMsg(CANMsg *canDataDes)
 		outputMsg_->setFlag(0);
 	}
 	outputMsg_->getCANMsg(canDataDes);
+	if (!isSent_) {
+		/* only the request, the later calls do not flag the frame */
+		LIBCANPLUSPLUS_TRACE3(sdo_send, canDataDes->COBId,
+				canDataDes->value[1] | (canDataDes->value[2] << 8), canDataDes->value[3]);
+	}
 	isSent_ = true;
 	isQueuing_ = false;
 	isWaiting_ = true;
 }
-void SDOMsg::receiveMsg(CANMsg *canDataMeas)
+void SDOMsg::receiveMsg(const CANMsg *canDataMeas)
 {
 
 	if (canDataMeas->flag) {
+		LIBCANPLUSPLUS_TRACE3(sdo_complete, canDataMeas->COBId,
+				canDataMeas->value[1] | (canDataMeas->value[2] << 8), canDataMeas->value[3]);
 		isReceived_ = true;
 		isWaiting_ = false;
 		inputMsg_->setCANMsg(canDataMeas);
 		processReceivedMsg();
-	} else {
+	} else if (isSent_) {
 		timeout_++;
 	}
 
@@ -0,0 +1,150 @@
+/*!
+ * @file 	SlotMap.cpp
+ * @brief	Slots of the frames of a bus
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include "libcanplusplus/SlotMap.hpp"
+#include "libcanplusplus/Logger.hpp"
+
+SlotMap::SlotMap()
+{
+	for (int i=0; i<maxSlots; i++) {
+		sequences_[i].store(0, std::memory_order_relaxed);
+	}
+	clear();
+}
+
+SlotMap::~SlotMap()
+{
+
+}
+
+int SlotMap::allocate(int COBId)
+{
+	if (COBId < 0 || COBId >= nCOBIds) {
+		Logger::log(LogLevels::error, "SlotMap: Could not allocate a slot for COB-ID 0x%X!", COBId);
+		return -1;
+	}
+	const int slot = slots_[COBId].load(std::memory_order_relaxed);
+	if (slot >= 0) {
+		return slot;
+	}
+
+	const int size = size_.load(std::memory_order_relaxed);
+	if (size >= maxSlots) {
+		Logger::log(LogLevels::error, "SlotMap: Could not allocate a slot for COB-ID 0x%03X, all %d slots are used!",
+				COBId, maxSlots);
+		return -1;
+	}
+	slots_[COBId].store(size, std::memory_order_release);
+	size_.store(size + 1, std::memory_order_release);
+	return size;
+}
+
+bool SlotMap::assign(int COBId, int slot)
+{
+	if (COBId < 0 || COBId >= nCOBIds || slot < 0 || slot >= maxSlots) {
+		Logger::log(LogLevels::error, "SlotMap: Could not assign slot %d to COB-ID 0x%X!", slot, COBId);
+		return false;
+	}
+	const int previousSlot = slots_[COBId].load(std::memory_order_relaxed);
+	if (previousSlot >= 0 && previousSlot != slot) {
+		Logger::log(LogLevels::warn, "SlotMap: COB-ID 0x%03X is in slot %d and in slot %d, slot %d is kept!",
+				COBId, previousSlot, slot, previousSlot);
+		return false;
+	}
+	slots_[COBId].store(slot, std::memory_order_release);
+	if (slot >= size_.load(std::memory_order_relaxed)) {
+		size_.store(slot + 1, std::memory_order_release);
+	}
+	return true;
+}
+
+int SlotMap::getSlot(int COBId) const
+{
+	if (COBId < 0 || COBId >= nCOBIds) {
+		return -1;
+	}
+	return slots_[COBId].load(std::memory_order_acquire);
+}
+
+int SlotMap::getSize() const
+{
+	return size_.load(std::memory_order_acquire);
+}
+
+void SlotMap::clear()
+{
+	for (int i=0; i<nCOBIds; i++) {
+		slots_[i].store(-1, std::memory_order_relaxed);
+	}
+	size_.store(0, std::memory_order_relaxed);
+	clearDirty();
+}
+
+void SlotMap::setDirty(int slot)
+{
+	if (slot >= 0 && slot < maxSlots) {
+		dirty_[slot/bitsPerWord].fetch_or((uint64_t)1 << (slot%bitsPerWord), std::memory_order_release);
+	}
+}
+
+bool SlotMap::isDirty(int slot) const
+{
+	if (slot < 0 || slot >= maxSlots) {
+		return false;
+	}
+	return (dirty_[slot/bitsPerWord].load(std::memory_order_acquire) >> (slot%bitsPerWord)) & 1;
+}
+
+int SlotMap::getNextDirtySlot(int slot) const
+{
+	if (slot < 0) {
+		slot = 0;
+	}
+	const int size = getSize();
+	for (int iWord=slot/bitsPerWord; iWord*bitsPerWord<size; iWord++) {
+		uint64_t word = dirty_[iWord].load(std::memory_order_acquire);
+		if (iWord == slot/bitsPerWord) {
+			/* the slots before the first one are ignored */
+			word &= ~(uint64_t)0 << (slot%bitsPerWord);
+		}
+		if (word != 0) {
+			return iWord*bitsPerWord + __builtin_ctzll(word);
+		}
+	}
+	return -1;
+}
+
+int SlotMap::getNumberOfDirtySlots() const
+{
+	int n = 0;
+	for (int iWord=0; iWord<maxSlots/bitsPerWord; iWord++) {
+		n += __builtin_popcountll(dirty_[iWord].load(std::memory_order_relaxed));
+	}
+	return n;
+}
+
+void SlotMap::clearDirty()
+{
+	for (int iWord=0; iWord<maxSlots/bitsPerWord; iWord++) {
+		dirty_[iWord].store(0, std::memory_order_relaxed);
+	}
+}
+
+unsigned int SlotMap::nextSequence(int slot)
+{
+	if (slot < 0 || slot >= maxSlots) {
+		return 0;
+	}
+	unsigned int sequence = sequences_[slot].fetch_add(1, std::memory_order_relaxed) + 1;
+	if (sequence == 0) {
+		/* 0 marks frames without a number, it is skipped at the wrap-around */
+		sequence = sequences_[slot].fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+	return sequence;
+}
@@ -0,0 +1,263 @@
+/*!
+ * @file 	SocketCANChannel.cpp
+ * @brief	CAN channel based on Linux SocketCAN with CAN FD support
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <vector>
+
+#include "libcanplusplus/SocketCANChannel.hpp"
+#include "libcanplusplus/Logger.hpp"
+#include "libcanplusplus/Metrics.hpp"
+#include "libcanplusplus/Trace.hpp"
+
+SocketCANChannel::SocketCANChannel()
+:socket_(-1),
+ isFD_(false),
+ iBus_(-1)
+{
+
+}
+
+SocketCANChannel::~SocketCANChannel()
+{
+	close();
+}
+
+bool SocketCANChannel::open(const char* interfaceName, bool enableFD)
+{
+	close();
+
+	socket_ = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+	if (socket_ < 0) {
+		Logger::log(LogLevels::error, "SocketCANChannel: Could not open socket: %s", strerror(errno));
+		return false;
+	}
+
+	struct ifreq ifr;
+	memset(&ifr, 0, sizeof(ifr));
+	strncpy(ifr.ifr_name, interfaceName, IFNAMSIZ - 1);
+	if (ioctl(socket_, SIOCGIFINDEX, &ifr) < 0) {
+		Logger::log(LogLevels::error, "SocketCANChannel: Unknown interface %s: %s", interfaceName, strerror(errno));
+		close();
+		return false;
+	}
+
+	if (enableFD) {
+		int enable = 1;
+		if (setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) < 0) {
+			Logger::log(LogLevels::error, "SocketCANChannel: Interface %s does not support CAN FD: %s", interfaceName, strerror(errno));
+			close();
+			return false;
+		}
+	}
+	isFD_ = enableFD;
+
+	if (fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL) | O_NONBLOCK) < 0) {
+		Logger::log(LogLevels::error, "SocketCANChannel: Could not set socket non-blocking: %s", strerror(errno));
+		close();
+		return false;
+	}
+
+	struct sockaddr_can addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.can_family = AF_CAN;
+	addr.can_ifindex = ifr.ifr_ifindex;
+	if (bind(socket_, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+		Logger::log(LogLevels::error, "SocketCANChannel: Could not bind to %s: %s", interfaceName, strerror(errno));
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool SocketCANChannel::setAcceptanceFilter(const AcceptanceFilter& filter)
+{
+	if (socket_ < 0) {
+		return false;
+	}
+
+	std::vector<struct can_filter> filters(filter.getNumberOfFilters());
+	for (unsigned int i=0; i<filters.size(); i++) {
+		filters[i].can_id = filter.getFilter(i).id;
+		filters[i].can_mask = filter.getFilter(i).mask | CAN_EFF_FLAG;
+	}
+	if (setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_FILTER, filters.empty() ? NULL : &filters[0],
+					filters.size()*sizeof(struct can_filter)) < 0) {
+		Logger::log(LogLevels::error, "SocketCANChannel: Could not set the acceptance filter: %s", strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+void SocketCANChannel::close()
+{
+	if (socket_ >= 0) {
+		::close(socket_);
+		socket_ = -1;
+	}
+	isFD_ = false;
+}
+
+bool SocketCANChannel::isOpen() const
+{
+	return socket_ >= 0;
+}
+
+bool SocketCANChannel::isFD() const
+{
+	return isFD_;
+}
+
+int SocketCANChannel::getFileDescriptor() const
+{
+	return socket_;
+}
+
+int SocketCANChannel::send(const CANMsg& msg)
+{
+	const int result = sendFrame(msg);
+	BusMetrics& metrics = Metrics::getBus(iBus_);
+	if (result > 0) {
+		LIBCANPLUSPLUS_TRACE3(frame_tx, iBus_, msg.COBId, msg.length);
+		Metrics::increment(metrics.framesSent);
+	} else if (result == 0) {
+		Metrics::increment(metrics.txBufferFull);
+	} else {
+		Metrics::increment(metrics.busErrors);
+	}
+	return result;
+}
+
+int SocketCANChannel::receive(CANMsg* msg)
+{
+	const int result = receiveFrame(msg);
+	if (result > 0) {
+		LIBCANPLUSPLUS_TRACE3(frame_rx, iBus_, msg->COBId, msg->length);
+		Metrics::increment(Metrics::getBus(iBus_).framesReceived);
+	} else if (result < 0) {
+		Metrics::increment(Metrics::getBus(iBus_).busErrors);
+	}
+	return result;
+}
+
+int SocketCANChannel::receive(CANMsg* msg, int64_t timeout_us)
+{
+	const int result = receive(msg);
+	if (result != 0 || timeout_us <= 0) {
+		return result;
+	}
+
+	struct pollfd fd;
+	fd.fd = socket_;
+	fd.events = POLLIN;
+	fd.revents = 0;
+	struct timespec timeout;
+	timeout.tv_sec = timeout_us/1000000;
+	timeout.tv_nsec = (timeout_us%1000000)*1000;
+	const int nReady = ppoll(&fd, 1, &timeout, NULL);
+	if (nReady < 0) {
+		return (errno == EINTR) ? 0 : -1;
+	}
+	if (nReady == 0) {
+		return 0;
+	}
+	return receive(msg);
+}
+
+void SocketCANChannel::setBusIndex(int iBus)
+{
+	iBus_ = iBus;
+}
+
+int SocketCANChannel::sendFrame(const CANMsg& msg)
+{
+	if (socket_ < 0) {
+		return -1;
+	}
+
+	canid_t id = msg.COBId & CAN_EFF_MASK;
+	if (id > CAN_SFF_MASK) {
+		id |= CAN_EFF_FLAG;
+	}
+
+	ssize_t nBytes;
+	if (msg.fdf) {
+		if (!isFD_) {
+			return -1;
+		}
+		struct canfd_frame frame;
+		memset(&frame, 0, sizeof(frame));
+		frame.can_id = id;
+		frame.len = CANMsg::getPaddedLength(msg.length);
+		frame.flags = msg.brs ? CANFD_BRS : 0;
+		memcpy(frame.data, msg.value, msg.length);
+		nBytes = write(socket_, &frame, CANFD_MTU);
+		if (nBytes == CANFD_MTU) {
+			return 1;
+		}
+	} else {
+		if (msg.length > CANMsg::maxClassicLength) {
+			return -1;
+		}
+		struct can_frame frame;
+		memset(&frame, 0, sizeof(frame));
+		frame.can_id = id | (msg.rtr ? CAN_RTR_FLAG : 0);
+		frame.can_dlc = msg.length;
+		memcpy(frame.data, msg.value, msg.length);
+		nBytes = write(socket_, &frame, CAN_MTU);
+		if (nBytes == CAN_MTU) {
+			return 1;
+		}
+	}
+
+	if (nBytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)) {
+		/* the transmit queue of the interface is full */
+		return 0;
+	}
+	return -1;
+}
+
+int SocketCANChannel::receiveFrame(CANMsg* msg)
+{
+	if (socket_ < 0) {
+		return -1;
+	}
+
+	/* a canfd_frame can hold both frame types */
+	struct canfd_frame frame;
+	const ssize_t nBytes = read(socket_, &frame, sizeof(frame));
+	if (nBytes < 0) {
+		if (errno == EAGAIN || errno == EWOULDBLOCK) {
+			return 0;
+		}
+		return -1;
+	}
+	if (nBytes != CAN_MTU && nBytes != CANFD_MTU) {
+		return -1;
+	}
+
+	const bool isFDFrame = (nBytes == CANFD_MTU);
+	msg->flag = 1;
+	msg->COBId = (frame.can_id & CAN_EFF_FLAG) ? (frame.can_id & CAN_EFF_MASK) : (frame.can_id & CAN_SFF_MASK);
+	msg->rtr = (!isFDFrame && (frame.can_id & CAN_RTR_FLAG)) ? 1 : 0;
+	msg->fdf = isFDFrame ? 1 : 0;
+	msg->brs = (isFDFrame && (frame.flags & CANFD_BRS)) ? 1 : 0;
+	msg->length = frame.len > CANMsg::maxLength ? CANMsg::maxLength : frame.len;
+	memcpy(msg->value, frame.data, msg->length);
+	return 1;
+}
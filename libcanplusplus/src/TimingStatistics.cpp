@@ -0,0 +1,124 @@
+/*!
+ * @file 	TimingStatistics.cpp
+ * @brief	Minimum, mean, maximum and percentiles of durations
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include "libcanplusplus/TimingStatistics.hpp"
+
+TimingStatistics::TimingStatistics()
+{
+	reset();
+}
+
+TimingStatistics::~TimingStatistics()
+{
+
+}
+
+void TimingStatistics::add(int64_t duration_ns)
+{
+	if (duration_ns < 0) {
+		duration_ns = 0;
+	}
+	buckets_[getBucket(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+	const uint64_t count = count_.load(std::memory_order_relaxed);
+	if (count == 0 || duration_ns < min_ns_.load(std::memory_order_relaxed)) {
+		min_ns_.store(duration_ns, std::memory_order_relaxed);
+	}
+	if (duration_ns > max_ns_.load(std::memory_order_relaxed)) {
+		max_ns_.store(duration_ns, std::memory_order_relaxed);
+	}
+	sum_ns_.fetch_add(duration_ns, std::memory_order_relaxed);
+	count_.store(count + 1, std::memory_order_release);
+}
+
+void TimingStatistics::reset()
+{
+	for (int i=0; i<nBuckets; i++) {
+		buckets_[i].store(0, std::memory_order_relaxed);
+	}
+	sum_ns_.store(0, std::memory_order_relaxed);
+	min_ns_.store(0, std::memory_order_relaxed);
+	max_ns_.store(0, std::memory_order_relaxed);
+	count_.store(0, std::memory_order_release);
+}
+
+uint64_t TimingStatistics::getCount() const
+{
+	return count_.load(std::memory_order_acquire);
+}
+
+int64_t TimingStatistics::getMin_ns() const
+{
+	return min_ns_.load(std::memory_order_relaxed);
+}
+
+int64_t TimingStatistics::getMean_ns() const
+{
+	const uint64_t count = getCount();
+	if (count == 0) {
+		return 0;
+	}
+	return sum_ns_.load(std::memory_order_relaxed)/(int64_t)count;
+}
+
+int64_t TimingStatistics::getMax_ns() const
+{
+	return max_ns_.load(std::memory_order_relaxed);
+}
+
+int64_t TimingStatistics::getPercentile_ns(double percent) const
+{
+	uint64_t count = 0;
+	for (int i=0; i<nBuckets; i++) {
+		count += buckets_[i].load(std::memory_order_relaxed);
+	}
+	if (count == 0) {
+		return 0;
+	}
+
+	/* rank of the duration, 1 for the shortest one */
+	uint64_t rank = (uint64_t)(percent/100.0*count + 0.999999);
+	if (rank < 1) {
+		rank = 1;
+	} else if (rank > count) {
+		rank = count;
+	}
+	uint64_t nBelow = 0;
+	for (int i=0; i<nBuckets; i++) {
+		nBelow += buckets_[i].load(std::memory_order_relaxed);
+		if (nBelow >= rank) {
+			/* the bound of the bucket is not larger than the longest duration */
+			const int64_t bound_ns = getUpperBound(i);
+			const int64_t max_ns = getMax_ns();
+			return bound_ns < max_ns ? bound_ns : max_ns;
+		}
+	}
+	return getMax_ns();
+}
+
+int TimingStatistics::getBucket(int64_t duration_ns)
+{
+	if (duration_ns < nSubBuckets) {
+		return (int)duration_ns;
+	}
+	/* power of two and the next 3 bits below the leading one */
+	const int exponent = 63 - __builtin_clzll((uint64_t)duration_ns);
+	const int subBucket = (int)((duration_ns >> (exponent - 3)) & (nSubBuckets - 1));
+	const int bucket = (exponent - 2)*nSubBuckets + subBucket;
+	return bucket < nBuckets ? bucket : nBuckets - 1;
+}
+
+int64_t TimingStatistics::getUpperBound(int bucket)
+{
+	if (bucket < nSubBuckets) {
+		return bucket;
+	}
+	const int exponent = bucket/nSubBuckets + 2;
+	const int subBucket = bucket%nSubBuckets;
+	return ((int64_t)(nSubBuckets + subBucket + 1) << (exponent - 3)) - 1;
+}
@@ -0,0 +1,126 @@
+/*!
+ * @file 	TransmitQueue.cpp
+ * @brief	Queue of CAN messages ordered by the priority of their COB-ID
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include <stddef.h>
+#include "libcanplusplus/TransmitQueue.hpp"
+
+TransmitQueue::TransmitQueue()
+:size_(0),
+ sequence_(0),
+ hasLast_(false)
+{
+
+}
+
+TransmitQueue::~TransmitQueue()
+{
+
+}
+
+bool TransmitQueue::push(const CANMsg& msg)
+{
+	Entry entry;
+	entry.key = (static_cast<uint64_t>(msg.COBId & 0x1FFFFFFF) << 32) | sequence_;
+	entry.msg = msg;
+	if (!insert(entry)) {
+		return false;
+	}
+	sequence_++;
+	return true;
+}
+
+bool TransmitQueue::pop(CANMsg* msg)
+{
+	if (size_ == 0) {
+		return false;
+	}
+	last_ = entries_[0];
+	hasLast_ = true;
+	*msg = last_.msg;
+
+	/* sift down the last entry */
+	size_--;
+	const Entry entry = entries_[size_];
+	int i = 0;
+	while (true) {
+		int child = 2*i + 1;
+		if (child >= size_) {
+			break;
+		}
+		if (child + 1 < size_ && entries_[child + 1].key < entries_[child].key) {
+			child++;
+		}
+		if (entry.key <= entries_[child].key) {
+			break;
+		}
+		entries_[i] = entries_[child];
+		i = child;
+	}
+	entries_[i] = entry;
+
+	if (size_ == 0) {
+		/* the sequence numbers only order the queued messages */
+		sequence_ = 0;
+	}
+	return true;
+}
+
+bool TransmitQueue::requeue()
+{
+	if (!hasLast_ || !insert(last_)) {
+		return false;
+	}
+	hasLast_ = false;
+	return true;
+}
+
+const CANMsg* TransmitQueue::top() const
+{
+	if (size_ == 0) {
+		return NULL;
+	}
+	return &entries_[0].msg;
+}
+
+void TransmitQueue::clear()
+{
+	size_ = 0;
+	sequence_ = 0;
+	hasLast_ = false;
+}
+
+int TransmitQueue::size() const
+{
+	return size_;
+}
+
+bool TransmitQueue::isEmpty() const
+{
+	return size_ == 0;
+}
+
+bool TransmitQueue::insert(const Entry& entry)
+{
+	if (size_ >= capacity) {
+		return false;
+	}
+
+	/* sift up */
+	int i = size_++;
+	while (i > 0) {
+		const int parent = (i - 1)/2;
+		if (entries_[parent].key <= entry.key) {
+			break;
+		}
+		entries_[i] = entries_[parent];
+		i = parent;
+	}
+	entries_[i] = entry;
+	return true;
+}
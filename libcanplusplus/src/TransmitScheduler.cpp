@@ -0,0 +1,257 @@
+/*!
+ * @file 	TransmitScheduler.cpp
+ * @brief	Time-slotted transmission of the CAN messages of a bus within a cycle
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN, bus
+ *
+ */
+
+#include "libcanplusplus/TransmitScheduler.hpp"
+#include "libcanplusplus/Metrics.hpp"
+
+TransmitScheduler::TransmitScheduler()
+:cycleTime_us_(0),
+ bitrate_(1000000),
+ dataBitrate_(1000000),
+ txQueueDepth_(1),
+ frameSpacing_us_(0),
+ maxSDOFramesPerCycle_(0),
+ nSDOFrames_(0),
+ nHeldSDOFrames_(0),
+ iLastSlot_(-1),
+ busFreeTime_us_(0),
+ nDroppedFrames_(0),
+ nRequeuedFrames_(0),
+ iBus_(-1)
+{
+	for (int i=0; i<nSlots; i++) {
+		slots_[i].offset_us = 0;
+		order_[i] = i;
+	}
+}
+
+TransmitScheduler::~TransmitScheduler()
+{
+
+}
+
+void TransmitScheduler::setCycleTime(unsigned int cycleTime_us)
+{
+	cycleTime_us_ = cycleTime_us;
+}
+
+void TransmitScheduler::setBitrate(unsigned int bitrate)
+{
+	if (bitrate > 0) {
+		bitrate_ = bitrate;
+	}
+}
+
+void TransmitScheduler::setDataBitrate(unsigned int bitrate)
+{
+	if (bitrate > 0) {
+		dataBitrate_ = bitrate;
+	}
+}
+
+void TransmitScheduler::setTxQueueDepth(unsigned int depth)
+{
+	txQueueDepth_ = depth > 0 ? depth : 1;
+}
+
+void TransmitScheduler::setFrameSpacing(unsigned int spacing_us)
+{
+	frameSpacing_us_ = spacing_us;
+}
+
+void TransmitScheduler::setSlotOffset(Slots slot, unsigned int offset_us)
+{
+	slots_[static_cast<int>(slot)].offset_us = offset_us;
+
+	/* insertion sort, stable for equal offsets */
+	for (int i=0; i<nSlots; i++) {
+		order_[i] = i;
+	}
+	for (int i=1; i<nSlots; i++) {
+		const int iSlot = order_[i];
+		int j = i;
+		while (j > 0 && slots_[order_[j-1]].offset_us > slots_[iSlot].offset_us) {
+			order_[j] = order_[j-1];
+			j--;
+		}
+		order_[j] = iSlot;
+	}
+}
+
+void TransmitScheduler::setMaxSDOFramesPerCycle(unsigned int maxFrames)
+{
+	maxSDOFramesPerCycle_ = maxFrames;
+}
+
+TransmitScheduler::Slots TransmitScheduler::getSlot(int COBId)
+{
+	if (COBId == 0x80) {
+		return Slots::sync;
+	}
+	if (COBId == 0x00 || (COBId >= 0x600 && COBId < 0x680)) {
+		/* NMT commands are sent by the SDO manager */
+		return Slots::sdo;
+	}
+	return Slots::rxPDO;
+}
+
+unsigned int TransmitScheduler::getFrameTime(int length) const
+{
+	/* 47 bits of overhead (incl. interframe space) of a base frame,
+	 * at most one stuff bit per four bits of the stuffed region */
+	const unsigned int nBits = 47 + 8*length + (34 + 8*length - 1)/4;
+	return static_cast<unsigned int>((static_cast<uint64_t>(nBits)*1000000 + bitrate_ - 1)/bitrate_);
+}
+
+unsigned int TransmitScheduler::getFrameTime(const CANMsg& msg) const
+{
+	if (!msg.fdf) {
+		return getFrameTime(msg.length);
+	}
+
+	/* arbitration phase: SOF, identifier, RRS, IDE, FDF, res, BRS and
+	 * CRC delimiter, ACK, EOF, interframe space incl. stuff bits */
+	const uint64_t nArbitrationBits = 19 + 13;
+	/* data phase: ESI, DLC, data, stuff count, CRC and the fixed stuff bits */
+	const int length = CANMsg::getPaddedLength(msg.length);
+	const int nCRCBits = length > 16 ? 21 : 17;
+	const uint64_t nDataBits = 5 + 8*length + (5 + 8*length - 1)/4 + 4 + nCRCBits + (4 + nCRCBits)/4 + 1;
+	const uint64_t dataBitrate = msg.brs ? dataBitrate_ : bitrate_;
+
+	const uint64_t time_ns = (nArbitrationBits*1000000000)/bitrate_ + (nDataBits*1000000000)/dataBitrate;
+	return static_cast<unsigned int>((time_ns + 999)/1000);
+}
+
+void TransmitScheduler::beginCycle()
+{
+	for (int i=0; i<nSlots; i++) {
+		if (i == static_cast<int>(Slots::sdo)) {
+			/* SDOs are sent in one of the next cycles */
+			continue;
+		}
+		nDroppedFrames_ += slots_[i].frames.size();
+		Metrics::increment(Metrics::getBus(iBus_).framesDropped, slots_[i].frames.size());
+		slots_[i].frames.clear();
+	}
+	nSDOFrames_ = 0;
+	nHeldSDOFrames_.store(slots_[static_cast<int>(Slots::sdo)].frames.size(), std::memory_order_relaxed);
+	iLastSlot_ = -1;
+
+	/* frames of the last cycle may still occupy the controller */
+	busFreeTime_us_ -= cycleTime_us_;
+	if (busFreeTime_us_ < 0) {
+		busFreeTime_us_ = 0;
+	}
+}
+
+bool TransmitScheduler::addFrame(const CANMsg& msg)
+{
+	return addFrame(getSlot(msg.COBId), msg);
+}
+
+bool TransmitScheduler::addFrame(Slots slot, const CANMsg& msg)
+{
+	if (!slots_[static_cast<int>(slot)].frames.push(msg)) {
+		nDroppedFrames_++;
+		Metrics::increment(Metrics::getBus(iBus_).framesDropped);
+		return false;
+	}
+	return true;
+}
+
+bool TransmitScheduler::hasFrames() const
+{
+	return getActiveSlot() != -1;
+}
+
+bool TransmitScheduler::getFrame(unsigned int time_us, CANMsg* msg)
+{
+	const int iSlot = getActiveSlot();
+	if (iSlot == -1 || time_us < getNextReleaseTime()) {
+		return false;
+	}
+
+	slots_[iSlot].frames.pop(msg);
+	iLastSlot_ = iSlot;
+	if (iSlot == static_cast<int>(Slots::sdo)) {
+		nSDOFrames_++;
+	}
+
+	int64_t startTime_us = busFreeTime_us_ > static_cast<int64_t>(time_us) ? busFreeTime_us_ : static_cast<int64_t>(time_us);
+	busFreeTime_us_ = startTime_us + getFrameTime(*msg) + frameSpacing_us_;
+	return true;
+}
+
+bool TransmitScheduler::requeueFrame()
+{
+	if (iLastSlot_ == -1 || !slots_[iLastSlot_].frames.requeue()) {
+		return false;
+	}
+	if (iLastSlot_ == static_cast<int>(Slots::sdo)) {
+		nSDOFrames_--;
+	}
+	iLastSlot_ = -1;
+	nRequeuedFrames_++;
+
+	/* the transmit queue of the controller is full, wait for one frame */
+	busFreeTime_us_ += getFrameTime(8);
+	return true;
+}
+
+unsigned int TransmitScheduler::getNextReleaseTime() const
+{
+	const int iSlot = getActiveSlot();
+	if (iSlot == -1) {
+		return cycleTime_us_;
+	}
+
+	/* the controller can buffer txQueueDepth_ frames */
+	const int64_t queueTime_us = static_cast<int64_t>(txQueueDepth_ - 1)*(getFrameTime(8) + frameSpacing_us_);
+	int64_t releaseTime_us = busFreeTime_us_ - queueTime_us;
+	if (releaseTime_us < static_cast<int64_t>(slots_[iSlot].offset_us)) {
+		releaseTime_us = slots_[iSlot].offset_us;
+	}
+	return static_cast<unsigned int>(releaseTime_us);
+}
+
+unsigned int TransmitScheduler::getNumberOfDroppedFrames() const
+{
+	return nDroppedFrames_;
+}
+
+unsigned int TransmitScheduler::getNumberOfRequeuedFrames() const
+{
+	return nRequeuedFrames_;
+}
+
+unsigned int TransmitScheduler::getNumberOfHeldSDOFrames() const
+{
+	return nHeldSDOFrames_.load(std::memory_order_relaxed);
+}
+
+void TransmitScheduler::setBusIndex(int iBus)
+{
+	iBus_ = iBus;
+}
+
+int TransmitScheduler::getActiveSlot() const
+{
+	for (int i=0; i<nSlots; i++) {
+		const int iSlot = order_[i];
+		if (iSlot == static_cast<int>(Slots::sdo)
+				&& maxSDOFramesPerCycle_ > 0 && nSDOFrames_ >= maxSDOFramesPerCycle_) {
+			/* the remaining SDOs are sent in the next cycle */
+			continue;
+		}
+		if (!slots_[iSlot].frames.isEmpty()) {
+			return iSlot;
+		}
+	}
+	return -1;
+}
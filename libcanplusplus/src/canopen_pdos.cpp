@@ -0,0 +1,36 @@
+/*!
+ * @file 	canopen_pdos.cpp
+ * @brief	PDOs of the CANopen communication profile that are not inline
+ * @date 	Oct, 2026
+ * @version 1.0
+ * @ingroup robotCAN
+ *
+ */
+
+#include "libcanplusplus/canopen_pdos.hpp"
+#include "libcanplusplus/Trace.hpp"
+
+namespace canopen {
+
+/* not inline, since its tracepoint is only compiled with LIBCANPLUSPLUS_TRACEPOINTS */
+void TxPDONMT::processMsg()
+{
+  // bit 7 is the toggle bit of a node guarding response
+  const uint8_t state = (uint8_t)(value_[0]) & 0x7F;
+  if (state != state_) {
+    LIBCANPLUSPLUS_TRACE3(nmt_state, nodeId_, state_, state);
+  }
+  state_ = state;
+  if (isBootup()) {
+    nBootups_++;
+  }
+  if (heartbeatMonitor_ != nullptr) {
+    if (isBootup()) {
+      heartbeatMonitor_->bootupReceived(nodeId_);
+    } else {
+      heartbeatMonitor_->heartbeatReceived(nodeId_);
+    }
+  }
+}
+
+}
@@ -0,0 +1,158 @@
+/*!
+* @file 	canopenClient_main.cpp
+* @date		Oct, 2026
+* @version 	1.0
+* @ingroup 	robotCAN
+* @brief	Reads frames and accesses objects of the nodes through a running
+* 			master daemon (canopenMaster) with a MasterClient.
+*
+* 			Usage: canopenClient [-m name] [-b bus] frames COB-ID ...
+* 			       canopenClient [-m name] [-b bus] read node index subindex
+* 			       canopenClient [-m name] [-b bus] write node index subindex length value
+*
+* 			frames prints the last received frames of the COB-IDs from one
+* 			cycle, read and write queue an SDO and print its result. The
+* 			numbers may be decimal or hexadecimal (0x...). The exit code is 1
+* 			if the daemon does not run or the SDO did not complete.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libcanplusplus/MasterClient.hpp"
+
+namespace {
+
+//! time to wait for the result of an SDO [us]
+const int sdoTimeout_us = 2000000;
+
+void printUsage()
+{
+	fprintf(stderr, "Usage: canopenClient [-m name] [-b bus] frames COB-ID ...\n");
+	fprintf(stderr, "       canopenClient [-m name] [-b bus] read node index subindex\n");
+	fprintf(stderr, "       canopenClient [-m name] [-b bus] write node index subindex length value\n");
+}
+
+long parse(const char* text)
+{
+	return strtol(text, NULL, 0);
+}
+
+int printFrames(MasterClient& client, int iBus, char** arguments, int nArguments)
+{
+	const int maxFrames = 64;
+	int COBIds[maxFrames];
+	CANMsg frames[maxFrames];
+	const int nFrames = nArguments < maxFrames ? nArguments : maxFrames;
+	for (int i=0; i<nFrames; i++) {
+		COBIds[i] = (int)parse(arguments[i]);
+	}
+	uint32_t cycle = 0;
+	if (!client.readFrames(iBus, COBIds, nFrames, frames, &cycle)) {
+		fprintf(stderr, "Could not read the frames of bus %d!\n", iBus);
+		return 1;
+	}
+	printf("cycle %u\n", cycle);
+	for (int i=0; i<nFrames; i++) {
+		if (frames[i].flag == 0) {
+			printf("0x%03X  never received\n", COBIds[i]);
+			continue;
+		}
+		printf("0x%03X  cycle %u  [%d]", COBIds[i], frames[i].sequence, (int)frames[i].length);
+		for (int j=0; j<frames[i].length; j++) {
+			printf(" %02X", frames[i].value[j]);
+		}
+		printf("\n");
+	}
+	return 0;
+}
+
+int accessObject(MasterClient& client, int iBus, bool isWrite, char** arguments, int nArguments)
+{
+	if (nArguments < (isWrite ? 5 : 3)) {
+		printUsage();
+		return 1;
+	}
+	const int nodeId = (int)parse(arguments[0]);
+	const int index = (int)parse(arguments[1]);
+	const int subIndex = (int)parse(arguments[2]);
+	const uint32_t id = isWrite
+			? client.queueSDOWrite(iBus, nodeId, index, subIndex, (int)parse(arguments[3]), (int32_t)parse(arguments[4]))
+			: client.queueSDORead(iBus, nodeId, index, subIndex);
+	if (id == 0) {
+		fprintf(stderr, "Could not queue the SDO!\n");
+		return 1;
+	}
+
+	MasterSDOResult result;
+	for (int waited_us=0; waited_us<sdoTimeout_us; waited_us+=1000) {
+		if (!client.getSDOResult(iBus, &result)) {
+			usleep(1000);
+			continue;
+		}
+		if (result.id != id) {
+			continue;
+		}
+		switch (result.status) {
+		case MasterSDOStatus::completed:
+			if (isWrite) {
+				printf("node %d 0x%04X/%d written\n", nodeId, index, subIndex);
+			} else {
+				printf("node %d 0x%04X/%d = %d (0x%08X)\n", nodeId, index, subIndex, result.value, (uint32_t)result.value);
+			}
+			return 0;
+		case MasterSDOStatus::aborted:
+			printf("node %d 0x%04X/%d aborted with 0x%08X\n", nodeId, index, subIndex, result.abortCode);
+			return 1;
+		case MasterSDOStatus::timeout:
+			printf("node %d 0x%04X/%d timed out\n", nodeId, index, subIndex);
+			return 1;
+		case MasterSDOStatus::rejected:
+			printf("node %d 0x%04X/%d rejected by the daemon\n", nodeId, index, subIndex);
+			return 1;
+		}
+	}
+	fprintf(stderr, "The daemon did not return a result!\n");
+	return 1;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const char* name = MasterServer::defaultName;
+	int iBus = 0;
+	int i = 1;
+	for (; i<argc && argv[i][0] == '-'; i++) {
+		if (strcmp(argv[i], "-m") == 0 && i+1 < argc) {
+			name = argv[++i];
+		} else if (strcmp(argv[i], "-b") == 0 && i+1 < argc) {
+			iBus = atoi(argv[++i]);
+		} else {
+			printUsage();
+			return 1;
+		}
+	}
+	if (i >= argc) {
+		printUsage();
+		return 1;
+	}
+
+	MasterClient client;
+	if (!client.attach(name, "canopenClient")) {
+		fprintf(stderr, "Could not attach to the master %s (not running, different version or no free slot)!\n", name);
+		return 1;
+	}
+	const char* command = argv[i++];
+	if (strcmp(command, "frames") == 0) {
+		return printFrames(client, iBus, &argv[i], argc - i);
+	}
+	if (strcmp(command, "read") == 0 || strcmp(command, "write") == 0) {
+		return accessObject(client, iBus, strcmp(command, "write") == 0, &argv[i], argc - i);
+	}
+	printUsage();
+	return 1;
+}
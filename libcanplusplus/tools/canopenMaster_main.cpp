@@ -0,0 +1,166 @@
+/*!
+* @file 	canopenMaster_main.cpp
+* @date		Oct, 2026
+* @version 	1.0
+* @ingroup 	robotCAN
+* @brief	CANopen master daemon that shares its buses with client processes.
+* 			The daemon opens a SocketCAN channel per bus and runs the cycle of
+* 			each bus (SYNC, receive, send) in a real-time thread. A MasterServer
+* 			publishes the received frames in a shared memory segment and sends
+* 			the setpoints and SDOs of the clients, see MasterClient and the
+* 			tool canopenClient.
+*
+* 			Usage: canopenMaster [-p period_us] [-l lease] [-s] [-m name] interface ...
+*
+* 			-p is the period of the cycles (default 1000 us), -l the number of
+* 			cycles a setpoint is sent without a new one (default 100), -s
+* 			disables the SYNC and -m sets the name of the segment. The bus
+* 			index of an interface is its position on the command line. The
+* 			daemon runs until SIGINT or SIGTERM and removes the segment.
+*/
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+
+#include "libcanplusplus/Bus.hpp"
+#include "libcanplusplus/CyclePipeline.hpp"
+#include "libcanplusplus/Logger.hpp"
+#include "libcanplusplus/MasterServer.hpp"
+#include "libcanplusplus/Metrics.hpp"
+#include "libcanplusplus/RealTimeThread.hpp"
+#include "libcanplusplus/SocketCANChannel.hpp"
+
+namespace {
+
+//! cleared by SIGINT and SIGTERM
+std::atomic<bool> isRunning(true);
+
+void stop(int signal)
+{
+	isRunning.store(false, std::memory_order_release);
+}
+
+int send(const CANMsg& frame, void* channel)
+{
+	return ((SocketCANChannel*) channel)->send(frame);
+}
+
+int receive(CANMsg* frame, int64_t timeout_us, void* channel)
+{
+	return ((SocketCANChannel*) channel)->receive(frame, timeout_us);
+}
+
+void* runPipeline(void* pipeline)
+{
+	((CyclePipeline*) pipeline)->run(isRunning);
+	return NULL;
+}
+
+void printUsage()
+{
+	fprintf(stderr, "Usage: canopenMaster [-p period_us] [-l lease] [-s] [-m name] interface ...\n");
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int period_us = 1000;
+	unsigned int lease = 100;
+	bool isSync = true;
+	const char* name = MasterServer::defaultName;
+	const char* interfaces[MasterSegment::maxBuses];
+	int nBuses = 0;
+
+	for (int i=1; i<argc; i++) {
+		if (strcmp(argv[i], "-p") == 0 && i+1 < argc) {
+			period_us = (unsigned int)atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-l") == 0 && i+1 < argc) {
+			lease = (unsigned int)atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-s") == 0) {
+			isSync = false;
+		} else if (strcmp(argv[i], "-m") == 0 && i+1 < argc) {
+			name = argv[++i];
+		} else if (argv[i][0] != '-' && nBuses < MasterSegment::maxBuses) {
+			interfaces[nBuses++] = argv[i];
+		} else {
+			printUsage();
+			return 1;
+		}
+	}
+	if (nBuses == 0 || period_us == 0) {
+		printUsage();
+		return 1;
+	}
+
+	signal(SIGINT, stop);
+	signal(SIGTERM, stop);
+	RealTimeThread::lockMemory();
+	Metrics::open();
+
+	MasterServer server;
+	if (!server.open(name)) {
+		return 1;
+	}
+	server.setLease(lease);
+
+	SocketCANChannel channels[MasterSegment::maxBuses];
+	Bus* buses[MasterSegment::maxBuses];
+	CyclePipeline* pipelines[MasterSegment::maxBuses];
+	for (int i=0; i<nBuses; i++) {
+		if (!channels[i].open(interfaces[i])) {
+			Logger::log(LogLevels::error, "canopenMaster: Could not open %s!", interfaces[i]);
+			return 1;
+		}
+		channels[i].setBusIndex(i);
+		buses[i] = new Bus(i);
+		pipelines[i] = new CyclePipeline(buses[i], period_us);
+		pipelines[i]->setTransport(send, receive, &channels[i]);
+		pipelines[i]->setSync(isSync);
+		server.addPipeline(pipelines[i]);
+	}
+
+	/* the diagnostics of the cycles are formatted outside of the cycle threads */
+	Logger::start();
+
+	pthread_t threads[MasterSegment::maxBuses];
+	int nThreads = 0;
+	for (; nThreads<nBuses; nThreads++) {
+		if (RealTimeThread::create(&threads[nThreads], runPipeline, pipelines[nThreads]) != 0) {
+			Logger::log(LogLevels::error, "canopenMaster: Could not create the thread of %s!", interfaces[nThreads]);
+			isRunning.store(false, std::memory_order_release);
+			break;
+		}
+	}
+	Logger::log(LogLevels::info, "canopenMaster: Serving %d buses with a period of %u us in %s.",
+			nBuses, period_us, name);
+
+	/* the emergency objects are dispatched and the slots of clients that crashed are
+	 * freed outside of the cycles */
+	for (unsigned int iLoop=1; isRunning.load(std::memory_order_acquire); iLoop++) {
+		usleep(10000);
+		for (int i=0; i<nBuses; i++) {
+			buses[i]->getEMCYManager()->dispatch();
+		}
+		if (iLoop % 100 == 0) {
+			server.reapClients();
+		}
+	}
+
+	for (int i=0; i<nThreads; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	Logger::stop();
+	server.close();
+	for (int i=0; i<nBuses; i++) {
+		delete pipelines[i];
+		delete buses[i];
+		channels[i].close();
+	}
+	Metrics::close();
+	return 0;
+}
@@ -0,0 +1,527 @@
+/*!
+* @file 	cycleAudit_main.cpp
+* @date		Oct, 2026
+* @version 	1.0
+* @ingroup 	robotCAN
+* @brief	Audits the cycle of a synthetic bus for heap allocations and output.
+* 			The program interposes malloc/free and the write/printf family,
+* 			runs a number of cycles of a bus with simulated nodes that answer
+* 			the SDOs (including aborts and lost responses) and reports every
+* 			allocation and every output of the cycle with its backtrace.
+*
+* 			Usage: cycleAudit [number of cycles] [number of devices]
+*
+* 			The exit code is 0 if the cycle neither allocated nor wrote,
+* 			otherwise 1. Only the thread that runs the cycle is audited.
+* 			The interposition relies on glibc (__libc_malloc, RTLD_NEXT).
+*/
+
+#undef _FORTIFY_SOURCE
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <execinfo.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#include "libcanplusplus/BusManager.hpp"
+#include "libcanplusplus/Bus.hpp"
+#include "libcanplusplus/Device.hpp"
+#include "libcanplusplus/canopen_sdos.hpp"
+#include "libcanplusplus/Logger.hpp"
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void __libc_free(void* p);
+void* __libc_memalign(size_t alignment, size_t size);
+}
+
+
+/*******************************************************
+ * RECORDING
+ *******************************************************/
+
+namespace {
+
+//! type of an audited event
+enum EventTypes {
+	EVENT_ALLOCATION = 0,
+	EVENT_FREE,
+	EVENT_OUTPUT,
+	nEventTypes
+};
+
+const char* eventNames[nEventTypes] = {"allocation", "free", "output"};
+
+//! maximum number of frames of a backtrace
+const int maxFrames = 24;
+
+//! maximum number of distinct backtraces
+const int maxRecords = 256;
+
+//! events with the same type, function and backtrace
+struct Record {
+	int type;
+	const char* function;
+	//! largest number of bytes
+	size_t size;
+	unsigned long count;
+	int nFrames;
+	void* frames[maxFrames];
+};
+
+//! distinct events, the storage is static such that recording does not allocate
+Record records[maxRecords];
+int nRecords = 0;
+
+//! number of events per type
+unsigned long nEvents[nEventTypes] = {0, 0, 0};
+
+//! number of events whose backtrace did not fit into records
+unsigned long nDroppedRecords = 0;
+
+//! if true, the events of the audited thread are recorded
+volatile bool isAuditing = false;
+
+//! true for the thread that runs the cycle
+thread_local bool isAuditedThread = false;
+
+//! prevents recursion if a hook is invoked while recording
+thread_local bool isInHook = false;
+
+//! Records an event of the audited thread
+__attribute__((noinline)) void recordEvent(int type, const char* function, size_t size)
+{
+	if (!isAuditing || !isAuditedThread || isInHook) {
+		return;
+	}
+	isInHook = true;
+	nEvents[type]++;
+
+	void* frames[maxFrames];
+	const int nFrames = backtrace(frames, maxFrames);
+
+	/* identical backtraces are counted in one record */
+	for (int i=0; i<nRecords; i++) {
+		Record& record = records[i];
+		if (record.type == type && record.function == function && record.nFrames == nFrames
+				&& memcmp(record.frames, frames, nFrames*sizeof(void*)) == 0) {
+			record.count++;
+			if (size > record.size) {
+				record.size = size;
+			}
+			isInHook = false;
+			return;
+		}
+	}
+
+	if (nRecords < maxRecords) {
+		Record& record = records[nRecords++];
+		record.type = type;
+		record.function = function;
+		record.size = size;
+		record.count = 1;
+		record.nFrames = nFrames;
+		memcpy(record.frames, frames, nFrames*sizeof(void*));
+	} else {
+		nDroppedRecords++;
+	}
+	isInHook = false;
+}
+
+//! Gets the next definition of a function, i.e. the one of the C library
+template <typename Function>
+Function getNext(Function& function, const char* name)
+{
+	if (function == NULL) {
+		function = (Function)dlsym(RTLD_NEXT, name);
+	}
+	return function;
+}
+
+ssize_t (*nextWrite)(int, const void*, size_t) = NULL;
+ssize_t (*nextWritev)(int, const struct iovec*, int) = NULL;
+int (*nextVprintf)(const char*, va_list) = NULL;
+int (*nextVfprintf)(FILE*, const char*, va_list) = NULL;
+int (*nextVprintfChk)(int, const char*, va_list) = NULL;
+int (*nextVfprintfChk)(FILE*, int, const char*, va_list) = NULL;
+int (*nextPuts)(const char*) = NULL;
+int (*nextFputs)(const char*, FILE*) = NULL;
+int (*nextPutchar)(int) = NULL;
+size_t (*nextFwrite)(const void*, size_t, size_t, FILE*) = NULL;
+
+//! Resolves the functions of the C library before the audit, dlsym() may allocate
+void resolveFunctions()
+{
+	getNext(nextWrite, "write");
+	getNext(nextWritev, "writev");
+	getNext(nextVprintf, "vprintf");
+	getNext(nextVfprintf, "vfprintf");
+	getNext(nextVprintfChk, "__vprintf_chk");
+	getNext(nextVfprintfChk, "__vfprintf_chk");
+	getNext(nextPuts, "puts");
+	getNext(nextFputs, "fputs");
+	getNext(nextPutchar, "putchar");
+	getNext(nextFwrite, "fwrite");
+
+	/* the first backtrace loads the unwinder */
+	void* frames[maxFrames];
+	backtrace(frames, maxFrames);
+}
+
+}
+
+
+/*******************************************************
+ * INTERPOSED FUNCTIONS
+ *******************************************************/
+
+extern "C" {
+
+void* malloc(size_t size) __THROW
+{
+	recordEvent(EVENT_ALLOCATION, "malloc", size);
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size) __THROW
+{
+	recordEvent(EVENT_ALLOCATION, "calloc", n*size);
+	return __libc_calloc(n, size);
+}
+
+void* realloc(void* p, size_t size) __THROW
+{
+	recordEvent(EVENT_ALLOCATION, "realloc", size);
+	return __libc_realloc(p, size);
+}
+
+int posix_memalign(void** p, size_t alignment, size_t size) __THROW
+{
+	recordEvent(EVENT_ALLOCATION, "posix_memalign", size);
+	*p = __libc_memalign(alignment, size);
+	return *p == NULL ? ENOMEM : 0;
+}
+
+void free(void* p) __THROW
+{
+	if (p != NULL) {
+		recordEvent(EVENT_FREE, "free", 0);
+	}
+	__libc_free(p);
+}
+
+ssize_t write(int fd, const void* buffer, size_t n)
+{
+	recordEvent(EVENT_OUTPUT, "write", n);
+	return getNext(nextWrite, "write")(fd, buffer, n);
+}
+
+ssize_t writev(int fd, const struct iovec* iov, int iovcnt)
+{
+	recordEvent(EVENT_OUTPUT, "writev", 0);
+	return getNext(nextWritev, "writev")(fd, iov, iovcnt);
+}
+
+int printf(const char* format, ...)
+{
+	recordEvent(EVENT_OUTPUT, "printf", 0);
+	va_list args;
+	va_start(args, format);
+	const int rc = getNext(nextVprintf, "vprintf")(format, args);
+	va_end(args);
+	return rc;
+}
+
+int vprintf(const char* format, va_list args)
+{
+	recordEvent(EVENT_OUTPUT, "vprintf", 0);
+	return getNext(nextVprintf, "vprintf")(format, args);
+}
+
+int fprintf(FILE* stream, const char* format, ...)
+{
+	recordEvent(EVENT_OUTPUT, "fprintf", 0);
+	va_list args;
+	va_start(args, format);
+	const int rc = getNext(nextVfprintf, "vfprintf")(stream, format, args);
+	va_end(args);
+	return rc;
+}
+
+int vfprintf(FILE* stream, const char* format, va_list args)
+{
+	recordEvent(EVENT_OUTPUT, "vfprintf", 0);
+	return getNext(nextVfprintf, "vfprintf")(stream, format, args);
+}
+
+int __printf_chk(int flag, const char* format, ...)
+{
+	recordEvent(EVENT_OUTPUT, "printf", 0);
+	va_list args;
+	va_start(args, format);
+	const int rc = getNext(nextVprintfChk, "__vprintf_chk")(flag, format, args);
+	va_end(args);
+	return rc;
+}
+
+int __fprintf_chk(FILE* stream, int flag, const char* format, ...)
+{
+	recordEvent(EVENT_OUTPUT, "fprintf", 0);
+	va_list args;
+	va_start(args, format);
+	const int rc = getNext(nextVfprintfChk, "__vfprintf_chk")(stream, flag, format, args);
+	va_end(args);
+	return rc;
+}
+
+int puts(const char* s)
+{
+	recordEvent(EVENT_OUTPUT, "puts", 0);
+	return getNext(nextPuts, "puts")(s);
+}
+
+int fputs(const char* s, FILE* stream)
+{
+	recordEvent(EVENT_OUTPUT, "fputs", 0);
+	return getNext(nextFputs, "fputs")(s, stream);
+}
+
+int putchar(int c)
+{
+	recordEvent(EVENT_OUTPUT, "putchar", 1);
+	return getNext(nextPutchar, "putchar")(c);
+}
+
+size_t fwrite(const void* buffer, size_t size, size_t n, FILE* stream)
+{
+	recordEvent(EVENT_OUTPUT, "fwrite", size*n);
+	return getNext(nextFwrite, "fwrite")(buffer, size, n, stream);
+}
+
+}
+
+
+/*******************************************************
+ * SYNTHETIC BUS
+ *******************************************************/
+
+//! Device with one RxPDO and one TxPDO whose node is simulated
+class AuditDevice : public Device {
+public:
+	AuditDevice(int nodeId, int rxPDOSMId, int txPDOSMId, int sdoInSMId, int sdoOutSMId)
+	:Device(nodeId),
+	 rxPDO_(NULL),
+	 txPDO_(NULL),
+	 rxPDOSMId_(rxPDOSMId),
+	 txPDOSMId_(txPDOSMId),
+	 sdoInSMId_(sdoInSMId),
+	 sdoOutSMId_(sdoOutSMId)
+	{
+		sdos_.reserve(16);
+	}
+
+	virtual ~AuditDevice() {}
+
+	virtual void addRxPDOs() {
+		rxPDO_ = new CANOpenMsg(canopen::RxPDO1Id + nodeId_, rxPDOSMId_);
+		bus_->getRxPDOManager()->addPDO(rxPDO_);
+	}
+
+	virtual void addTxPDOs() {
+		txPDO_ = new CANOpenMsg(canopen::TxPDO1Id + nodeId_, txPDOSMId_);
+		bus_->getTxPDOManager()->addPDO(txPDO_);
+	}
+
+	virtual bool initDevice() {
+		return true;
+	}
+
+	//! Sets the command of the RxPDO
+	void setCommand(int command) {
+		int value[1] = {command};
+		int length[1] = {4};
+		rxPDO_->setValue(value, 1);
+		rxPDO_->setLength(length, 1);
+		rxPDO_->setFlag(1);
+	}
+
+	//! Writes the controlword with an SDO
+	void writeControlword(int controlword) {
+		sendSDO(new canopen::SDOWrite(sdoInSMId_, sdoOutSMId_, nodeId_, WRITE_2_BYTE, 0x6040, 0x00, controlword));
+	}
+
+private:
+	CANOpenMsg* rxPDO_;
+	CANOpenMsg* txPDO_;
+	int rxPDOSMId_;
+	int txPDOSMId_;
+	int sdoInSMId_;
+	int sdoOutSMId_;
+};
+
+//! Simulates the nodes: answers the SDOs and sends the TxPDOs
+/*! Every abortPeriod-th SDO is aborted and every lostPeriod-th SDO is not answered
+ * at all, such that the error paths of the SDOs are part of the audit.
+ */
+void simulateNodes(const CANMsg* sent, int nSent, CANMsg* received, int nDevices,
+					int sdoInSMId, unsigned long cycle)
+{
+	static const unsigned long abortPeriod = 7;
+	static const unsigned long lostPeriod = 11;
+	static unsigned long nSDOs = 0;
+
+	for (int i=0; i<nSent; i++) {
+		if (!sent[i].flag || sent[i].COBId < canopen::RxSDOId || sent[i].COBId >= canopen::RxSDOId + 0x80) {
+			continue;
+		}
+		nSDOs++;
+		if (nSDOs % lostPeriod == 0) {
+			continue;
+		}
+		CANMsg& response = received[sdoInSMId];
+		response.flag = 1;
+		response.COBId = canopen::TxSDOId + sent[i].COBId - canopen::RxSDOId;
+		response.length = 8;
+		response.value[1] = sent[i].value[1];
+		response.value[2] = sent[i].value[2];
+		response.value[3] = sent[i].value[3];
+		if (nSDOs % abortPeriod == 0) {
+			/* abort: object does not exist */
+			response.value[0] = 0x80;
+			response.value[4] = 0x00;
+			response.value[5] = 0x00;
+			response.value[6] = 0x02;
+			response.value[7] = 0x06;
+		} else {
+			response.value[0] = 0x60;
+			response.value[4] = response.value[5] = response.value[6] = response.value[7] = 0;
+		}
+	}
+
+	for (int iDevice=0; iDevice<nDevices; iDevice++) {
+		CANMsg& pdo = received[1 + iDevice];
+		pdo.flag = 1;
+		pdo.COBId = canopen::TxPDO1Id + 1 + iDevice;
+		pdo.length = 4;
+		for (int j=0; j<4; j++) {
+			pdo.value[j] = (cycle >> (8*j)) & 0xFF;
+		}
+	}
+}
+
+//! Prints a record with its backtrace
+void printRecord(const Record& record)
+{
+	printf("\n%s: %s, %lu times, max. %lu bytes\n", eventNames[record.type], record.function,
+			record.count, (unsigned long)record.size);
+	fflush(stdout);
+	/* the first frame is recordEvent() */
+	backtrace_symbols_fd((void* const*)(record.frames + 1), record.nFrames - 1, STDOUT_FILENO);
+}
+
+
+/*******************************************************
+ * MAIN
+ *******************************************************/
+
+//! maximum number of devices
+const int maxDevices = 64;
+
+//! number of cycles before the audit, e.g. to fill the pools
+const int nWarmUpCycles = 100;
+
+//! manager of all CAN buses
+BusManager busManager;
+
+int main(int argc, char** argv)
+{
+	const unsigned long nCycles = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000;
+	int nDevices = (argc > 2) ? atoi(argv[2]) : 4;
+	if (nDevices < 1 || nDevices > maxDevices) {
+		printf("The number of devices must be between 1 and %d!\n", maxDevices);
+		return 2;
+	}
+
+	/* shared memory indices: 0 heartbeats and SYNC, 1..nDevices PDOs, nDevices+1 SDO */
+	const int sdoSMId = nDevices + 1;
+	const int nMsgs = nDevices + 2;
+	CANMsg sent[maxDevices + 2];
+	CANMsg received[maxDevices + 2];
+
+	/* initialization */
+	CANOpenMsg::reservePool(4*nDevices + 32);
+	SDOMsg::reservePool(2*nDevices + 16);
+
+	Bus* bus = new Bus(0);
+	busManager.addBus(bus);
+	bus->getSDOManager()->reserve(2*nDevices + 16);
+	bus->getRxPDOManager()->reserve(nDevices + 1);
+	bus->getTxPDOManager()->reserve(2*nDevices);
+	bus->getRxPDOManager()->addPDO(new canopen::RxPDOSync(0));
+	for (int iDevice=0; iDevice<nDevices; iDevice++) {
+		bus->getDeviceManager()->addDevice(new AuditDevice(1 + iDevice, 1 + iDevice, 1 + iDevice, sdoSMId, sdoSMId));
+	}
+	bus->getRxPDOManager()->setSending(true);
+
+	/* the diagnostics of the cycle are formatted by the background thread */
+	Logger::start();
+	resolveFunctions();
+	isAuditedThread = true;
+
+	printf("Auditing %lu cycles of a bus with %d devices after %d warm-up cycles\n",
+			nCycles, nDevices, nWarmUpCycles);
+	fflush(stdout);
+
+	for (unsigned long cycle=0; cycle<nWarmUpCycles + nCycles; cycle++) {
+		if (cycle == (unsigned long)nWarmUpCycles) {
+			isAuditing = true;
+		}
+
+		/* nodes */
+		for (int i=0; i<nMsgs; i++) {
+			received[i].flag = 0;
+		}
+		simulateNodes(sent, nMsgs, received, nDevices, sdoSMId, cycle);
+
+		/* received messages */
+		bus->ingest(Span<const CANMsg>(received, nMsgs));
+
+		/* task: a command per cycle, an SDO per device every 20 cycles */
+		for (int iDevice=0; iDevice<nDevices; iDevice++) {
+			AuditDevice* device = (AuditDevice*)bus->getDeviceManager()->getDevice(iDevice);
+			device->setCommand((int)cycle);
+			if ((cycle + iDevice) % 20 == 0) {
+				device->writeControlword(0x000F);
+			}
+		}
+
+		/* messages to send */
+		bus->emit(Span<CANMsg>(sent, nMsgs));
+	}
+	isAuditing = false;
+	Logger::stop();
+
+	/* report */
+	printf("\n* * * * * * * * * * * * *\n");
+	printf("* %lu allocations, %lu frees, %lu outputs in %lu cycles\n",
+			nEvents[EVENT_ALLOCATION], nEvents[EVENT_FREE], nEvents[EVENT_OUTPUT], nCycles);
+	printf("* %d distinct backtraces", nRecords);
+	if (nDroppedRecords > 0) {
+		printf(", %lu events with further backtraces not shown", nDroppedRecords);
+	}
+	printf("\n* * * * * * * * * * * * *\n");
+	for (int i=0; i<nRecords; i++) {
+		printRecord(records[i]);
+	}
+	fflush(stdout);
+
+	const unsigned long nTotal = nEvents[EVENT_ALLOCATION] + nEvents[EVENT_FREE] + nEvents[EVENT_OUTPUT];
+	return nTotal == 0 ? 0 : 1;
+}
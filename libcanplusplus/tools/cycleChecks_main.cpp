@@ -0,0 +1,233 @@
+/*!
+* @file 	cycleChecks_main.cpp
+* @date		Oct, 2026
+* @version 	1.0
+* @ingroup 	robotCAN
+* @brief	Checks the processing of the frames of a cycle without a CAN driver.
+* 			Each check builds a bus or PDOs, passes synthetic frames and
+* 			compares the results with the expected ones.
+*
+* 			Usage: cycleChecks
+*
+* 			Every failed check is printed. The exit code is 0 if all checks
+* 			passed, otherwise 1.
+*/
+
+#include <stdio.h>
+
+#include "libcanplusplus/BootManager.hpp"
+#include "libcanplusplus/CANMsg.hpp"
+#include "libcanplusplus/CyclePipeline.hpp"
+#include "libcanplusplus/Device.hpp"
+#include "libcanplusplus/StaticBus.hpp"
+#include "libcanplusplus/canopen_sdos.hpp"
+
+namespace {
+
+//! number of failed checks
+int nFailures = 0;
+
+void check(bool isPassed, const char* name)
+{
+	if (!isPassed) {
+		printf("FAILED: %s\n", name);
+		nFailures++;
+	}
+}
+
+//! TxPDO with one value
+class TxPDOValue: public StaticPDO<TxPDOValue> {
+public:
+	TxPDOValue(int SMId): StaticPDO<TxPDOValue>(0x181, SMId), value_(0) {}
+	void decode(const unsigned char* data, int length) { value_ = (length > 0) ? data[0] : 0; }
+	int encode(unsigned char* data) { return 0; }
+	int value_;
+};
+
+//! a static PDO counts its age from the first received frame
+void checkStaticPDOAge()
+{
+	TxPDOValue pdo(0);
+	check(pdo.getAge_cycles() == -1, "a new static PDO was never received");
+
+	CANMsg frame;
+	pdo.receive(frame);
+	check(pdo.getAge_cycles() == -1 && !pdo.isUpdated(), "an empty frame does not receive a static PDO");
+
+	frame.flag = 1;
+	frame.COBId = 0x181;
+	frame.length = 1;
+	frame.value[0] = 7;
+	frame.sequence = 1;
+	pdo.receive(frame);
+	check(pdo.getAge_cycles() == 0 && pdo.isUpdated() && pdo.value_ == 7, "a static PDO decodes a new frame");
+
+	pdo.receive(frame);
+	pdo.receive(frame);
+	check(pdo.getAge_cycles() == 2 && !pdo.isUpdated(), "a static PDO ages while its frame is not new");
+}
+
+//! RxPDO with one value
+class RxPDOValue: public StaticPDO<RxPDOValue> {
+public:
+	RxPDOValue(int SMId): StaticPDO<RxPDOValue>(0x201, SMId), value_(0) { setFlag(1); }
+	void decode(const unsigned char* data, int length) {}
+	int encode(unsigned char* data) { data[0] = (unsigned char)value_; return 1; }
+	int value_;
+};
+
+//! the static PDOs of a StaticBus are processed through a pointer to Bus
+void checkStaticBusThroughBus()
+{
+	typedef StaticPDOTable<TxPDOValue> TxPDOs;
+	typedef StaticPDOTable<RxPDOValue> RxPDOs;
+	StaticBus<TxPDOs, RxPDOs> staticBus(0, TxPDOs(TxPDOValue(0)), RxPDOs(RxPDOValue(0)));
+	staticBus.getRxPDOManager()->setSending(true);
+	staticBus.getStaticRxPDOs().get<0>().value_ = 9;
+	Bus* bus = &staticBus;
+
+	CANMsg received[1];
+	received[0].flag = 1;
+	received[0].COBId = 0x181;
+	received[0].length = 1;
+	received[0].value[0] = 5;
+	received[0].sequence = 1;
+	CANMsg sent[1];
+	bus->ingest(Span<const CANMsg>(received, 1));
+	bus->emit(Span<CANMsg>(sent, 1));
+	check(staticBus.getStaticTxPDOs().get<0>().value_ == 5, "a static TxPDO is received through a pointer to Bus");
+	check(sent[0].flag && sent[0].COBId == 0x201 && sent[0].value[0] == 9, "a static RxPDO is sent through a pointer to Bus");
+}
+
+//! node without PDOs, only its SDO slots are allocated
+class DeviceSDOOnly: public Device {
+public:
+	DeviceSDOOnly(int nodeId): Device(nodeId) {}
+	void addRxPDOs() {}
+	void addTxPDOs() {}
+	bool initDevice() { return true; }
+};
+
+//! node ID of the simulated node
+const int nodeId = 1;
+//! number of SDO requests the simulated node answers
+int nAnswers = 0;
+//! number of SDO requests the simulated node received
+int nRequests = 0;
+//! command specifier of the SDO responses of the simulated node, 0x80 aborts
+int responseCommand = 0x60;
+//! SDO response that is received in the next period
+CANMsg response;
+
+int sendToNode(const CANMsg& frame, void* userData)
+{
+	if (frame.COBId == canopen::RxSDOId + nodeId) {
+		nRequests++;
+		if (nRequests <= nAnswers) {
+			response = frame;
+			response.COBId = canopen::TxSDOId + nodeId;
+			response.value[0] = responseCommand;
+			response.flag = 1;
+		}
+	} else if (frame.COBId == 0x00 && frame.value[0] == 0x82) {
+		/* boot-up message after the reset communication */
+		response = CANMsg();
+		response.COBId = 0x700 + nodeId;
+		response.length = 1;
+		response.value[0] = 0x00;
+		response.flag = 1;
+	}
+	return 1;
+}
+
+int receiveFromNode(CANMsg* frame, int64_t timeout_us, void* userData)
+{
+	if (response.flag == 0) {
+		return 0;
+	}
+	*frame = response;
+	response.flag = 0;
+	return 1;
+}
+
+//! a response is passed to one SDO only, the next SDO of the node waits for its own
+void checkPipelineSDOResponse()
+{
+	Bus bus(0);
+	bus.setAutomaticSlots(true);
+	bus.getDeviceManager()->addDevice(new DeviceSDOOnly(nodeId));
+	CyclePipeline pipeline(&bus, 200);
+	pipeline.setTransport(sendToNode, receiveFromNode);
+	pipeline.setSync(false);
+
+	nAnswers = 1;
+	SDOMsgPtr first(new canopen::SDOWriteProducerHeartbeatTime(SlotMap::autoSlot, SlotMap::autoSlot, nodeId, 100));
+	SDOMsgPtr second(new canopen::SDOWriteProducerHeartbeatTime(SlotMap::autoSlot, SlotMap::autoSlot, nodeId, 100));
+	bus.getSDOManager()->addSDO(first);
+	bus.getSDOManager()->addSDO(second);
+	for (int i=0; i<30; i++) {
+		pipeline.runCycle();
+	}
+	check(first->getIsReceived(), "the first SDO of a node receives its response");
+	check(nRequests == 2, "the second SDO of a node is sent after the first one");
+	check(!second->getIsReceived() && second->hasTimeOut(), "the second SDO of a node does not receive the response of the first one");
+}
+
+//! node with one configuration SDO
+class DeviceConfigured: public DeviceSDOOnly {
+public:
+	DeviceConfigured(int nodeId): DeviceSDOOnly(nodeId) {}
+	bool configureDevice() {
+		sendSDO(new canopen::SDOWriteProducerHeartbeatTime(SlotMap::autoSlot, SlotMap::autoSlot, nodeId_, 100));
+		return true;
+	}
+};
+
+void updateBootManager(void* userData)
+{
+	static_cast<BootManager*>(userData)->update();
+}
+
+//! a node that aborts a configuration SDO is not started
+void checkBootAbortedSDO()
+{
+	Bus bus(0);
+	bus.setAutomaticSlots(true);
+	bus.getDeviceManager()->addDevice(new DeviceConfigured(nodeId));
+	CyclePipeline pipeline(&bus, 200);
+	pipeline.setTransport(sendToNode, receiveFromNode);
+	pipeline.setSync(false);
+
+	BootManager bootManager(&bus, SlotMap::autoSlot, SlotMap::autoSlot);
+	bootManager.setBootupDelay(5);
+	pipeline.setControl(updateBootManager, &bootManager);
+
+	nRequests = 0;
+	nAnswers = 1;
+	responseCommand = 0x80;
+	bootManager.start();
+	for (int i=0; i<50 && bootManager.getState() != BootManager::States::failed; i++) {
+		pipeline.runCycle();
+	}
+	responseCommand = 0x60;
+	check(nRequests == 1, "the configuration SDO is sent once");
+	check(bootManager.getNodeState(0) == BootManager::NodeStates::failed, "a node that aborts a configuration SDO fails");
+	check(bootManager.getState() == BootManager::States::failed, "the boot-up fails if a configuration SDO is aborted");
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	checkStaticPDOAge();
+	checkStaticBusThroughBus();
+	checkPipelineSDOResponse();
+	checkBootAbortedSDO();
+
+	if (nFailures > 0) {
+		printf("%d checks failed\n", nFailures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
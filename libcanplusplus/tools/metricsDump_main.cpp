@@ -0,0 +1,195 @@
+/*!
+* @file 	metricsDump_main.cpp
+* @date		Oct, 2026
+* @version 	1.0
+* @ingroup 	robotCAN
+* @brief	Prints a snapshot of the metrics of a running process.
+* 			The program maps the shared memory segment that the process
+* 			created with Metrics::open() read-only and prints the counters
+* 			of the buses and nodes that are not zero.
+*
+* 			Usage: metricsDump [-j] [name of the segment]
+*
+* 			With -j, the snapshot is printed as JSON. The exit code is 1 if
+* 			the segment does not exist or has a different layout.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "libcanplusplus/Metrics.hpp"
+
+namespace {
+
+//! names and values of the counters of a bus
+struct BusCounter {
+	const char* name;
+	const MetricsCounter BusMetrics::* counter;
+};
+
+const BusCounter busCounters[] = {
+		{"framesReceived", &BusMetrics::framesReceived},
+		{"framesSent", &BusMetrics::framesSent},
+		{"framesDropped", &BusMetrics::framesDropped},
+		{"txBufferFull", &BusMetrics::txBufferFull},
+		{"busErrors", &BusMetrics::busErrors},
+		{"cycles", &BusMetrics::cycles},
+		{"cycleOverruns", &BusMetrics::cycleOverruns}
+};
+const int nBusCounters = sizeof(busCounters)/sizeof(busCounters[0]);
+
+//! names and values of the counters of a node (without the aborts by code)
+struct NodeCounter {
+	const char* name;
+	const MetricsCounter NodeMetrics::* counter;
+};
+
+const NodeCounter nodeCounters[] = {
+		{"sdoRequests", &NodeMetrics::sdoRequests},
+		{"sdoAborts", &NodeMetrics::sdoAborts},
+		{"sdoTimeouts", &NodeMetrics::sdoTimeouts},
+		{"sdoRetries", &NodeMetrics::sdoRetries},
+		{"heartbeatMisses", &NodeMetrics::heartbeatMisses},
+		{"emcyCount", &NodeMetrics::emcyCount}
+};
+const int nNodeCounters = sizeof(nodeCounters)/sizeof(nodeCounters[0]);
+
+unsigned long long read(const MetricsCounter& counter)
+{
+	return counter.load(std::memory_order_relaxed);
+}
+
+bool isUsed(const BusMetrics& bus)
+{
+	for (int i=0; i<nBusCounters; i++) {
+		if (read(bus.*busCounters[i].counter) != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool isUsed(const NodeMetrics& node)
+{
+	for (int i=0; i<nNodeCounters; i++) {
+		if (read(node.*nodeCounters[i].counter) != 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void printText(const MetricsSegment& segment)
+{
+	printf("pid: %d\n", segment.pid);
+	for (int iBus=0; iBus<MetricsSegment::maxBuses; iBus++) {
+		const BusMetrics& bus = segment.buses[iBus];
+		if (isUsed(bus)) {
+			printf("bus %d:\n", iBus);
+			for (int i=0; i<nBusCounters; i++) {
+				printf("  %-16s %llu\n", busCounters[i].name, read(bus.*busCounters[i].counter));
+			}
+		}
+		for (int nodeId=0; nodeId<MetricsSegment::maxNodes; nodeId++) {
+			const NodeMetrics& node = segment.nodes[iBus][nodeId];
+			if (!isUsed(node)) {
+				continue;
+			}
+			printf("bus %d node %d:\n", iBus, nodeId);
+			for (int i=0; i<nNodeCounters; i++) {
+				printf("  %-16s %llu\n", nodeCounters[i].name, read(node.*nodeCounters[i].counter));
+			}
+			for (int i=0; i<NodeMetrics::nAbortCodes; i++) {
+				const unsigned long long nAborts = read(node.sdoAbortsByCode[i]);
+				if (nAborts == 0) {
+					continue;
+				}
+				if (segment.abortCodes[i] != 0) {
+					printf("  abort %08X   %llu\n", segment.abortCodes[i], nAborts);
+				} else {
+					printf("  abort other      %llu\n", nAborts);
+				}
+			}
+		}
+	}
+}
+
+void printJSON(const MetricsSegment& segment)
+{
+	printf("{\"version\": %u, \"pid\": %d, \"startTime_ns\": %lld, \"buses\": [",
+			segment.version, segment.pid, (long long)segment.startTime_ns);
+	bool isFirstBus = true;
+	for (int iBus=0; iBus<MetricsSegment::maxBuses; iBus++) {
+		const BusMetrics& bus = segment.buses[iBus];
+		bool isBusUsed = isUsed(bus);
+		for (int nodeId=0; nodeId<MetricsSegment::maxNodes && !isBusUsed; nodeId++) {
+			isBusUsed = isUsed(segment.nodes[iBus][nodeId]);
+		}
+		if (!isBusUsed) {
+			continue;
+		}
+		printf("%s\n  {\"bus\": %d", isFirstBus ? "" : ",", iBus);
+		isFirstBus = false;
+		for (int i=0; i<nBusCounters; i++) {
+			printf(", \"%s\": %llu", busCounters[i].name, read(bus.*busCounters[i].counter));
+		}
+		printf(", \"nodes\": [");
+		bool isFirstNode = true;
+		for (int nodeId=0; nodeId<MetricsSegment::maxNodes; nodeId++) {
+			const NodeMetrics& node = segment.nodes[iBus][nodeId];
+			if (!isUsed(node)) {
+				continue;
+			}
+			printf("%s\n    {\"node\": %d", isFirstNode ? "" : ",", nodeId);
+			isFirstNode = false;
+			for (int i=0; i<nNodeCounters; i++) {
+				printf(", \"%s\": %llu", nodeCounters[i].name, read(node.*nodeCounters[i].counter));
+			}
+			printf(", \"sdoAbortsByCode\": {");
+			bool isFirstCode = true;
+			for (int i=0; i<NodeMetrics::nAbortCodes; i++) {
+				const unsigned long long nAborts = read(node.sdoAbortsByCode[i]);
+				if (nAborts == 0) {
+					continue;
+				}
+				if (segment.abortCodes[i] != 0) {
+					printf("%s\"0x%08X\": %llu", isFirstCode ? "" : ", ", segment.abortCodes[i], nAborts);
+				} else {
+					printf("%s\"other\": %llu", isFirstCode ? "" : ", ", nAborts);
+				}
+				isFirstCode = false;
+			}
+			printf("}}");
+		}
+		printf("]}");
+	}
+	printf("\n]}\n");
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	bool isJSON = false;
+	const char* name = Metrics::defaultName;
+	for (int i=1; i<argc; i++) {
+		if (strcmp(argv[i], "-j") == 0) {
+			isJSON = true;
+		} else {
+			name = argv[i];
+		}
+	}
+
+	const MetricsSegment* segment = Metrics::attach(name);
+	if (segment == NULL) {
+		fprintf(stderr, "Could not read the metrics %s (not created or different version)!\n", name);
+		return 1;
+	}
+	if (isJSON) {
+		printJSON(*segment);
+	} else {
+		printText(*segment);
+	}
+	Metrics::detach(segment);
+	return 0;
+}
@@ -0,0 +1,268 @@
+/*!
+* @file 	pdoBenchmark_main.cpp
+* @date		Oct, 2026
+* @version 	1.0
+* @ingroup 	robotCAN
+* @brief	Compares the cycle of a bus with virtual PDOs and of a StaticBus.
+* 			Both buses have one TxPDO (position and velocity) and one RxPDO
+* 			(velocity command) per device. The PDOs of the Bus are
+* 			CANOpenMsgs that decode in processMsg(), the PDOs of the StaticBus
+* 			are StaticPDOs that are stored by value in a StaticPDOTable.
+*
+* 			Usage: pdoBenchmark [number of cycles]
+*
+* 			The time of ingest() and emit() is printed per cycle.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "libcanplusplus/Bus.hpp"
+#include "libcanplusplus/StaticBus.hpp"
+#include "libcanplusplus/canopen_sdos.hpp"
+
+namespace {
+
+//! number of devices of a bus
+const int nDevices = 8;
+
+//! number of frames: 0 is unused, 1..nDevices are the PDOs
+const int nFrames = nDevices + 1;
+
+int32_t decodeInt32(const unsigned char* data)
+{
+	return (int32_t)(data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24));
+}
+
+void encodeInt32(unsigned char* data, int32_t value)
+{
+	for (int j=0; j<4; j++) {
+		data[j] = (value >> (8*j)) & 0xFF;
+	}
+}
+
+
+/*******************************************************
+ * VIRTUAL PDOS
+ *******************************************************/
+
+//! TxPDO with position and velocity that decodes in processMsg()
+class TxPDOPositionVelocity: public CANOpenMsg {
+public:
+	TxPDOPositionVelocity(int nodeId, int SMId)
+	:CANOpenMsg(canopen::TxPDO1Id + nodeId, SMId),
+	 position_(0),
+	 velocity_(0)
+	{
+
+	}
+
+	virtual void processMsg() {
+		unsigned char data[8];
+		for (int i=0; i<8; i++) {
+			data[i] = (unsigned char) value_[i];
+		}
+		position_ = decodeInt32(&data[0]);
+		velocity_ = decodeInt32(&data[4]);
+	}
+
+	int32_t getPosition() const { return position_; }
+	int32_t getVelocity() const { return velocity_; }
+
+private:
+	int32_t position_;
+	int32_t velocity_;
+};
+
+//! RxPDO with a velocity command
+class RxPDOVelocity: public CANOpenMsg {
+public:
+	RxPDOVelocity(int nodeId, int SMId)
+	:CANOpenMsg(canopen::RxPDO1Id + nodeId, SMId)
+	{
+
+	}
+
+	void setVelocity(int32_t velocity) {
+		int value[1] = {velocity};
+		int length[1] = {4};
+		setValue(value, 1);
+		setLength(length, 1);
+		setFlag(1);
+	}
+};
+
+
+/*******************************************************
+ * STATIC PDOS
+ *******************************************************/
+
+//! TxPDO with position and velocity
+class StaticTxPDOPositionVelocity: public StaticPDO<StaticTxPDOPositionVelocity> {
+public:
+	StaticTxPDOPositionVelocity(int nodeId, int SMId)
+	:StaticPDO<StaticTxPDOPositionVelocity>(canopen::TxPDO1Id + nodeId, SMId),
+	 position_(0),
+	 velocity_(0)
+	{
+
+	}
+
+	void decode(const unsigned char* data, int length) {
+		if (length >= 8) {
+			position_ = decodeInt32(&data[0]);
+			velocity_ = decodeInt32(&data[4]);
+		}
+	}
+
+	int32_t getPosition() const { return position_; }
+	int32_t getVelocity() const { return velocity_; }
+
+private:
+	int32_t position_;
+	int32_t velocity_;
+};
+
+//! RxPDO with a velocity command
+class StaticRxPDOVelocity: public StaticPDO<StaticRxPDOVelocity> {
+public:
+	StaticRxPDOVelocity(int nodeId, int SMId)
+	:StaticPDO<StaticRxPDOVelocity>(canopen::RxPDO1Id + nodeId, SMId),
+	 velocity_(0)
+	{
+
+	}
+
+	void setVelocity(int32_t velocity) {
+		velocity_ = velocity;
+		setFlag(1);
+	}
+
+	int encode(unsigned char* data) {
+		encodeInt32(data, velocity_);
+		return 4;
+	}
+
+private:
+	int32_t velocity_;
+};
+
+typedef StaticTxPDOPositionVelocity T;
+typedef StaticRxPDOVelocity R;
+typedef StaticPDOTable<T, T, T, T, T, T, T, T> StaticTxPDOs;
+typedef StaticPDOTable<R, R, R, R, R, R, R, R> StaticRxPDOs;
+typedef StaticBus<StaticTxPDOs, StaticRxPDOs> BenchmarkStaticBus;
+
+//! Sets the velocity commands of the static RxPDOs
+template <size_t I>
+typename std::enable_if<(I < StaticRxPDOs::size)>::type setVelocities(StaticRxPDOs& pdos, int32_t velocity)
+{
+	pdos.get<I>().setVelocity(velocity + I);
+	setVelocities<I+1>(pdos, velocity);
+}
+
+template <size_t I>
+typename std::enable_if<(I == StaticRxPDOs::size)>::type setVelocities(StaticRxPDOs&, int32_t) {}
+
+//! Sums the positions of the static TxPDOs, such that the decoding is not optimized away
+template <size_t I>
+typename std::enable_if<(I < StaticTxPDOs::size), int64_t>::type sumPositions(StaticTxPDOs& pdos)
+{
+	return pdos.get<I>().getPosition() + sumPositions<I+1>(pdos);
+}
+
+template <size_t I>
+typename std::enable_if<(I == StaticTxPDOs::size), int64_t>::type sumPositions(StaticTxPDOs&)
+{
+	return 0;
+}
+
+
+/*******************************************************
+ * BENCHMARK
+ *******************************************************/
+
+//! Fills the received frames as if the nodes sent their TxPDOs
+void receiveFrames(CANMsg* received, unsigned long cycle)
+{
+	for (int iDevice=0; iDevice<nDevices; iDevice++) {
+		CANMsg& frame = received[1 + iDevice];
+		frame.flag = 1;
+		frame.COBId = canopen::TxPDO1Id + 1 + iDevice;
+		frame.length = 8;
+		encodeInt32(&frame.value[0], (int32_t)(cycle + iDevice));
+		encodeInt32(&frame.value[4], (int32_t)(2*cycle));
+	}
+}
+
+double toNanosecondsPerCycle(std::chrono::steady_clock::duration duration, unsigned long nCycles)
+{
+	return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()/nCycles;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const unsigned long nCycles = (argc > 1) ? strtoul(argv[1], NULL, 10) : 1000000;
+	if (nCycles == 0) {
+		printf("The number of cycles must be positive!\n");
+		return 2;
+	}
+
+	CANMsg received[nFrames];
+	CANMsg sent[nFrames];
+	int64_t checksum = 0;
+
+	/* bus with virtual PDOs */
+	CANOpenMsg::reservePool(4*nDevices);
+	Bus virtualBus(0);
+	TxPDOPositionVelocity* txPDOs[nDevices];
+	RxPDOVelocity* rxPDOs[nDevices];
+	for (int iDevice=0; iDevice<nDevices; iDevice++) {
+		txPDOs[iDevice] = new TxPDOPositionVelocity(1 + iDevice, 1 + iDevice);
+		rxPDOs[iDevice] = new RxPDOVelocity(1 + iDevice, 1 + iDevice);
+		virtualBus.getTxPDOManager()->addPDO(txPDOs[iDevice]);
+		virtualBus.getRxPDOManager()->addPDO(rxPDOs[iDevice]);
+	}
+	virtualBus.getRxPDOManager()->setSending(true);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned long cycle=0; cycle<nCycles; cycle++) {
+		receiveFrames(received, cycle);
+		virtualBus.ingest(Span<const CANMsg>(received, nFrames));
+		for (int iDevice=0; iDevice<nDevices; iDevice++) {
+			checksum += txPDOs[iDevice]->getPosition();
+			rxPDOs[iDevice]->setVelocity((int32_t)cycle + iDevice);
+		}
+		virtualBus.emit(Span<CANMsg>(sent, nFrames));
+	}
+	const double virtualTime_ns = toNanosecondsPerCycle(std::chrono::steady_clock::now() - start, nCycles);
+
+	/* bus with static PDOs */
+	BenchmarkStaticBus staticBus(1,
+			StaticTxPDOs(T(1, 1), T(2, 2), T(3, 3), T(4, 4), T(5, 5), T(6, 6), T(7, 7), T(8, 8)),
+			StaticRxPDOs(R(1, 1), R(2, 2), R(3, 3), R(4, 4), R(5, 5), R(6, 6), R(7, 7), R(8, 8)));
+	staticBus.getRxPDOManager()->setSending(true);
+
+	start = std::chrono::steady_clock::now();
+	for (unsigned long cycle=0; cycle<nCycles; cycle++) {
+		receiveFrames(received, cycle);
+		staticBus.ingest(Span<const CANMsg>(received, nFrames));
+		checksum -= sumPositions<0>(staticBus.getStaticTxPDOs());
+		setVelocities<0>(staticBus.getStaticRxPDOs(), (int32_t)cycle);
+		staticBus.emit(Span<CANMsg>(sent, nFrames));
+	}
+	const double staticTime_ns = toNanosecondsPerCycle(std::chrono::steady_clock::now() - start, nCycles);
+
+	printf("%d devices, %lu cycles\n", nDevices, nCycles);
+	printf("  virtual PDOs: %8.1f ns/cycle\n", virtualTime_ns);
+	printf("  static PDOs:  %8.1f ns/cycle\n", staticTime_ns);
+	if (checksum != 0) {
+		printf("The buses decoded different positions!\n");
+		return 1;
+	}
+	return 0;
+}
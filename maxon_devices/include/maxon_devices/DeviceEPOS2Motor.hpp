@@ -50,6 +50,21 @@ public:
 	//! Initializes the EPOS
 	virtual bool initDevice(signed int operation_mode = OPERATION_MODE_VELOCITY);
 
+	/*! Configures the EPOS in the state pre-operational
+	 * Is invoked by initDevice() and by the boot manager.
+	 * The operation mode of the last call of initDevice() is used, velocity mode by default.
+	 * @return true if successfully configured
+	 */
+	virtual bool configureDevice();
+
+	/*! Initializes the heartbeat reception
+	 * If the heartbeat time is not zero, the EPOS is configured by initDevice() to produce
+	 * heartbeats and the node guarding requests (RTR) are not sent anymore.
+	 * @param heartBeatTime	time in ms at which the EPOS sends heartbeat messages
+	 * @return true if successfully initialized
+	 */
+	virtual bool initHeartbeat(const unsigned int heartBeatTime);
+
 	/*! Enables the EPOS
 	 * Is invoked by initDevice();
 	 */
@@ -129,6 +144,11 @@ public:
 	 */
 	DeviceEPOS2MotorParameters* getDeviceParams();
 
+	/*! Gets the index of the joint in the joint state buffer of the bus
+	 * @return index of joint, -1 if the buffer is full
+	 */
+	int getJointIndex() const;
+
     /*! Returns the value of the internal enabled flag
      * Might not be reflecting the current state of the motor, but does not
      * cost an SDO. Use getIsMotorDisabled and getIsMotorEnabled to 
@@ -216,6 +236,9 @@ public:
 
 
 protected:
+	//! The EMCY codes of the node are decoded with the EPOS2 table
+	virtual canopen::EMCYVendor getEMCYVendor() const;
+
     //! Internal record of the motor state. Valid only until some external
     //factor brings the motor to a fault state
     bool enabled_;
@@ -245,6 +268,9 @@ protected:
 	//! device parameters
 	DeviceEPOS2MotorParameters* deviceParams_;
 
+	//! index of the joint in the joint state buffer of the bus
+	int jointIndex_;
+
 	//! SDO to read the status word
 	SDOReadStatusWord::SDOReadStatusWordPtr sdoStatusWord_;
 
@@ -115,6 +115,15 @@ public:
 	//! operation (control) mode (velocity, position, current, etc. Use defines above)
 	int operationMode;
 
+	//! transmission type of the TxPDO with the analog input and the current (every n-th SYNC: 0x01-0xF0, event-driven: 0xFE, 0xFF)
+	int txPDOAnalogCurrentTransmissionType;
+	//! minimum time between two event-driven TxPDOs with the analog input and the current [100us]
+	int txPDOAnalogCurrentInhibitTime;
+	//! maximum time between two event-driven TxPDOs with the analog input and the current [ms], 0 disables the timer
+	int txPDOAnalogCurrentEventTimer;
+	//! overflow value of the SYNC counter of the bus (see Bus::setSyncCounterOverflow()), 0 if the SYNC has no counter
+	int syncCounterOverflow;
+
 	//! identifier of shared memory of the Sync PDO
 	int rxSYNCSMId_;
 
@@ -188,7 +197,10 @@ public:
         inNMTSMId_(inNMTSMId),
         outNMTSMId_(outNMTSMId)
 	{
-
+		txPDOAnalogCurrentTransmissionType = 0x01;
+		txPDOAnalogCurrentInhibitTime = 0;
+		txPDOAnalogCurrentEventTimer = 0;
+		syncCounterOverflow = 0;
 	}
 	virtual ~DeviceEPOS2MotorParameters()
 	{
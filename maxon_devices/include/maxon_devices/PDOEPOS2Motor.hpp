@@ -22,15 +22,16 @@
 
 
 #include "libcanplusplus/CANOpenMsg.hpp"
+#include "libcanplusplus/canopen_pdos.hpp"
+#include "libcanplusplus/JointStateBuffer.hpp"
 #include "maxon_devices/SDOEPOS2Motor.hpp"
 #include <stdio.h>
 
 //////////////////////////////////////////////////////////////////////////////
-class RxPDOSync: public CANOpenMsg {
+//! SYNC of the bus, counts up to Bus::getSyncCounterOverflow() if it is set
+class RxPDOSync: public canopen::RxPDOSync {
 public:
-	RxPDOSync(unsigned int smid):CANOpenMsg(0x80, smid) {
-		flag_ = 1;
-	};
+	RxPDOSync(unsigned int smid):canopen::RxPDOSync(smid) {};
 	virtual ~RxPDOSync() {};
 };
 
@@ -131,7 +132,8 @@ private:
 class TxPDOPositionVelocity: public CANOpenMsg {
 public:
 	TxPDOPositionVelocity(unsigned int pdoId, 
-            unsigned int nodeId, unsigned int SMId):CANOpenMsg(0x080+pdoId*0x100+nodeId, SMId)
+            unsigned int nodeId, unsigned int SMId):CANOpenMsg(0x080+pdoId*0x100+nodeId, SMId),
+            jointStateBuffer_(NULL), joint_(-1)
 	{
 
 	};
@@ -145,6 +147,10 @@ public:
 	{
 		position_ = (value_[0] + (value_[1]<<8) + (value_[2]<<16) + (value_[3]<<24));
 		velocity_ = (value_[4] + (value_[5]<<8) + (value_[6]<<16) + (value_[7]<<24));
+
+		if (jointStateBuffer_ != NULL) {
+			jointStateBuffer_->setRawPositionVelocity(joint_, position_, velocity_);
+		}
 	};
 
 	int getPosition()
@@ -157,10 +163,24 @@ public:
 		return velocity_;
 	};
 
+	/*! Writes the decoded values also to the joint state buffer of the bus
+	 * @param jointStateBuffer	buffer of the bus
+	 * @param joint				index of the joint in the buffer
+	 */
+	void setJointStateBuffer(JointStateBuffer* jointStateBuffer, int joint)
+	{
+		jointStateBuffer_ = jointStateBuffer;
+		joint_ = joint;
+	};
+
 
 private:
 	int position_;
 	int velocity_;
+	//! buffer of the bus the decoded values are written to, NULL if not used
+	JointStateBuffer* jointStateBuffer_;
+	//! index of the joint in the buffer
+	int joint_;
 
 };
 
@@ -168,7 +188,8 @@ private:
 class TxPDOAnalogCurrent: public CANOpenMsg {
 public:
 	TxPDOAnalogCurrent(unsigned int pdoId, 
-            unsigned int nodeId, unsigned int SMId):CANOpenMsg(0x080+pdoId*0x100+nodeId, SMId)
+            unsigned int nodeId, unsigned int SMId):CANOpenMsg(0x080+pdoId*0x100+nodeId, SMId),
+            jointStateBuffer_(NULL), joint_(-1)
 	{
 
 	};
@@ -187,6 +208,10 @@ public:
         
 		val = (value_[4] + (value_[5]<<8));
 		analog_ = int(val);
+
+		if (jointStateBuffer_ != NULL) {
+			jointStateBuffer_->setRawCurrent(joint_, current_);
+		}
 	};
 
 	int getAnalog()
@@ -204,6 +229,16 @@ public:
 		return statusword_;
 	};
 
+	/*! Writes the decoded values also to the joint state buffer of the bus
+	 * @param jointStateBuffer	buffer of the bus
+	 * @param joint				index of the joint in the buffer
+	 */
+	void setJointStateBuffer(JointStateBuffer* jointStateBuffer, int joint)
+	{
+		jointStateBuffer_ = jointStateBuffer;
+		joint_ = joint;
+	};
+
 	bool isEnabled()
 	{
 		return (statusword_ & (1<<STATUSWORD_OPERATION_ENABLE_BIT));
@@ -245,6 +280,10 @@ private:
 	int analog_;
 	int current_;
 	int statusword_;
+	//! buffer of the bus the decoded values are written to, NULL if not used
+	JointStateBuffer* jointStateBuffer_;
+	//! index of the joint in the buffer
+	int joint_;
 
 };
 
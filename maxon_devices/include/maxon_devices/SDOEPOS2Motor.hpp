@@ -15,6 +15,7 @@
 #include <stdio.h>
 #include "libcanplusplus/SDOWriteMsg.hpp"
 #include "libcanplusplus/SDOReadMsg.hpp"
+#include "libcanplusplus/Logger.hpp"
 #include "maxon_devices/SDOEPOS2Motor.hpp"
 
 #define WRITE_1_BYTE 0x2f
@@ -50,7 +51,7 @@ protected:
 			if (inputMsg_->getValue()[0] == 0x80)
 			{
 				///< Check for recData[0]==0x60! recData[0]==0x80 means an error happend
-				printf("\e[0;31mAN ERROR HAPPEND. CAN'T WRITE CHECK CHAP. 12.3 of the firmware specification for the error code: %02X%02X%02X%02X\n\e[0m",inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4]);
+				Logger::log(LogLevels::error, "SDO Error: Node 0x%02X: Can't write! Error code: %02X%02X%02X%02X, Index: 0x%02X%02X, Subindex: 0x%02X", outputMsg_->getCOBId()-0x600, inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4], inputMsg_->getValue()[2], inputMsg_->getValue()[1], inputMsg_->getValue()[3]);
 			}
 		}
 	}
@@ -87,7 +88,7 @@ protected:
 			if (inputMsg_->getValue()[0] == 0x80)
 			{
 				///< Check for recData[0]==0x60! recData[0]==0x80 means an error happend
-				printf("\e[0;31mAN ERROR HAPPEND. CAN'T WRITE CHECK CHAP. 12.3 of the firmware specification for the error code: %02X%02X%02X%02X\n\e[0m",inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4]);
+				Logger::log(LogLevels::error, "SDO Error: Node 0x%02X: Can't write! Error code: %02X%02X%02X%02X, Index: 0x%02X%02X, Subindex: 0x%02X", outputMsg_->getCOBId()-0x600, inputMsg_->getValue()[7], inputMsg_->getValue()[6], inputMsg_->getValue()[5], inputMsg_->getValue()[4], inputMsg_->getValue()[2], inputMsg_->getValue()[1], inputMsg_->getValue()[3]);
 			}
 		}
 
@@ -586,7 +587,7 @@ public:
 class SDOGetEncoderCounterAtIndexPulse: public SDORead
 {
 public:
-	typedef boost::shared_ptr<SDOGetEncoderCounterAtIndexPulse> SDOGetEncoderCounterAtIndexPulsePtr;
+	typedef boost::intrusive_ptr<SDOGetEncoderCounterAtIndexPulse> SDOGetEncoderCounterAtIndexPulsePtr;
 	SDOGetEncoderCounterAtIndexPulse(int inSDOSMId, int outSDOSMId, int nodeId):
 		SDORead(inSDOSMId, outSDOSMId, nodeId, 0x2021, 0x00)
 	{};
@@ -631,6 +632,16 @@ public:
 	virtual ~SDOSetLifeTimeFactor(){};
 };
 
+//////////////////////////////////////////////////////////////////////////////
+class SDOSetProducerHeartbeatTime: public SDOWrite
+{
+public:
+	SDOSetProducerHeartbeatTime(int inSDOSMId, int outSDOSMId, int nodeId, int time_ms):
+		SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1017, 0x00, time_ms)
+	{};
+	virtual ~SDOSetProducerHeartbeatTime(){};
+};
+
 
 /***********************************************************************
 -------------------- Analog Inputs--------------------------------------
@@ -639,7 +650,7 @@ public:
 class SDOGetAnalogInputOne: public SDORead
 {
 public:
-	typedef boost::shared_ptr<SDOGetAnalogInputOne> SDOGetAnalogInputOnePtr;
+	typedef boost::intrusive_ptr<SDOGetAnalogInputOne> SDOGetAnalogInputOnePtr;
 	SDOGetAnalogInputOne(int inSDOSMId, int outSDOSMId, int nodeId):
 		SDORead(inSDOSMId, outSDOSMId, nodeId, 0x207C, 0x01)
 	{};
@@ -655,7 +666,7 @@ public:
 class SDOGetAnalogInputTwo: public SDORead
 {
 public:
-	typedef boost::shared_ptr<SDOGetAnalogInputTwo> SDOGetAnalogInputTwoPtr;
+	typedef boost::intrusive_ptr<SDOGetAnalogInputTwo> SDOGetAnalogInputTwoPtr;
 	SDOGetAnalogInputTwo(int inSDOSMId, int outSDOSMId, int nodeId):
 		SDORead(inSDOSMId, outSDOSMId, nodeId, 0x207C, 0x01)
 	{};
@@ -782,6 +793,46 @@ public:
 	virtual ~SDOTxPDO2SetTransmissionType(){};
 };
 
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO2Disable: public SDOWrite
+{
+public:
+	SDOTxPDO2Disable(int inSDOSMId, int outSDOSMId, int nodeId):
+		SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_4_BYTE, 0x1801, 0x01, 0x80000280 + nodeId)
+	{};
+	virtual ~SDOTxPDO2Disable(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO2SetInhibitTime: public SDOWrite
+{
+public:
+	SDOTxPDO2SetInhibitTime(int inSDOSMId, int outSDOSMId, int nodeId, int time_100us):
+		SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1801, 0x03, time_100us)
+	{};
+	virtual ~SDOTxPDO2SetInhibitTime(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO2SetEventTimer: public SDOWrite
+{
+public:
+	SDOTxPDO2SetEventTimer(int inSDOSMId, int outSDOSMId, int nodeId, int time_ms):
+		SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_2_BYTE, 0x1801, 0x05, time_ms)
+	{};
+	virtual ~SDOTxPDO2SetEventTimer(){};
+};
+
+//////////////////////////////////////////////////////////////////////////////
+class SDOTxPDO2SetSyncStartValue: public SDOWrite
+{
+public:
+	SDOTxPDO2SetSyncStartValue(int inSDOSMId, int outSDOSMId, int nodeId, int value):
+		SDOWrite(inSDOSMId, outSDOSMId, nodeId, WRITE_1_BYTE, 0x1801, 0x06, value)
+	{};
+	virtual ~SDOTxPDO2SetSyncStartValue(){};
+};
+
 //////////////////////////////////////////////////////////////////////////////
 class SDOTxPDO2SetMapping: public SDOWrite
 {
@@ -1060,7 +1111,7 @@ public:
 class SDOReadStatusWord: public SDORead
 {
 public:
-	typedef boost::shared_ptr<SDOReadStatusWord> SDOReadStatusWordPtr;
+	typedef boost::intrusive_ptr<SDOReadStatusWord> SDOReadStatusWordPtr;
 	SDOReadStatusWord(int inSDOSMId, int outSDOSMId, int nodeId):
 		SDORead(inSDOSMId, outSDOSMId, nodeId, 0x6041, 0x00)
 	{};
@@ -9,6 +9,7 @@
  */
 
 #include "maxon_devices/DeviceEPOS2Motor.hpp"
+#include "libcanplusplus/canopen_sdos.hpp"
 #include <stdio.h>
 #include <math.h>
 
@@ -18,6 +19,8 @@ DeviceEPOS2Motor::DeviceEPOS2Motor(int nodeId, DeviceEPOS2MotorParameters* devic
 {
     enabled_ = false;
     operation_mode_ = 0; // Undefined
+    jointIndex_ = -1;
+    rxPDORTR_ = NULL;
 	sdoStatusWord_ =  SDOReadStatusWord::SDOReadStatusWordPtr(new SDOReadStatusWord(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
 	sdoStatusWordDisabled_ = SDOReadStatusWord::SDOReadStatusWordPtr(new SDOReadStatusWord(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
 	sdoAnalogInputOne_ = SDOGetAnalogInputOne::SDOGetAnalogInputOnePtr(new SDOGetAnalogInputOne(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
@@ -42,6 +45,16 @@ DeviceEPOS2MotorParameters* DeviceEPOS2Motor::getDeviceParams()
 	return deviceParams_;
 }
 
+int DeviceEPOS2Motor::getJointIndex() const
+{
+	return jointIndex_;
+}
+
+canopen::EMCYVendor DeviceEPOS2Motor::getEMCYVendor() const
+{
+	return canopen::EMCYVendor::maxon;
+}
+
 void DeviceEPOS2Motor::addRxPDOs()
 {
     CANOpenMsg* sync = bus_->getRxPDOManager()->getPDOWithCOBId(0x080);
@@ -60,6 +73,10 @@ void DeviceEPOS2Motor::addRxPDOs()
     /* add Position RxPDO, not sure if it can share the same SMId */
     rxPDORTR_ = new RxPDORTR(nodeId_, deviceParams_->outNMTSMId_);
     bus_->getRxPDOManager()->addPDO(rxPDORTR_);
+    if (producerHeartBeatTime_ != 0) {
+        /* the node state is received by heartbeats */
+        rxPDORTR_->setFlag(0);
+    }
 
     /* add Position Limit RxPDO */
     //	rxPDOPositionLimit_ = new RxPDOPositionLimit(nodeId_, deviceParams_->rxPDO2SMId_);
@@ -74,6 +91,25 @@ void DeviceEPOS2Motor::addTxPDOs()
 
 	txPDOAnalogCurrent_ = new TxPDOAnalogCurrent(2,nodeId_, deviceParams_->txPDO2SMId_);
 	bus_->getTxPDOManager()->addPDO(txPDOAnalogCurrent_);
+	if (canopen::isEventDriven(deviceParams_->txPDOAnalogCurrentTransmissionType)
+			&& deviceParams_->txPDOAnalogCurrentEventTimer > 0) {
+		/* the PDO is stale if not even the event timer has triggered it */
+		txPDOAnalogCurrent_->setReceiveTimeout(2*deviceParams_->txPDOAnalogCurrentEventTimer);
+	}
+	if (canopen::isSynchronousCyclic(deviceParams_->txPDOAnalogCurrentTransmissionType)) {
+		/* the PDO is sent on every n-th SYNC, stagger it against the other slow TxPDOs */
+		bus_->getTxPDOManager()->setRateDivisor(txPDOAnalogCurrent_, deviceParams_->txPDOAnalogCurrentTransmissionType);
+	}
+
+	/* register the joint in the joint state buffer of the bus (current is measured in mA) */
+	JointStateBuffer* jointStateBuffer = bus_->getJointStateBuffer();
+	jointIndex_ = jointStateBuffer->addJoint(1.0/(deviceParams_->gearratio_motor * deviceParams_->RAD_TO_TICKS),
+											1.0/deviceParams_->rad_s_Gear_to_rpm_Motor,
+											0.001);
+	if (jointIndex_ != -1) {
+		txPDOPositionVelocity_->setJointStateBuffer(jointStateBuffer, jointIndex_);
+		txPDOAnalogCurrent_->setJointStateBuffer(jointStateBuffer, jointIndex_);
+	}
 }
 
 
@@ -87,7 +123,7 @@ void DeviceEPOS2Motor::setVelocity(double jointVelocity_rad_s)
             } 
             break;
         default:
-            printf("Ignoring non velocity command for device %04x\n",nodeId_);
+            Logger::log(LogLevels::warn, "Ignoring non velocity command for device %04x", nodeId_);
             // ignore
             break;
     }
@@ -104,7 +140,7 @@ void DeviceEPOS2Motor::setPosition(double jointPosition_rad)
             } 
             break;
         default:
-            printf("Ignoring non position command for device %04x\n",nodeId_);
+            Logger::log(LogLevels::warn, "Ignoring non position command for device %04x", nodeId_);
             // ignore
             break;
     }
@@ -233,24 +269,50 @@ bool DeviceEPOS2Motor::setNodeGuarding(unsigned char lifetime, unsigned char mul
     return true;
 }
 
+bool DeviceEPOS2Motor::initHeartbeat(const unsigned int heartBeatTime)
+{
+	/* node guarding requests are only sent if the EPOS does not produce heartbeats */
+	if (rxPDORTR_ != NULL) {
+		rxPDORTR_->setFlag(heartBeatTime == 0 ? 1 : 0);
+	}
+	return Device::initHeartbeat(heartBeatTime);
+}
+
 bool DeviceEPOS2Motor::initDevice(signed int operation_mode)
 {
 	SDOManager* SDOManager = bus_->getSDOManager();
 
 	SDOManager->addSDO(new SDONMTEnterPreOperational(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
-	SDOManager->addSDO(new SDOSetCOBIDSYNC(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0x80));
 
     operation_mode_ = operation_mode;
+	configureDevice();
+
+	SDOManager->addSDO(new SDONMTStartRemoteNode(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
+	return true;
+
+}
+
+bool DeviceEPOS2Motor::configureDevice()
+{
+	SDOManager* SDOManager = bus_->getSDOManager();
+
+	SDOManager->addSDO(new SDOSetCOBIDSYNC(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0x80));
+
+	if (producerHeartBeatTime_ != 0) {
+		/* replace node guarding by heartbeats */
+		SDOManager->addSDO(new SDOSetGuardTime(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0));
+		SDOManager->addSDO(new SDOSetProducerHeartbeatTime(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, producerHeartBeatTime_));
+	}
+
+	if (operation_mode_ == 0) {
+		operation_mode_ = OPERATION_MODE_VELOCITY;
+	}
 	configTxPDOs();
 	configRxPDOs();
 
 	setMotorParameters();
 	initMotor();
-
-
-	SDOManager->addSDO(new SDONMTStartRemoteNode(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
 	return true;
-
 }
 
 bool DeviceEPOS2Motor::setOperationMode(int op_mode)
@@ -338,10 +400,26 @@ void DeviceEPOS2Motor::configTxPDOAnalogCurrent()
 	SDOManager* SDOManager = bus_->getSDOManager();
 
 	// Transmit PDO 2 Parameter
+	const bool isEventDriven = canopen::isEventDriven(deviceParams_->txPDOAnalogCurrentTransmissionType);
+	const bool hasSyncStartValue = (deviceParams_->syncCounterOverflow > 0 && txPDOAnalogCurrent_->getRateDivisor() > 1
+			&& setSyncCounterOverflow(deviceParams_->syncCounterOverflow, txPDOAnalogCurrent_->getRateDivisor(), txPDOAnalogCurrent_->getRatePhase() + 1));
+	if (isEventDriven || hasSyncStartValue) {
+		///< the inhibit time and the SYNC start value can only be changed while the PDO is disabled
+		SDOManager->addSDO(new SDOTxPDO2Disable(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
+	}
+	if (isEventDriven) {
+		SDOManager->addSDO(new SDOTxPDO2SetInhibitTime(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, deviceParams_->txPDOAnalogCurrentInhibitTime));
+		SDOManager->addSDO(new SDOTxPDO2SetEventTimer(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, deviceParams_->txPDOAnalogCurrentEventTimer));
+	}
+	if (hasSyncStartValue) {
+		///< the SYNC counter starts with 1, the PDO is sent first with the SYNC of its phase
+		SDOManager->addSDO(new canopen::SDOSetSyncCounterOverflow(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, deviceParams_->syncCounterOverflow));
+		SDOManager->addSDO(new SDOTxPDO2SetSyncStartValue(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, txPDOAnalogCurrent_->getRatePhase() + 1));
+	}
 	///< configure COB-ID Transmit PDO 2
 	SDOManager->addSDO(new SDOTxPDO2ConfigureCOBID(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_));
-	///< Set Transmission Type: SYNC 0x01
-	SDOManager->addSDO(new SDOTxPDO2SetTransmissionType(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0x01)); // SYNC
+	///< Set Transmission Type: every n-th SYNC 0x01-0xF0 or event-driven 0xFE/0xFF
+	SDOManager->addSDO(new SDOTxPDO2SetTransmissionType(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, deviceParams_->txPDOAnalogCurrentTransmissionType));
 	///< Number of Mapped Application Objects
 	SDOManager->addSDO(new SDOTxPDO2SetNumberOfMappedApplicationObjects(deviceParams_->inSDOSMId_, deviceParams_->outSDOSMId_, nodeId_, 0x00));
 	///< Mapping "actual current value - works!"